@@ -0,0 +1,16 @@
+#version 450
+
+// The heatmap texture is transposed, each texture row holds one sample of every heatmap row. Samples are stored in a
+// ring, scrollOffset is the texture coordinate of the oldest one.
+uniform sampler2D heatmap;
+uniform float scrollOffset;
+uniform vec4 color;
+
+in vec2 texCoord;
+
+out vec4 fragColor;
+
+void main() {
+    float value = texture(heatmap, vec2(texCoord.y, texCoord.x + scrollOffset)).r;
+    fragColor = vec4(color.rgb, color.a * value);
+}
@@ -0,0 +1,11 @@
+#version 450
+
+// Draws a quad covering the viewport without any vertex buffer. texCoord.x is the position in time from the oldest
+// sample (0) to the newest (1), texCoord.y is the row from the top (0) to the bottom (1)
+out vec2 texCoord;
+
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    texCoord = vec2(corner.x, 1.0 - corner.y);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
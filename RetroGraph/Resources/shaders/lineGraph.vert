@@ -1,8 +1,17 @@
 #version 450
 
-layout(location = 0) in vec2 position;
+// Only the y value of each point is stored in the vertex buffer. Points are evenly spaced, so x is derived from the
+// vertex's distance from the tail of the ring buffer. The vertex after the end of the ring mirrors the first vertex.
+// y is either a plain float (yScale = 1, yBias = 0) or a normalized uint16 (yScale = viewport width,
+// yBias = viewport min)
+layout(location = 0) in float value;
 
+uniform int tail;
+uniform int numPoints;
 uniform float xOffset;
+uniform float xInterval;
+uniform float yScale;
+uniform float yBias;
 uniform vec4 color;
 uniform mat4 model;
 
@@ -10,5 +19,8 @@ out vec4 vertColor;
 
 void main() {
     vertColor = color;
-    gl_Position = model * vec4(position.x + xOffset, position.y, 1.0, 1.0);
+    int index = (gl_VertexID - tail + numPoints) % numPoints;
+    float x = float(index) * xInterval + xOffset;
+    float y = value * yScale + yBias;
+    gl_Position = model * vec4(x, y, 1.0, 1.0);
 }
@@ -0,0 +1,38 @@
+#version 450
+
+// Batched version of lineGraph.vert. Every graph in the batch has a slot of vertexStride vertices in the shared vertex
+// buffer, so the graph a vertex belongs to is found from its index. The per graph parameters that lineGraph.vert takes
+// as uniforms are read from the graph's entry in the graphs buffer instead.
+layout(location = 0) in float value;
+
+struct GraphParams {
+    mat4 model;
+    int tail;
+    int numPoints;
+    float xInterval;
+    float padding;
+};
+
+layout(std430, binding = 0) readonly buffer GraphParamsBuffer {
+    GraphParams graphs[];
+};
+
+uniform int vertexStride;
+uniform float xOffset;
+uniform float yScale;
+uniform float yBias;
+uniform vec4 color;
+
+out vec4 vertColor;
+
+void main() {
+    int graphIndex = gl_VertexID / vertexStride;
+    GraphParams graph = graphs[graphIndex];
+
+    vertColor = color;
+    int vertex = gl_VertexID - graphIndex * vertexStride;
+    int index = (vertex - graph.tail + graph.numPoints) % graph.numPoints;
+    float x = float(index) * graph.xInterval + xOffset;
+    float y = value * yScale + yBias;
+    gl_Position = graph.model * vec4(x, y, 1.0, 1.0);
+}
@@ -0,0 +1,13 @@
+#version 450
+
+// The glyph atlas only stores coverage, the colour comes from the glyph
+uniform sampler2D atlas;
+
+in vec2 texCoord;
+in vec4 vertColor;
+
+out vec4 fragColor;
+
+void main() {
+    fragColor = vec4(vertColor.rgb, vertColor.a * texture(atlas, texCoord).r);
+}
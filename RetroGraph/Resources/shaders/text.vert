@@ -0,0 +1,24 @@
+#version 450
+
+// One instance per glyph. The quad's corners are generated from gl_VertexID, drawn as a 4 vertex triangle strip.
+// Positions are in window pixels, texels are in glyph atlas texels from the top left.
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 size;
+layout(location = 2) in vec2 texel;
+layout(location = 3) in vec4 color;
+
+uniform vec2 windowSize;
+uniform vec2 atlasSize;
+
+out vec2 texCoord;
+out vec4 vertColor;
+
+void main() {
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 pixel = position + corner * size;
+
+    // The atlas is stored top down, so the bottom of the quad samples the bottom row of the glyph
+    texCoord = (texel + vec2(corner.x, 1.0 - corner.y) * size) / atlasSize;
+    vertColor = color;
+    gl_Position = vec4(pixel / windowSize * 2.0 - 1.0, 0.0, 1.0);
+}
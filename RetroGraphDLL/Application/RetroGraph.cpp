@@ -11,23 +11,71 @@ import "WindowsHeaderUnit.h";
 
 namespace rg {
 
+/* Reads the particle seed as an unsigned 64-bit value. Anything that isn't one falls back to 0, a random seed */
+uint64_t getParticleSeed() {
+    const auto& str{ UserSettings::inst().getVal<std::string>("Widgets-Main.Seed") };
+    uint64_t seed{ 0 };
+    const auto [end, ec] { std::from_chars(str.data(), str.data() + str.size(), seed) };
+    if (ec != std::errc{} || end != str.data() + str.size()) {
+        RGERROR("Widgets-Main.Seed must be a whole number from 0 to 18446744073709551615");
+        return 0;
+    }
+    return seed;
+}
+
+AnimationSettings getAnimationSettings() {
+    auto& settings{ UserSettings::inst() };
+    return {
+        .numParticles = static_cast<size_t>(std::max(settings.getVal<int>("Widgets-Main.NumParticles"), 1)),
+        .connectionDistance = settings.getVal<double, float>("Widgets-Main.ConnectionDistance"),
+        .gridCellsPerSide = settings.getVal<int>("Widgets-Main.GridCellsPerSide"),
+        .autoTune = settings.getVal<bool>("Widgets-Main.AutoTuneParticles"),
+        .autoTuneBudget = std::chrono::microseconds{ settings.getVal<int>("Widgets-Main.AutoTuneBudgetUs") },
+        .numThreads = static_cast<size_t>(std::max(settings.getVal<int>("Widgets-Main.NumThreads"), 0)),
+        .seed = getParticleSeed(),
+    };
+}
+
+/* Reads how a measure adapts its update interval from the measure's config section. Returns nothing if the measure
+ * samples at a fixed rate
+ */
+std::optional<AdaptiveIntervalSettings> getAdaptiveIntervalSettings(std::string_view section) {
+    auto& settings{ UserSettings::inst() };
+    const auto getSetting{ [section](std::string_view name) { return std::format("{}.{}", section, name); } };
+
+    const std::chrono::milliseconds minInterval{ settings.getVal<int>(getSetting("UpdateInterval")) };
+    const std::chrono::milliseconds maxInterval{ settings.getVal<int>(getSetting("MaxUpdateInterval")) };
+    if (maxInterval <= minInterval)
+        return std::nullopt;
+
+    return AdaptiveIntervalSettings{
+        .minInterval = minInterval,
+        .maxInterval = maxInterval,
+        .changeThreshold = settings.getVal<double, float>(getSetting("ChangeThreshold")),
+    };
+}
+
 // TODO measure and data source factories
 template<std::derived_from<Measure> T>
-std::shared_ptr<T> createMeasure() {
+std::shared_ptr<T> createMeasure(const std::shared_ptr<SystemTimes>& systemTimes) {
     using namespace std::chrono;
 
     auto& settings{ UserSettings::inst() };
 
     if constexpr (std::is_same_v<T, CPUMeasure>) {
-        return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-CPU.UpdateInterval") },
-                                   std::make_unique<Win32CPUDataSource>());
+        auto measure{ std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-CPU.UpdateInterval") },
+                                          std::make_unique<Win32CPUDataSource>(systemTimes)) };
         // std::make_unique<CoreTempCPUDataSource>());//TODO automatically pick right data source
+        measure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-CPU"));
+        return measure;
     } else if constexpr (std::is_same_v<T, DriveMeasure>) {
         return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-Drive.UpdateInterval") },
                                    std::make_unique<Win32DriveDataSource>());
     } else if constexpr (std::is_same_v<T, GPUMeasure>) {
-        return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-GPU.UpdateInterval") },
-                                   std::make_unique<NvAPIGPUDataSource>());
+        auto measure{ std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-GPU.UpdateInterval") },
+                                          std::make_unique<NvAPIGPUDataSource>()) };
+        measure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-GPU"));
+        return measure;
     } else if constexpr (std::is_same_v<T, MusicMeasure>) {
         return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-Music.UpdateInterval") },
                                    std::make_unique<FoobarMusicDataSource>());
@@ -37,23 +85,34 @@ std::shared_ptr<T> createMeasure() {
                                        milliseconds{ UserSettings::inst().getVal<int>("Measures-Net.PingFrequency") },
                                        UserSettings::inst().getVal<std::string>("Measures-Net.PingServer")));
     } else if constexpr (std::is_same_v<T, RAMMeasure>) {
-        return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-RAM.UpdateInterval") },
-                                   std::make_unique<Win32RAMDataSource>());
+        auto measure{ std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-RAM.UpdateInterval") },
+                                          std::make_unique<Win32RAMDataSource>()) };
+        measure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-RAM"));
+        return measure;
     } else if constexpr (std::is_same_v<T, SystemMeasure>) {
         return std::make_shared<T>(std::make_unique<Win32OperatingSystemDataSource>());
     } else if constexpr (std::is_same_v<T, TimeMeasure>) {
         return std::make_shared<T>(milliseconds{ settings.getVal<int>("Measures-Time.UpdateInterval") },
                                    std::make_unique<ChronoTimeDataSource>());
+    } else if constexpr (std::is_same_v<T, ProcessMeasure>) {
+        return std::make_shared<T>(systemTimes);
+    } else if constexpr (std::is_same_v<T, AnimationState>) {
+        return std::make_shared<T>(getAnimationSettings());
     } else {
         return std::make_shared<T>();
     }
 }
 
 template<std::derived_from<Measure> T>
-std::shared_ptr<const T> getOrCreate(std::shared_ptr<T>& measure) {
+std::shared_ptr<const T> RetroGraph::getOrCreate(std::shared_ptr<T>& measure) {
+    return getOrCreateMutable(measure);
+}
+
+template<std::derived_from<Measure> T>
+std::shared_ptr<T> RetroGraph::getOrCreateMutable(std::shared_ptr<T>& measure) {
     if (!measure)
-        measure = createMeasure<T>();
-    return dynamic_pointer_cast<const T>(measure);
+        measure = createMeasure<T>(m_systemTimes);
+    return measure;
 }
 
 template<std::derived_from<Measure> T>
@@ -162,9 +221,11 @@ auto RetroGraph::createWidgetPositions() const {
 }
 
 RetroGraph::RetroGraph(HINSTANCE hInstance)
-    : m_window{ this, getOrCreate(m_displayMeasure), hInstance, UserSettings::inst().getVal<int>("Window.Monitor") }
+    : m_systemTimes{ std::make_shared<SystemTimes>() }
+    , m_window{ this, getOrCreate(m_displayMeasure), hInstance, UserSettings::inst().getVal<int>("Window.Monitor") }
     , m_fontManager{ m_window.getHwnd(), m_window.getHeight() }
     , m_fpsCounter{}
+    , m_fpsLimiter{}
     , m_widgetPositions(createWidgetPositions())
     , m_drawWidgetBackgrounds{ UserSettings::inst().getVal<bool>("Window.WidgetBackground") }
     , m_widgets{ createWidgets() }
@@ -174,37 +235,85 @@ RetroGraph::RetroGraph(HINSTANCE hInstance)
 
     update();
     draw();
+    present();
 }
 
 RetroGraph::~RetroGraph() {}
 
 void RetroGraph::run() {
-    FPSLimiter fpsLimiter;
+    if constexpr (profilingEnabled)
+        Profiler::inst().setThreadName("Main");
 
     // Enter main update/draw loop
     while (isRunning()) {
-        // Handle Windows messages
+        // Handle Windows messages. Frames can be a second or more apart while idle, so every waiting message is
+        // handled rather than one per frame
         MSG msg{};
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            if ((msg.message >= WM_MOUSEFIRST && msg.message <= WM_MOUSELAST) ||
+                (msg.message >= WM_KEYFIRST && msg.message <= WM_KEYLAST))
+                m_fpsLimiter.notifyUserInput();
+
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
 
-        update();
-        draw();
+        // Nothing can be seen, so measures stop sampling and nothing is drawn. The measures catch up once the window
+        // can be seen again
+        const bool occluded{ m_window.isOccluded() };
+        setMeasuresSuspended(occluded);
+        if (!occluded) {
+            m_fpsCounter.addPhaseTime(FramePhase::Update, recordTimeToExecute([this]() { update(); }));
+            m_fpsCounter.addPhaseTime(FramePhase::Draw, recordTimeToExecute([this]() { draw(); }));
+            m_fpsCounter.addPhaseTime(FramePhase::Present, recordTimeToExecute([this]() { present(); }));
+        }
+
+        // The frame's work is done, so waiting for the next frame isn't counted in its frame time
+        m_fpsCounter.endFrame();
 
         // Lay off the CPU a little
-        fpsLimiter.endFrame();
+        m_fpsLimiter.endFrame(getFrameRateInputs(occluded));
 
-        m_fpsCounter.endFrame();
         m_fpsCounter.startFrame();
-        fpsLimiter.startFrame();
+        m_fpsLimiter.startFrame();
     }
 }
 
+FrameRateInputs RetroGraph::getFrameRateInputs(bool occluded) const {
+    FrameRateInputs inputs{ .animating = m_animationState != nullptr, .suspended = occluded };
+
+    const auto addMeasure = [&inputs](const auto& measure) {
+        if (!measure)
+            return;
+
+        const auto nextUpdate{ measure->getNextUpdateTime() };
+        if (nextUpdate && (!inputs.nextMeasureUpdate || *nextUpdate < *inputs.nextMeasureUpdate))
+            inputs.nextMeasureUpdate = nextUpdate;
+    };
+
+    // The animation updates every frame, so it counts as animating rather than as a measure that is always due
+    addMeasure(m_cpuMeasure);
+    addMeasure(m_gpuMeasure);
+    addMeasure(m_ramMeasure);
+    addMeasure(m_netMeasure);
+    addMeasure(m_processMeasure);
+    addMeasure(m_driveMeasure);
+    addMeasure(m_musicMeasure);
+    addMeasure(m_systemMeasure);
+    addMeasure(m_displayMeasure);
+    addMeasure(m_timeMeasure);
+
+    return inputs;
+}
+
 void RetroGraph::update() {
+    const ProfileZone zone{ "RetroGraph::update" };
+
     tryRefreshConfig();
 
+    // Measures updating this time all see the same system times
+    m_systemTimes->nextTick();
+
     if (m_cpuMeasure)
         m_cpuMeasure->update();
     if (m_gpuMeasure)
@@ -230,18 +339,51 @@ void RetroGraph::update() {
 }
 
 void RetroGraph::draw() const {
+    const ProfileZone zone{ "RetroGraph::draw" };
+
     auto hdc{ GetDC(m_window.getHwnd()) };
     wglMakeCurrent(hdc, m_window.getHGLRC());
 
-    glClearColor(BGCOLOR_R, BGCOLOR_G, BGCOLOR_B, BGCOLOR_A);
+    // Each widget is kept in its own offscreen cache. If the back buffer keeps the last frame, only the caches of
+    // widgets that changed are copied into it. Otherwise the whole frame is composed from the caches
+    if (!m_window.preservesBackBuffer())
+        m_damage.addAll();
 
     for (const auto& widgetContainer : m_widgetContainers)
-        widgetContainer->draw();
+        widgetContainer->draw(m_damage);
+
+    // Only the damaged parts of the back buffer are drawn again
+    if (!m_damage.isEmpty()) {
+        // Copying a widget's cache overwrites its whole viewport, so only the space between widgets needs clearing
+        if (m_damage.isFull()) {
+            glClearColor(BGCOLOR_R, BGCOLOR_G, BGCOLOR_B, BGCOLOR_A);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        for (const auto& widgetContainer : m_widgetContainers)
+            widgetContainer->present(m_damage);
+    }
 
-    SwapBuffers(hdc);
     ReleaseDC(m_window.getHwnd(), hdc);
 }
 
+void RetroGraph::present() const {
+    const ProfileZone zone{ "RetroGraph::present" };
+
+    // Nothing changed, so the window already shows the current frame
+    if (!m_damage.isEmpty()) {
+        auto hdc{ GetDC(m_window.getHwnd()) };
+        {
+            // The driver may block here until earlier GL commands have been submitted
+            const ProfileZone swapZone{ "SwapBuffers" };
+            SwapBuffers(hdc);
+        }
+        ReleaseDC(m_window.getHwnd(), hdc);
+    }
+
+    m_damage.clear();
+}
+
 void RetroGraph::updateWindowSize(int newWidth, int newHeight) {
     setViewports(newWidth, newHeight);
     m_fontManager.refreshFonts(newHeight);
@@ -316,6 +458,28 @@ void RetroGraph::setViewports(int windowWidth, int windowHeight) {
     for (auto i = int{ 0 }; i < static_cast<int>(WidgetPosition::NUM_POSITIONS); ++i) {
         m_widgetContainers[i]->setViewport(windowWidth, windowHeight, static_cast<WidgetPosition>(i));
     }
+
+    // Widgets may have moved or been removed, leaving their old areas stale
+    m_damage.addAll();
+}
+
+void RetroGraph::setMeasuresSuspended(bool suspended) {
+    const auto setSuspended = [suspended](const auto& measure) {
+        if (measure)
+            measure->setSuspended(suspended);
+    };
+
+    setSuspended(m_cpuMeasure);
+    setSuspended(m_gpuMeasure);
+    setSuspended(m_ramMeasure);
+    setSuspended(m_netMeasure);
+    setSuspended(m_processMeasure);
+    setSuspended(m_driveMeasure);
+    setSuspended(m_musicMeasure);
+    setSuspended(m_systemMeasure);
+    setSuspended(m_animationState);
+    setSuspended(m_displayMeasure);
+    setSuspended(m_timeMeasure);
 }
 
 void RetroGraph::cleanupUnusedMeasures() {
@@ -351,9 +515,9 @@ std::unique_ptr<Widget> RetroGraph::createWidget(WidgetType widgetType) {
         case WidgetType::HDD:
             return std::make_unique<HDDWidget>(&m_fontManager, getOrCreate(m_driveMeasure));
         case WidgetType::Main:
-            return std::make_unique<MainWidget>(&m_fontManager, getOrCreate(m_animationState));
+            return std::make_unique<MainWidget>(&m_fontManager, getOrCreateMutable(m_animationState));
         case WidgetType::FPS:
-            return std::make_unique<FPSWidget>(&m_fontManager, m_fpsCounter);
+            return std::make_unique<FPSWidget>(&m_fontManager, m_fpsCounter, m_fpsLimiter);
         case WidgetType::NetStats:
             return std::make_unique<NetStatsWidget>(&m_fontManager, getOrCreate(m_netMeasure));
         case WidgetType::CPUGraph:
@@ -378,8 +542,14 @@ ConfigRefreshedEvent::Handle RetroGraph::RegisterConfigRefreshedCallback() {
 
         auto& settings{ UserSettings::inst() };
 
-        // if (m_cpuMeasure) m_cpuMeasure->update();
-        // if (m_gpuMeasure) m_gpuMeasure->update();
+        if (m_cpuMeasure) {
+            m_cpuMeasure->setUpdateInterval(milliseconds{ settings.getVal<int>("Measures-CPU.UpdateInterval") });
+            m_cpuMeasure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-CPU"));
+        }
+        if (m_gpuMeasure) {
+            m_gpuMeasure->setUpdateInterval(milliseconds{ settings.getVal<int>("Measures-GPU.UpdateInterval") });
+            m_gpuMeasure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-GPU"));
+        }
         // if (m_netMeasure) m_netMeasure->update();
         // if (m_processMeasure) m_processMeasure->update();
         if (m_driveMeasure)
@@ -387,10 +557,13 @@ ConfigRefreshedEvent::Handle RetroGraph::RegisterConfigRefreshedCallback() {
         if (m_musicMeasure)
             m_musicMeasure->setUpdateInterval(milliseconds{ settings.getVal<int>("Measures-Music.UpdateInterval") });
         // if (m_systemMeasure) m_systemMeasure->update();
-        // if (m_animationState) m_animationState->update();
+        if (m_animationState)
+            m_animationState->setSettings(getAnimationSettings());
         // if (m_displayMeasure) m_displayMeasure->update();
-        if (m_ramMeasure)
+        if (m_ramMeasure) {
             m_ramMeasure->setUpdateInterval(milliseconds{ settings.getVal<int>("Measures-RAM.UpdateInterval") });
+            m_ramMeasure->setAdaptiveInterval(getAdaptiveIntervalSettings("Measures-RAM"));
+        }
         if (m_timeMeasure)
             m_timeMeasure->setUpdateInterval(milliseconds{ settings.getVal<int>("Measures-Time.UpdateInterval") });
 
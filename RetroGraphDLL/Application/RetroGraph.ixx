@@ -6,6 +6,7 @@ import :Window;
 import FPSCounter;
 import FPSLimiter;
 
+import RG.Core;
 import RG.Measures;
 import RG.Measures.DataSources;
 import RG.Rendering;
@@ -40,6 +41,8 @@ public:
 private:
     void update();
     void draw() const;
+    void present() const;
+    FrameRateInputs getFrameRateInputs(bool occluded) const;
     bool isRunning() const { return m_window.isRunning(); }
 
     void tryRefreshConfig();
@@ -54,11 +57,25 @@ private:
     auto createWidgetPositions() const;
     void cleanupUnusedMeasures();
 
+    /* Stops or restarts sampling in every measure, for while the widgets showing them can't be seen */
+    void setMeasuresSuspended(bool suspended);
+
+    /* Returns the given measure, creating it first if nothing is using it yet */
+    template<std::derived_from<Measure> T>
+    std::shared_ptr<const T> getOrCreate(std::shared_ptr<T>& measure);
+
+    /* As getOrCreate, for widgets that also hand their measure somewhere to write to */
+    template<std::derived_from<Measure> T>
+    std::shared_ptr<T> getOrCreateMutable(std::shared_ptr<T>& measure);
+
     bool isWidgetVisible(WidgetType w) const { return m_widgets[static_cast<int>(w)] != nullptr; }
     WidgetPosition getWidgetPosition(WidgetType w) const { return m_widgetPositions[static_cast<int>(w)]; }
 
     ConfigRefreshedEvent::Handle RegisterConfigRefreshedCallback();
 
+    // Read at most once per update by every measure that needs the system's CPU times
+    std::shared_ptr<SystemTimes> m_systemTimes;
+
     std::shared_ptr<CPUMeasure> m_cpuMeasure;
     std::shared_ptr<GPUMeasure> m_gpuMeasure;
     std::shared_ptr<RAMMeasure> m_ramMeasure;
@@ -74,11 +91,13 @@ private:
     Window m_window;
     FontManager m_fontManager;
     FPSCounter m_fpsCounter;
+    FPSLimiter m_fpsLimiter;
 
     std::vector<WidgetPosition> m_widgetPositions;
     bool m_drawWidgetBackgrounds;
     std::vector<std::unique_ptr<Widget>> m_widgets;
     std::vector<std::unique_ptr<WidgetContainer>> m_widgetContainers;
+    mutable DamageRegion m_damage;
 
     ConfigRefreshedEvent::Handle m_configRefreshedHandle;
 };
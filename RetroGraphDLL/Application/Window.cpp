@@ -6,14 +6,19 @@ module;
 module RG.Application:Window;
 
 import Colors;
+import Utils;
 
 import RG.Application;
+import RG.Core;
+import RG.Rendering;
 
 import "RGAssert.h";
 import "GLHeaderUnit.h";
 import "GlutHeaderUnit.h";
 import "WindowsHeaderUnit.h";
 
+#pragma comment(lib, "Wtsapi32.lib")
+
 namespace rg {
 
 constexpr auto WM_NOTIFY_RG_TRAY = int{ 3141 };
@@ -36,7 +41,8 @@ constexpr auto ID_TOGGLE_CPU_GRAPH_WIDGET = int{ 15 };
 constexpr auto ID_TOGGLE_GPU_GRAPH_WIDGET = int{ 16 };
 constexpr auto ID_TOGGLE_RAM_GRAPH_WIDGET = int{ 17 };
 constexpr auto ID_TOGGLE_NET_GRAPH_WIDGET = int{ 18 };
-constexpr auto ID_CHANGE_DISPLAY_MONITOR = int{ 19 }; // Should always be last ID in the list
+constexpr auto ID_SAVE_PROFILE_TRACE = int{ 19 };
+constexpr auto ID_CHANGE_DISPLAY_MONITOR = int{ 20 }; // Should always be last ID in the list
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     // Get the Window pointer from the handle, and call the alternate WndProc if it was found
@@ -71,6 +77,7 @@ Window::Window(IRetroGraph* rg_, std::shared_ptr<const DisplayMeasure> displayMe
 
 Window::~Window() {
     UserSettings::inst().configRefreshed.detach(m_configRefreshedHandle);
+    WTSUnRegisterSessionNotification(m_hWndMain);
     wglMakeCurrent(nullptr, nullptr);
     wglDeleteContext(m_hrc);
 
@@ -89,7 +96,7 @@ LRESULT CALLBACK Window::WndProc2(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPa
             EndPaint(hWnd, &ps);
             return 0;
         case WM_SIZE:
-            glViewport(0, 0, LOWORD(lParam), HIWORD(lParam));
+            setGLViewport({ 0, 0, LOWORD(lParam), HIWORD(lParam) });
             PostMessage(hWnd, WM_PAINT, 0, 0);
             return 0;
         case WM_NOTIFY_RG_TRAY:
@@ -161,6 +168,19 @@ LRESULT CALLBACK Window::WndProc2(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPa
             if ('R' == wParam && (::GetKeyState(VK_CONTROL) >> 15)) {
                 m_retroGraph->reloadResources();
             }
+            if constexpr (profilingEnabled) {
+                // ctrl-p saves a trace of the recent profile zones
+                if ('P' == wParam && (::GetKeyState(VK_CONTROL) >> 15)) {
+                    saveProfileTrace();
+                }
+            }
+            break;
+
+        case WM_WTSSESSION_CHANGE:
+            if (wParam == WTS_SESSION_LOCK)
+                m_sessionLocked = true;
+            else if (wParam == WTS_SESSION_UNLOCK)
+                m_sessionLocked = false;
             break;
 
         case WM_QUIT:
@@ -192,6 +212,9 @@ void Window::createRClickMenu(HWND hWnd) {
     if constexpr (debugMode) {
         InsertMenu(hPopupMenu, 0, MF_BYPOSITION | MF_STRING, ID_TEST, "Test");
     }
+    if constexpr (profilingEnabled) {
+        InsertMenu(hPopupMenu, 0, MF_BYPOSITION | MF_STRING, ID_SAVE_PROFILE_TRACE, "Save Profile Trace");
+    }
 
     // Create an option for each monitor for multi-monitor systems
     const auto& md{ m_displayMeasure->getMonitors()->getMonitorData() };
@@ -237,6 +260,9 @@ void Window::createRClickMenu(HWND hWnd) {
         case ID_TEST:
             runTest();
             break;
+        case ID_SAVE_PROFILE_TRACE:
+            saveProfileTrace();
+            break;
         case ID_TOGGLE_MUSIC_WIDGET:
             m_retroGraph->toggleWidget(WidgetType::Music);
             break;
@@ -313,6 +339,12 @@ void Window::changeMonitor(HWND hWnd, int monIndex) {
     }
 }
 
+void Window::saveProfileTrace() const {
+    const auto tracePath{ getExePath() + R"(\RetroGraph_trace.json)" };
+    if (!Profiler::inst().writeChromeTrace(tracePath))
+        RGERROR(("Failed to write profile trace to " + tracePath).c_str());
+}
+
 void Window::handleTrayMessage(HWND hWnd, WPARAM /*wParam*/, LPARAM lParam) {
     switch (LOWORD(lParam)) {
         case WM_MBUTTONUP:
@@ -370,9 +402,33 @@ void Window::createWindow() {
 
     initOpenGL();
 
+    // Get told when the session is locked so drawing can stop
+    WTSRegisterSessionNotification(m_hWndMain, NOTIFY_FOR_THIS_SESSION);
+
     ReleaseDC(m_hWndMain, m_hdc);
 }
 
+bool Window::isOccluded() const {
+    if (m_sessionLocked || IsIconic(m_hWndMain) || !IsWindowVisible(m_hWndMain))
+        return true;
+
+    // The monitor the window was on has been disconnected
+    if (!MonitorFromWindow(m_hWndMain, MONITOR_DEFAULTTONULL))
+        return true;
+
+    // The window lives on the desktop, so a fullscreen application in front of it on the same monitor covers all of it
+    QUERY_USER_NOTIFICATION_STATE state;
+    if (FAILED(SHQueryUserNotificationState(&state)) ||
+        (state != QUNS_BUSY && state != QUNS_RUNNING_D3D_FULL_SCREEN))
+        return false;
+
+    // The notification state is for the whole session, so check the fullscreen window is on this window's monitor
+    const auto foregroundWindow{ GetForegroundWindow() };
+    return foregroundWindow && foregroundWindow != m_hWndMain &&
+           MonitorFromWindow(foregroundWindow, MONITOR_DEFAULTTONULL) ==
+               MonitorFromWindow(m_hWndMain, MONITOR_DEFAULTTONEAREST);
+}
+
 void Window::createTrayIcon() {
     m_tray.cbSize = sizeof(m_tray);
     m_tray.hIcon = LoadIcon(GetResourceHandle(), MAKEINTRESOURCE(IDI_APP_ICON));
@@ -641,6 +697,8 @@ bool Window::initMultisample() {
                           GL_TRUE,
                           WGL_SAMPLES_ARB,
                           8,
+                          WGL_SWAP_METHOD_ARB,
+                          WGL_SWAP_COPY_ARB,
                           0,
                           0 };
 
@@ -649,32 +707,23 @@ bool Window::initMultisample() {
     unsigned int numFormats;
     float fAttributes[] = { 0, 0 };
 
-    // First we check to see if we can get a pixel format for 8 samples
-    valid = wglChoosePixelFormatARB(m_hdc, iAttributes, fAttributes, 1, &pixelFormat, &numFormats);
-
-    // If we returned true, and our format count is greater than 1
-    if (valid && numFormats >= 1) {
-        m_arbMultisampleSupported = true;
-        m_arbMultisampleFormat = pixelFormat;
-        return true;
-    }
-
-    // Our pixel format with 8 samples failed, test for 4 samples
-    iAttributes[19] = 4;
-    valid = wglChoosePixelFormatARB(m_hdc, iAttributes, fAttributes, 1, &pixelFormat, &numFormats);
-    if (valid && numFormats >= 1) {
-        m_arbMultisampleSupported = true;
-        m_arbMultisampleFormat = pixelFormat;
-        return true;
-    }
-
-    // Our pixel format with 2 samples failed, test for 2 samples
-    iAttributes[19] = 2;
-    valid = wglChoosePixelFormatARB(m_hdc, iAttributes, fAttributes, 1, &pixelFormat, &numFormats);
-    if (valid && numFormats >= 1) {
-        m_arbMultisampleSupported = true;
-        m_arbMultisampleFormat = pixelFormat;
-        return true;
+    // Prefer formats that copy the back buffer on swap rather than exchanging it, so the back buffer keeps the last
+    // frame and only the widgets that changed need to be drawn into it. Otherwise drop the swap method attribute
+    // and take whatever the driver gives us
+    for (const bool swapCopy : { true, false }) {
+        iAttributes[20] = swapCopy ? WGL_SWAP_METHOD_ARB : 0;
+
+        // Try for 8 samples, then fall back to 4 and 2
+        for (const int samples : { 8, 4, 2 }) {
+            iAttributes[19] = samples;
+            valid = wglChoosePixelFormatARB(m_hdc, iAttributes, fAttributes, 1, &pixelFormat, &numFormats);
+            if (valid && numFormats >= 1) {
+                m_arbMultisampleSupported = true;
+                m_arbMultisampleFormat = pixelFormat;
+                m_preservesBackBuffer = swapCopy;
+                return true;
+            }
+        }
     }
 
     return m_arbMultisampleSupported;
@@ -38,8 +38,15 @@ public:
     HWND getHwnd() const { return m_hWndMain; }
     HGLRC getHGLRC() const { return m_hrc; }
 
+    /* Whether the back buffer still holds the last frame after swapping buffers */
+    bool preservesBackBuffer() const { return m_preservesBackBuffer; }
+
     bool isRunning() const { return m_running; }
 
+    /* Whether none of the window can be seen, i.e. it's minimized, hidden, covered by a fullscreen application, on a
+     * disconnected monitor or the session is locked */
+    bool isOccluded() const;
+
 private:
     /* Creates the window and the OpenGL context */
     void createWindow();
@@ -86,6 +93,9 @@ private:
     /* Sends the window to the background layer (i.e. on the desktop) */
     void sendToBack() const;
 
+    /* Writes the profiler's recorded zones next to the executable as a Chrome trace */
+    void saveProfileTrace() const;
+
     // Passes Window this pointer via userParam
     static void GLAPIENTRY GLMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
                                              const GLchar* message, const void* userParam);
@@ -100,6 +110,7 @@ private:
 
     NOTIFYICONDATA m_tray{};
     bool m_dragging{ false };
+    bool m_sessionLocked{ false };
     int m_currMonitor{ 0 };
     int m_width{ 0 };
     int m_height{ 0 };
@@ -107,6 +118,7 @@ private:
     int m_startPosY{ 0 };
     bool m_arbMultisampleSupported{ false };
     int m_arbMultisampleFormat{ 0 };
+    bool m_preservesBackBuffer{ false };
     HINSTANCE m_hInstance{ nullptr };
     ConfigRefreshedEvent::Handle m_configRefreshedHandle;
 };
@@ -0,0 +1,78 @@
+export module RG.Core:AdaptiveInterval;
+
+import std.core;
+
+namespace rg {
+
+using namespace std::chrono;
+
+export struct AdaptiveIntervalSettings {
+    // Interval while the sampled value is changing, and the shortest one ever used
+    milliseconds minInterval{ 1000 };
+
+    // Longest the interval widens to while the sampled value is stable
+    milliseconds maxInterval{ 8000 };
+
+    // How far a sample can move from the value the current stable run started at before it counts as a change
+    float changeThreshold{ 0.05f };
+
+    // Number of stable samples in a row before the interval is doubled
+    int stableSamplesToWiden{ 3 };
+};
+
+/* Picks how long to wait before taking the next sample of a value from how much the value has been changing.
+ * Every sample is compared with the one that started the current stable run. A sample further away than the
+ * threshold is a change point, and drops the interval straight back to the minimum so bursts are followed closely.
+ * Otherwise the interval doubles after every few stable samples, up to the maximum, so a flat signal costs little.
+ */
+export class AdaptiveInterval {
+public:
+    explicit AdaptiveInterval(const AdaptiveIntervalSettings& settings) { setSettings(settings); }
+
+    void setSettings(const AdaptiveIntervalSettings& settings) {
+        m_settings = settings;
+        m_settings.minInterval = std::max(m_settings.minInterval, milliseconds{ 1 });
+        m_settings.maxInterval = std::max(m_settings.maxInterval, m_settings.minInterval);
+        m_settings.stableSamplesToWiden = std::max(m_settings.stableSamplesToWiden, 1);
+        reset();
+    }
+
+    const AdaptiveIntervalSettings& getSettings() const { return m_settings; }
+
+    /* Forgets the samples seen so far, so the next sample starts a new stable run at the minimum interval */
+    void reset() {
+        m_baseline.reset();
+        m_stableSamples = 0;
+        m_interval = m_settings.minInterval;
+    }
+
+    /* Records a sample and returns the interval to wait before taking the next one */
+    milliseconds addSample(float value) {
+        if (!m_baseline || std::abs(value - *m_baseline) > m_settings.changeThreshold) {
+            m_baseline = value;
+            m_stableSamples = 0;
+            m_interval = m_settings.minInterval;
+        } else if (++m_stableSamples >= m_settings.stableSamplesToWiden) {
+            m_stableSamples = 0;
+            m_interval = std::min(m_interval * 2, m_settings.maxInterval);
+        }
+        return m_interval;
+    }
+
+    milliseconds getInterval() const { return m_interval; }
+
+    /* How many minimum intervals the current interval spans, so a sample can be placed on a graph whose points are
+     * the minimum interval apart
+     */
+    int getSampleSpan() const {
+        return static_cast<int>((m_interval + m_settings.minInterval / 2) / m_settings.minInterval);
+    }
+
+private:
+    AdaptiveIntervalSettings m_settings;
+    std::optional<float> m_baseline;
+    int m_stableSamples{ 0 };
+    milliseconds m_interval;
+};
+
+} // namespace rg
@@ -1,8 +1,16 @@
 export module RG.Core;
 
+export import :AdaptiveInterval;
 export import :CallbackEvent;
+export import :FrameRateGovernor;
+export import :Histogram;
+export import :JobSystem;
+export import :LRUCache;
 export import :Math;
 export import :Profiling;
+export import :Random;
+export import :SlidingWindow;
 export import :Strings;
 export import :Time;
 export import :Units;
+export import :WaitTimer;
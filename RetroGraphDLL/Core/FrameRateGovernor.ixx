@@ -0,0 +1,100 @@
+export module RG.Core:FrameRateGovernor;
+
+import std.core;
+
+namespace rg {
+
+using namespace std::chrono;
+
+export struct FrameRateLimits {
+    // Slowest rate while the window is visible, so changes that no measure reports are still shown eventually
+    int minFPS{ 1 };
+
+    // Rate while animating or while the user is interacting with the window
+    int maxFPS{ 30 };
+
+    // How long after the last user input the window keeps running at the maximum rate
+    milliseconds interactionHoldTime{ 2000 };
+};
+
+// State of the application that the frame rate depends on, sampled at the end of every frame
+export struct FrameRateInputs {
+    // Something is animated every frame, e.g. the main widget's particles
+    bool animating{ false };
+
+    // Nothing the window draws can be seen, e.g. it's covered, minimized or the session is locked
+    bool suspended{ false };
+
+    // When the next measure is due to update. Empty if no measure updates by itself
+    std::optional<steady_clock::time_point> nextMeasureUpdate;
+};
+
+export enum class FrameRateMode {
+    Full, // Running at the maximum rate
+    Idle, // Waking up only when a measure is due, bounded by the minimum and maximum rates
+    Suspended, // Not drawing at all
+};
+
+/* Picks when the next frame should start from what is visible and changing.
+ * Runs at the maximum rate while animating or the user is interacting, otherwise wakes up when the next measure is
+ * due so new data is drawn as soon as it arrives, and stops drawing while suspended.
+ * Time is passed in rather than read from a clock so the governor can be driven by a simulated clock.
+ */
+export class FrameRateGovernor {
+public:
+    explicit FrameRateGovernor(const FrameRateLimits& limits) { setLimits(limits); }
+
+    void setLimits(const FrameRateLimits& limits) {
+        m_limits = limits;
+        m_limits.maxFPS = std::max(m_limits.maxFPS, 1);
+        m_limits.minFPS = std::clamp(m_limits.minFPS, 1, m_limits.maxFPS);
+    }
+
+    const FrameRateLimits& getLimits() const { return m_limits; }
+
+    void notifyUserInput(steady_clock::time_point time) { m_lastUserInput = time; }
+
+    /* Returns when the frame after the one that started at frameStart should start, or nothing while suspended */
+    std::optional<steady_clock::time_point> getNextFrameTime(steady_clock::time_point frameStart,
+                                                             const FrameRateInputs& inputs) {
+        if (inputs.suspended) {
+            m_mode = FrameRateMode::Suspended;
+            m_targetFPS = 0.0;
+            return std::nullopt;
+        }
+
+        const auto earliest{ frameStart + getFrameTime(m_limits.maxFPS) };
+        auto nextFrame{ earliest };
+        if (inputs.animating || isInteracting(frameStart)) {
+            m_mode = FrameRateMode::Full;
+        } else {
+            m_mode = FrameRateMode::Idle;
+            const auto latest{ frameStart + getFrameTime(m_limits.minFPS) };
+            nextFrame = std::clamp(inputs.nextMeasureUpdate.value_or(latest), earliest, latest);
+        }
+
+        m_targetFPS = 1.0 / duration<double>{ nextFrame - frameStart }.count();
+        return nextFrame;
+    }
+
+    FrameRateMode getMode() const { return m_mode; }
+
+    /* The frame rate the last frame was scheduled for. Zero while suspended */
+    double getTargetFPS() const { return m_targetFPS; }
+
+private:
+    static steady_clock::duration getFrameTime(int fps) {
+        return duration_cast<steady_clock::duration>(duration<double>{ 1.0 } / fps);
+    }
+
+    bool isInteracting(steady_clock::time_point time) const {
+        return m_lastUserInput && time - *m_lastUserInput < m_limits.interactionHoldTime;
+    }
+
+    FrameRateLimits m_limits;
+    std::optional<steady_clock::time_point> m_lastUserInput;
+    FrameRateMode m_mode{ FrameRateMode::Full };
+    double m_targetFPS{ 0.0 };
+};
+
+} // namespace rg
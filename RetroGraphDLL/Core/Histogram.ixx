@@ -0,0 +1,91 @@
+export module RG.Core:Histogram;
+
+import std.core;
+
+namespace rg {
+
+using namespace std::chrono;
+
+/* Histogram of durations in microseconds with log-linear buckets: every power of two range is split into
+ * subBucketsPerRange equal buckets, so durations from microseconds to over half an hour are all recorded to within
+ * 12.5%. Durations below subBucketsPerRange us get a bucket each.
+ * Recording is O(1) and never allocates, so it can be done every frame.
+ */
+export class DurationHistogram {
+public:
+    static constexpr size_t subBucketsPerRange{ 8 };
+    static constexpr size_t subBucketBits{ 3 };
+    static constexpr size_t numBuckets{ subBucketsPerRange * 30 };
+
+    void record(microseconds duration) {
+        const auto us{ static_cast<uint64_t>(std::max(duration.count(), int64_t{ 0 })) };
+        ++m_buckets[getBucket(us)];
+        ++m_count;
+        m_total += microseconds{ us };
+        m_max = std::max(m_max, microseconds{ us });
+    }
+
+    void clear() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_total = microseconds{ 0 };
+        m_max = microseconds{ 0 };
+    }
+
+    uint64_t getCount() const { return m_count; }
+    uint64_t getBucketCount(size_t bucket) const { return m_buckets[bucket]; }
+    microseconds getMax() const { return m_max; }
+    microseconds getMean() const { return m_count == 0 ? microseconds{ 0 } : m_total / static_cast<int64_t>(m_count); }
+
+    /* Exclusive upper bound of the durations in a bucket */
+    static microseconds getBucketUpperBound(size_t bucket) {
+        if (bucket < subBucketsPerRange)
+            return microseconds{ static_cast<int64_t>(bucket) + 1 };
+
+        // Undo getBucket. The range's highest bit and the sub-bucket are the top bits of the bucket's durations
+        const auto range{ bucket / subBucketsPerRange };
+        const auto subBucket{ bucket % subBucketsPerRange };
+        return microseconds{ static_cast<int64_t>(subBucketsPerRange + subBucket + 1) << (range - 1) };
+    }
+
+    /* Estimates the duration that the given fraction (0 to 1) of recorded durations are below, as the upper bound of
+     * the bucket it falls in. Never more than the largest recorded duration */
+    microseconds getPercentile(double fraction) const {
+        if (m_count == 0)
+            return microseconds{ 0 };
+
+        const auto rank{ std::max(static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * m_count)),
+                                  uint64_t{ 1 }) };
+        uint64_t seen{ 0 };
+        for (size_t i{ 0 }; i < numBuckets; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank)
+                return std::min(getBucketUpperBound(i), m_max);
+        }
+
+        return m_max;
+    }
+
+private:
+    // Small durations are their own bucket. Otherwise the bucket is picked by the position of the highest set bit,
+    // then by the subBucketBits bits below it
+    static size_t getBucket(uint64_t us) {
+        if (us < subBucketsPerRange)
+            return static_cast<size_t>(us);
+
+        size_t highestBit{ 0 };
+        for (auto bits{ us }; bits > 1; bits >>= 1)
+            ++highestBit;
+
+        const auto shift{ highestBit - subBucketBits };
+        const auto subBucket{ static_cast<size_t>(us >> shift) - subBucketsPerRange };
+        return std::min((shift + 1) * subBucketsPerRange + subBucket, numBuckets - 1);
+    }
+
+    std::array<uint64_t, numBuckets> m_buckets{};
+    uint64_t m_count{ 0 };
+    microseconds m_total{ 0 };
+    microseconds m_max{ 0 };
+};
+
+} // namespace rg
@@ -0,0 +1,137 @@
+module RG.Core:JobSystem;
+
+import :Profiling;
+
+import std.core;
+import std.threading;
+
+import "RGAssert.h";
+
+namespace rg {
+
+namespace {
+
+// The job system whose worker this thread is, if any, and the thread's index in it
+thread_local const JobSystem* currentJobSystem{ nullptr };
+thread_local size_t currentThreadIndex{ 0 };
+
+} // namespace
+
+size_t JobSystem::getDefaultNumThreads() {
+    return std::max(size_t{ std::thread::hardware_concurrency() }, size_t{ 1U });
+}
+
+JobSystem::JobSystem(size_t numThreads)
+    : m_deques{}
+    , m_workers{}
+    , m_ownerThread{ std::this_thread::get_id() }
+    , m_numQueued{ 0 }
+    , m_wakeMutex{}
+    , m_wakeCondition{}
+    , m_stopping{ false } {
+
+    numThreads = std::max(numThreads, size_t{ 1U });
+    for (auto i = size_t{ 0U }; i < numThreads; ++i)
+        m_deques.push_back(std::make_unique<JobDeque>());
+
+    // Thread 0 is the creating thread
+    for (auto i = size_t{ 1U }; i < numThreads; ++i)
+        m_workers.emplace_back([this, i]() { runWorker(i); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::scoped_lock lock{ m_wakeMutex };
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void JobSystem::fork(Group& group, JobFunction job) {
+    const auto threadIndex{ getCurrentThreadIndex() };
+    group.m_numPending.fetch_add(1, std::memory_order_relaxed);
+
+    // Counted under the wake mutex so a worker can't check for jobs, miss this one and then sleep through the notify.
+    // Counted before the push so a thief that takes the job straight away can't take the count below zero
+    {
+        std::scoped_lock lock{ m_wakeMutex };
+        m_numQueued.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        auto& deque{ *m_deques[threadIndex] };
+        std::scoped_lock lock{ deque.mutex };
+        deque.jobs.push_back(Job{ std::move(job), &group });
+    }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::join(Group& group) {
+    const auto threadIndex{ getCurrentThreadIndex() };
+    while (group.m_numPending.load(std::memory_order_acquire) > 0) {
+        if (auto job{ tryTakeJob(threadIndex) })
+            runJob(*job, threadIndex);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::runWorker(size_t threadIndex) {
+    currentJobSystem = this;
+    currentThreadIndex = threadIndex;
+    if constexpr (profilingEnabled)
+        Profiler::inst().setThreadName(std::format("Job worker {}", threadIndex));
+
+    while (true) {
+        if (auto job{ tryTakeJob(threadIndex) }) {
+            runJob(*job, threadIndex);
+            continue;
+        }
+
+        std::unique_lock lock{ m_wakeMutex };
+        m_wakeCondition.wait(lock, [this]() { return m_stopping || m_numQueued.load() > 0; });
+        if (m_stopping)
+            return;
+    }
+}
+
+size_t JobSystem::getCurrentThreadIndex() const {
+    if (currentJobSystem == this)
+        return currentThreadIndex;
+
+    RGASSERT(std::this_thread::get_id() == m_ownerThread, "Jobs can only be forked by the JobSystem's creating thread");
+    return 0;
+}
+
+std::optional<JobSystem::Job> JobSystem::tryTakeJob(size_t threadIndex) {
+    const auto numThreads{ getNumThreads() };
+    for (auto i = size_t{ 0U }; i < numThreads; ++i) {
+        // Own deque first, then the others starting from the next thread so thieves spread across victims
+        auto& deque{ *m_deques[(threadIndex + i) % numThreads] };
+        std::scoped_lock lock{ deque.mutex };
+        if (deque.jobs.empty())
+            continue;
+
+        std::optional<Job> job;
+        if (i == 0) {
+            job = std::move(deque.jobs.back());
+            deque.jobs.pop_back();
+        } else {
+            job = std::move(deque.jobs.front());
+            deque.jobs.pop_front();
+        }
+        m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+    return std::nullopt;
+}
+
+void JobSystem::runJob(Job& job, size_t threadIndex) {
+    job.function(threadIndex);
+    job.group->m_numPending.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace rg
@@ -0,0 +1,110 @@
+export module RG.Core:JobSystem;
+
+import std.core;
+import std.threading;
+
+namespace rg {
+
+/* Small work-stealing thread pool for splitting work into jobs and waiting for all of them to finish (fork-join).
+ * Every thread has its own deque of jobs. Forked jobs are pushed to the back of the forking thread's deque and it takes
+ * them back from the back, so it works on the jobs it forked most recently. Idle threads steal from the front of other
+ * threads' deques, taking the oldest jobs.
+ * The thread that creates the JobSystem works on jobs too while joining, as thread 0. Jobs must only be forked from
+ * that thread or from inside other jobs.
+ */
+export class JobSystem {
+public:
+    using JobFunction = std::function<void(size_t threadIndex)>;
+
+    /* Jobs forked together, which are joined together */
+    class Group {
+    public:
+        Group() = default;
+        ~Group() = default;
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+        Group(Group&&) = delete;
+        Group& operator=(Group&&) = delete;
+
+    private:
+        friend class JobSystem;
+        std::atomic<size_t> m_numPending{ 0 };
+    };
+
+    /* One thread per CPU core */
+    static size_t getDefaultNumThreads();
+
+    /* Starts numThreads - 1 worker threads, as the creating thread is also used */
+    explicit JobSystem(size_t numThreads = getDefaultNumThreads());
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    /* Number of threads jobs can run on, including the creating thread */
+    size_t getNumThreads() const { return m_deques.size(); }
+
+    /* Queues job to be run on any thread as part of group. The job is given the index of the thread it runs on, which is
+     * below getNumThreads(). Jobs on the same thread never run at the same time, so the index can select per-thread
+     * data that's used without locks
+     */
+    void fork(Group& group, JobFunction job);
+
+    /* Runs queued jobs until every job in group has finished */
+    void join(Group& group);
+
+    /* Calls f(job, threadIndex) for every job in [0, numJobs), returning once they've all finished */
+    template<typename F>
+    void parallelFor(size_t numJobs, F&& f);
+
+private:
+    struct Job {
+        JobFunction function;
+        Group* group;
+    };
+
+    // Padded so threads working on their own deques don't contend on the same cache line
+    struct alignas(std::hardware_destructive_interference_size) JobDeque {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void runWorker(size_t threadIndex);
+    size_t getCurrentThreadIndex() const;
+    std::optional<Job> tryTakeJob(size_t threadIndex);
+    void runJob(Job& job, size_t threadIndex);
+
+    std::vector<std::unique_ptr<JobDeque>> m_deques;
+    std::vector<std::thread> m_workers;
+    std::thread::id m_ownerThread;
+
+    // Queued jobs across all deques. Sleeping workers are woken when it's above zero
+    std::atomic<size_t> m_numQueued;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stopping;
+};
+
+template<typename F>
+void JobSystem::parallelFor(size_t numJobs, F&& f) {
+    if (numJobs == 0)
+        return;
+
+    const auto threadIndex{ getCurrentThreadIndex() };
+    if (numJobs == 1 || getNumThreads() == 1) {
+        for (auto job = size_t{ 0U }; job < numJobs; ++job)
+            f(job, threadIndex);
+        return;
+    }
+
+    // The first job runs here, so only the rest need queueing
+    Group group;
+    for (auto job = size_t{ 1U }; job < numJobs; ++job)
+        fork(group, [&f, job](size_t jobThreadIndex) { f(job, jobThreadIndex); });
+
+    f(size_t{ 0U }, threadIndex);
+    join(group);
+}
+
+} // namespace rg
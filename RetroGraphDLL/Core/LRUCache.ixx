@@ -0,0 +1,81 @@
+export module RG.Core:LRUCache;
+
+import std.core;
+
+namespace rg {
+
+/* Fixed capacity cache that evicts the least recently used entry when full.
+ * Entries are kept in a list from most to least recently used, with a hash map pointing into the list.
+ * If Hash and KeyEqual are transparent, find() can take any type they accept, e.g. a string_view view of a key that
+ * owns a string, so lookups don't have to allocate.
+ * Counts hits and misses of find() so the cache's effectiveness can be measured.
+ */
+export template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LRUCache {
+public:
+    explicit LRUCache(size_t capacity)
+        : m_capacity{ std::max(capacity, size_t{ 1U }) } {
+        m_map.reserve(m_capacity);
+    }
+
+    /* Returns the cached value for key and marks it as most recently used, or nullptr if it isn't cached */
+    template<typename LookupKey>
+    Value* find(const LookupKey& key) {
+        const auto it{ m_map.find(key) };
+        if (it == m_map.end()) {
+            ++m_misses;
+            return nullptr;
+        }
+
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    /* Adds a value as the most recently used entry, evicting the least recently used entry if the cache is full.
+     * key must not already be cached */
+    Value& insert(Key key, Value value) {
+        if (m_entries.size() == m_capacity) {
+            m_map.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(std::move(key), std::move(value));
+        m_map.emplace(m_entries.front().first, m_entries.begin());
+        return m_entries.front().second;
+    }
+
+    /* Removes every entry. Hit and miss counts are kept */
+    void clear() {
+        m_map.clear();
+        m_entries.clear();
+    }
+
+    void resetStats() {
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+    /* Fraction of lookups that were hits, from 0 to 1 */
+    double hitRate() const {
+        const auto lookups{ m_hits + m_misses };
+        return lookups == 0 ? 0.0 : static_cast<double>(m_hits) / lookups;
+    }
+
+private:
+    using EntryList = std::list<std::pair<Key, Value>>;
+
+    size_t m_capacity;
+    EntryList m_entries;
+    std::unordered_map<Key, typename EntryList::iterator, Hash, KeyEqual> m_map;
+    uint64_t m_hits{ 0 };
+    uint64_t m_misses{ 0 };
+};
+
+} // namespace rg
@@ -0,0 +1,120 @@
+module RG.Core:Profiling;
+
+import std.core;
+import std.filesystem;
+
+namespace rg {
+
+namespace {
+
+std::atomic<uint64_t> nextProfilerId{ 1 };
+
+std::string escapeJsonString(std::string_view str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const auto c : str) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // namespace
+
+void ProfileEventBuffer::copyEvents(std::vector<ProfileEvent>& out) const {
+    const auto end{ m_numWritten.load(std::memory_order_acquire) };
+    const auto begin{ end > capacity ? end - capacity : 0 };
+
+    const auto firstCopied{ out.size() };
+    for (auto i{ begin }; i < end; ++i)
+        out.push_back(m_events[i % capacity]);
+
+    // Events the owner overwrote while they were being copied may be torn, so they're dropped. That includes the
+    // slot the owner may be in the middle of writing, which hasn't been counted yet
+    const auto endAfterCopy{ m_numWritten.load(std::memory_order_acquire) + 1 };
+    const auto firstIntact{ endAfterCopy > capacity ? endAfterCopy - capacity : 0 };
+    if (firstIntact > begin) {
+        const auto numTorn{ std::min(firstIntact - begin, end - begin) };
+        out.erase(out.begin() + firstCopied, out.begin() + firstCopied + numTorn);
+    }
+}
+
+Profiler::Profiler()
+    : m_id{ nextProfilerId++ }
+    , m_startTime{ steady_clock::now() }
+    , m_buffersMutex{}
+    , m_buffers{} {}
+
+Profiler& Profiler::inst() {
+    static Profiler profiler;
+    return profiler;
+}
+
+ProfileEventBuffer& Profiler::getThreadBuffer(std::string_view threadName) {
+    // Each thread remembers its buffer in the profiler it last recorded to. Normally there's only the global profiler
+    thread_local uint64_t cachedProfilerId{ 0 };
+    thread_local ProfileEventBuffer* cachedBuffer{ nullptr };
+    if (cachedProfilerId == m_id)
+        return *cachedBuffer;
+
+    std::scoped_lock lock{ m_buffersMutex };
+    const auto threadId{ static_cast<uint32_t>(m_buffers.size()) };
+    m_buffers.push_back(std::make_unique<ProfileEventBuffer>(
+        threadId, threadName.empty() ? std::format("Thread {}", threadId) : std::string{ threadName }));
+
+    cachedProfilerId = m_id;
+    cachedBuffer = m_buffers.back().get();
+    return *cachedBuffer;
+}
+
+void Profiler::setThreadName(std::string_view name) {
+    auto& buffer{ getThreadBuffer(name) };
+
+    // Exports read the name under the lock
+    std::scoped_lock lock{ m_buffersMutex };
+    buffer.setThreadName(std::string{ name });
+}
+
+std::string Profiler::getChromeTrace() const {
+    std::string trace{ "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" };
+    auto out{ std::back_inserter(trace) };
+    bool first{ true };
+    const auto separator = [&first]() {
+        const auto* s{ first ? "\n" : ",\n" };
+        first = false;
+        return s;
+    };
+
+    std::scoped_lock lock{ m_buffersMutex };
+    std::vector<ProfileEvent> events;
+    for (const auto& buffer : m_buffers) {
+        std::format_to(out,
+                       "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                       separator(), buffer->getThreadId(), escapeJsonString(buffer->getThreadName()));
+
+        events.clear();
+        buffer->copyEvents(events);
+
+        // Complete events with microsecond timestamps. Zone names are string literals, so they don't need escaping
+        for (const auto& event : events) {
+            std::format_to(out, "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                           separator(), event.name, buffer->getThreadId(), event.startNs / 1000.0,
+                           (event.endNs - event.startNs) / 1000.0);
+        }
+    }
+
+    trace += "\n]}\n";
+    return trace;
+}
+
+bool Profiler::writeChromeTrace(const std::string& filePath) const {
+    std::ofstream file{ std::filesystem::path{ filePath } };
+    if (!file)
+        return false;
+
+    file << getChromeTrace();
+    return static_cast<bool>(file);
+}
+
+} // namespace rg
@@ -6,7 +6,8 @@ namespace rg {
 
 using namespace std::chrono;
 
-high_resolution_clock::duration recordTimeToExecute(std::regular_invocable auto f) {
+/* Returns how long the given function f took to execute */
+export high_resolution_clock::duration recordTimeToExecute(std::regular_invocable auto f) {
     const auto start{ std::chrono::high_resolution_clock::now() };
 
     f();
@@ -35,4 +36,124 @@ export void printTimeToExecuteTicks(std::regular_invocable auto f) {
     printTimeToExecuteTicks("Function", f);
 }
 
+#ifdef RG_ENABLE_PROFILING
+export inline constexpr bool profilingEnabled{ true };
+#else
+export inline constexpr bool profilingEnabled{ false };
+#endif
+
+/* Name of a profile zone. Must be known at compile time, so events only need to store the pointer */
+export struct ProfileZoneName {
+    consteval ProfileZoneName(const char* name_)
+        : name{ name_ } {}
+
+    const char* name;
+};
+
+/* A zone recorded by a thread. Times are in nanoseconds since the profiler started */
+export struct ProfileEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+};
+
+/* Ring of the most recent events recorded by one thread.
+ * Only the owning thread records, so recording is a plain store and an atomic counter update with no locks. Any
+ * thread can copy the events out while the owner keeps recording.
+ */
+export class ProfileEventBuffer {
+public:
+    static constexpr size_t capacity{ size_t{ 1 } << 16 };
+
+    ProfileEventBuffer(uint32_t threadId, std::string threadName)
+        : m_events{ std::make_unique<ProfileEvent[]>(capacity) }
+        , m_threadId{ threadId }
+        , m_threadName{ std::move(threadName) } {}
+
+    void record(const ProfileEvent& event) {
+        const auto numWritten{ m_numWritten.load(std::memory_order_relaxed) };
+        m_events[numWritten % capacity] = event;
+        m_numWritten.store(numWritten + 1, std::memory_order_release);
+    }
+
+    /* Appends the events still in the ring to out, oldest first */
+    void copyEvents(std::vector<ProfileEvent>& out) const;
+
+    uint64_t getNumRecorded() const { return m_numWritten.load(std::memory_order_acquire); }
+    uint32_t getThreadId() const { return m_threadId; }
+    const std::string& getThreadName() const { return m_threadName; }
+    void setThreadName(std::string name) { m_threadName = std::move(name); }
+
+private:
+    std::unique_ptr<ProfileEvent[]> m_events;
+    std::atomic<uint64_t> m_numWritten{ 0 };
+    uint32_t m_threadId;
+    std::string m_threadName;
+};
+
+/* Collects profile zones from every thread and exports them as a Chrome trace, which can be opened in
+ * chrome://tracing or ui.perfetto.dev. Zones recorded inside other zones on the same thread show up nested.
+ */
+export class Profiler {
+public:
+    Profiler();
+
+    static Profiler& inst();
+
+    /* Nanoseconds since the profiler was created */
+    int64_t now() const { return duration_cast<nanoseconds>(steady_clock::now() - m_startTime).count(); }
+
+    void record(const ProfileEvent& event) { getThreadBuffer().record(event); }
+
+    /* Names the calling thread in exported traces. Threads that don't set a name are numbered */
+    void setThreadName(std::string_view name);
+
+    /* Gets every thread's recorded events in the Chrome trace event JSON format */
+    std::string getChromeTrace() const;
+
+    /* Writes the Chrome trace to a file. Returns false if the file couldn't be written */
+    bool writeChromeTrace(const std::string& filePath) const;
+
+private:
+    /* Gets the calling thread's buffer, creating it the first time the thread records */
+    ProfileEventBuffer& getThreadBuffer(std::string_view threadName = {});
+
+    // Threads cache their buffer by profiler ID rather than address, as a destroyed profiler's address can be reused
+    uint64_t m_id;
+    steady_clock::time_point m_startTime;
+
+    // Registering a new thread is the only time a lock is taken while recording
+    mutable std::mutex m_buffersMutex;
+    std::vector<std::unique_ptr<ProfileEventBuffer>> m_buffers;
+};
+
+/* Records the time from construction to destruction as a zone in the global profiler.
+ * Does nothing unless RG_ENABLE_PROFILING is defined, in which case the compiler removes it entirely
+ */
+export class ProfileZone {
+public:
+    explicit ProfileZone(ProfileZoneName name) {
+        if constexpr (profilingEnabled) {
+            m_name = name.name;
+            m_startNs = Profiler::inst().now();
+        }
+    }
+
+    ~ProfileZone() {
+        if constexpr (profilingEnabled) {
+            auto& profiler{ Profiler::inst() };
+            profiler.record({ m_name, m_startNs, profiler.now() });
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+    ProfileZone(ProfileZone&&) = delete;
+    ProfileZone& operator=(ProfileZone&&) = delete;
+
+private:
+    const char* m_name{ nullptr };
+    int64_t m_startNs{ 0 };
+};
+
 } // namespace rg
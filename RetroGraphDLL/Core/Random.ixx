@@ -0,0 +1,55 @@
+export module RG.Core:Random;
+
+import std.core;
+
+namespace rg {
+
+/* PCG32 (XSH RR) random number generator, from https://www.pcg-random.org.
+ * Small and fast, and unlike std::rand the sequence for a seed is the same on every platform and standard library, so
+ * anything generated from a seed can be reproduced exactly. Meets UniformRandomBitGenerator, so it also works with the
+ * std distributions, though their results aren't portable.
+ */
+export class Pcg32 {
+public:
+    using result_type = uint32_t;
+
+    static constexpr uint64_t defaultSeed{ 0x853c49e6748fea9bULL };
+    static constexpr uint64_t defaultStream{ 0xda3e39cb94b95bdbULL };
+
+    /* Generators with the same seed but different streams give unrelated sequences */
+    explicit constexpr Pcg32(uint64_t seed = defaultSeed, uint64_t stream = defaultStream) { reseed(seed, stream); }
+
+    constexpr void reseed(uint64_t seed, uint64_t stream = defaultStream) {
+        m_state = 0;
+        m_increment = (stream << 1U) | 1U;
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
+
+    constexpr result_type operator()() {
+        const auto oldState{ m_state };
+        m_state = oldState * multiplier + m_increment;
+
+        const auto xorShifted{ static_cast<uint32_t>(((oldState >> 18U) ^ oldState) >> 27U) };
+        const auto rotation{ static_cast<int>(oldState >> 59U) };
+        return std::rotr(xorShifted, rotation);
+    }
+
+    /* Uniform in [0, 1). Uses the top 24 bits, as many as a float can hold exactly */
+    constexpr float nextFloat() { return static_cast<float>((*this)() >> 8U) * 0x1.0p-24f; }
+
+    /* Uniform in [min, max) */
+    constexpr float nextFloat(float min, float max) { return min + (max - min) * nextFloat(); }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    static constexpr uint64_t multiplier{ 6364136223846793005ULL };
+
+    uint64_t m_state{ 0 };
+    uint64_t m_increment{ 0 };
+};
+
+} // namespace rg
@@ -0,0 +1,150 @@
+export module RG.Core:SlidingWindow;
+
+import std.core;
+
+namespace rg {
+
+/* Fixed size window over the most recently pushed values that can report the minimum and maximum value in the
+ * window in constant time. Values are stored in a ring, and the candidates for the min and max are tracked by two
+ * monotonic queues of push sequence numbers, so pushing is O(1) amortized and never allocates.
+ */
+export template<typename T>
+class SlidingWindow {
+public:
+    explicit SlidingWindow(size_t windowSize, T initialValue = T{}) { reset(windowSize, initialValue); }
+
+    /* Pushes a new value into the window, evicting the oldest one */
+    void push(T value) {
+        const auto seq{ m_numPushed++ };
+        const auto oldestSeq{ m_numPushed - size() };
+
+        m_maxQueue.popExpired(oldestSeq);
+        m_minQueue.popExpired(oldestSeq);
+
+        m_values[seq % size()] = value;
+        m_maxQueue.push(seq, m_values, [value](T v) { return v <= value; });
+        m_minQueue.push(seq, m_values, [value](T v) { return v >= value; });
+    }
+
+    /* Resizes the window and fills it with initialValue */
+    void reset(size_t windowSize, T initialValue = T{}) {
+        m_values.assign(std::max(windowSize, size_t{ 1U }), initialValue);
+        m_numPushed = size();
+
+        // Every value is the same, so the newest one is the only candidate for both extremes
+        m_maxQueue.reset(size(), m_numPushed - 1);
+        m_minQueue.reset(size(), m_numPushed - 1);
+    }
+
+    T max() const { return valueAt(m_maxQueue.front()); }
+    T min() const { return valueAt(m_minQueue.front()); }
+
+    /* Indexes the window from the oldest value (0) to the newest (size() - 1) */
+    T operator[](size_t i) const { return valueAt(m_numPushed - size() + i); }
+
+    T front() const { return (*this)[0]; }
+    T back() const { return valueAt(m_numPushed - 1); }
+    size_t size() const { return m_values.size(); }
+
+private:
+    /* Fixed capacity deque of push sequence numbers whose values are kept in monotonic order */
+    class MonotonicQueue {
+    public:
+        void reset(size_t capacity, uint64_t seq) {
+            m_seqs.assign(capacity, 0);
+            m_seqs[0] = seq;
+            m_head = 0;
+            m_count = 1;
+        }
+
+        uint64_t front() const { return m_seqs[m_head]; }
+
+        /* Drops sequence numbers that have slid out of the window */
+        void popExpired(uint64_t oldestSeq) {
+            while (m_count > 0 && m_seqs[m_head] < oldestSeq) {
+                m_head = (m_head + 1) % m_seqs.size();
+                --m_count;
+            }
+        }
+
+        /* Drops every candidate from the back that the new value dominates, then appends the new value */
+        template<typename Dominated>
+        void push(uint64_t seq, const std::vector<T>& values, Dominated dominated) {
+            while (m_count > 0 && dominated(values[backSeq() % values.size()]))
+                --m_count;
+
+            m_seqs[(m_head + m_count) % m_seqs.size()] = seq;
+            ++m_count;
+        }
+
+    private:
+        uint64_t backSeq() const { return m_seqs[(m_head + m_count - 1) % m_seqs.size()]; }
+
+        std::vector<uint64_t> m_seqs;
+        size_t m_head{ 0 };
+        size_t m_count{ 0 };
+    };
+
+    T valueAt(uint64_t seq) const { return m_values[seq % size()]; }
+
+    std::vector<T> m_values;
+    uint64_t m_numPushed{ 0 };
+    MonotonicQueue m_maxQueue;
+    MonotonicQueue m_minQueue;
+};
+
+/* Sliding window used to pick the scale of a graph. The scale grows immediately when a new value exceeds it, but only
+ * shrinks back to the window maximum once that maximum has fallen below the scale by more than the hysteresis
+ * fraction. This stops the graph rescaling (and re-uploading all of its points) every time a peak leaves the window.
+ * The scale never goes lower than lowerBound.
+ */
+export template<typename T>
+class AutoScaleWindow {
+public:
+    AutoScaleWindow(size_t windowSize, T lowerBound, float hysteresis = 0.0f)
+        : m_window{ windowSize }
+        , m_lowerBound{ lowerBound }
+        , m_hysteresis{ std::clamp(hysteresis, 0.0f, 1.0f) }
+        , m_scale{ lowerBound } {}
+
+    /* Pushes a new value into the window. Returns true if the scale changed */
+    bool push(T value) {
+        m_window.push(value);
+        return updateScale();
+    }
+
+    /* Empties the window and drops the scale back to the lower bound */
+    void reset(size_t windowSize) {
+        m_window.reset(windowSize);
+        m_scale = m_lowerBound;
+    }
+
+    /* Changes the scale settings. Returns true if the scale changed */
+    bool setBounds(T lowerBound, float hysteresis) {
+        m_lowerBound = lowerBound;
+        m_hysteresis = std::clamp(hysteresis, 0.0f, 1.0f);
+        return updateScale();
+    }
+
+    T scale() const { return m_scale; }
+    const SlidingWindow<T>& window() const { return m_window; }
+
+private:
+    bool updateScale() {
+        const T target{ std::max(m_window.max(), m_lowerBound) };
+        const auto shrinkThreshold{ static_cast<double>(m_scale) * (1.0 - m_hysteresis) };
+
+        if (target > m_scale || static_cast<double>(target) < shrinkThreshold) {
+            m_scale = target;
+            return true;
+        }
+        return false;
+    }
+
+    SlidingWindow<T> m_window;
+    T m_lowerBound;
+    float m_hysteresis;
+    T m_scale;
+};
+
+} // namespace rg
@@ -0,0 +1,74 @@
+module RG.Core:WaitTimer;
+
+import "WindowsHeaderUnit.h";
+
+#pragma comment(lib, "Winmm.lib")
+
+namespace rg {
+
+// Waitable timer due times are in 100ns intervals
+using TimerTicks = duration<int64_t, std::ratio<1, 10'000'000>>;
+
+Win32WaitTimer::Win32WaitTimer()
+    : m_timer{ CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS) }
+    , m_highResolution{ m_timer != nullptr } {
+    if (!m_timer) {
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        timeBeginPeriod(1);
+    }
+
+    // If no timer could be made, the timer is invalid and createWaitTimer falls back to SleepWaitTimer
+}
+
+Win32WaitTimer::~Win32WaitTimer() {
+    if (!m_highResolution)
+        timeEndPeriod(1);
+    if (m_timer)
+        CloseHandle(m_timer);
+}
+
+bool Win32WaitTimer::waitUntil(steady_clock::time_point deadline, bool wakeOnMessages) {
+    // Waitable timers run off the interrupt clock rather than the performance counter behind steady_clock, so they
+    // can fire slightly early. Whatever is left is waited for again
+    for (auto now{ steady_clock::now() }; now < deadline; now = steady_clock::now()) {
+        // Negative due times are relative to now
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -std::max(duration_cast<TimerTicks>(deadline - now).count(), int64_t{ 1 });
+        SetWaitableTimer(m_timer, &dueTime, 0, nullptr, nullptr, FALSE);
+
+        if (!wakeOnMessages) {
+            WaitForSingleObject(m_timer, INFINITE);
+        } else if (MsgWaitForMultipleObjectsEx(1, &m_timer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE) !=
+                   WAIT_OBJECT_0) {
+            CancelWaitableTimer(m_timer);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SleepWaitTimer::waitUntil(steady_clock::time_point deadline, bool wakeOnMessages) {
+    if (wakeOnMessages) {
+        // Message waits only take whole milliseconds, so the rest is slept off
+        const auto timeout{ duration_cast<milliseconds>(deadline - steady_clock::now()) };
+        if (timeout > 0ms && MsgWaitForMultipleObjectsEx(0, nullptr, static_cast<DWORD>(timeout.count()), QS_ALLINPUT,
+                                                         MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0)
+            return false;
+    }
+
+    while (steady_clock::now() < deadline)
+        std::this_thread::sleep_until(deadline);
+
+    return true;
+}
+
+std::unique_ptr<IWaitTimer> createWaitTimer() {
+    auto timer{ std::make_unique<Win32WaitTimer>() };
+    if (timer->isValid())
+        return timer;
+
+    return std::make_unique<SleepWaitTimer>();
+}
+
+} // namespace rg
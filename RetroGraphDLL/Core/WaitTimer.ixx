@@ -0,0 +1,53 @@
+export module RG.Core:WaitTimer;
+
+import std.core;
+
+import "WindowsHeaderUnit.h";
+
+namespace rg {
+
+using namespace std::chrono;
+
+/* Blocks the calling thread until a deadline on the steady clock */
+export class IWaitTimer {
+public:
+    virtual ~IWaitTimer() = default;
+
+    /* Waits until deadline, which may already have passed. If wakeOnMessages is set, a window message arriving for
+     * the calling thread ends the wait early. Returns true if the deadline was reached, never before the deadline */
+    virtual bool waitUntil(steady_clock::time_point deadline, bool wakeOnMessages) = 0;
+};
+
+/* Waits with a high resolution waitable timer, so the thread sleeps right up to the deadline without spinning.
+ * Falls back to a regular waitable timer with a raised system timer resolution where high resolution timers
+ * aren't supported (before Windows 10 1803)
+ */
+export class Win32WaitTimer : public IWaitTimer {
+public:
+    Win32WaitTimer();
+    ~Win32WaitTimer() override;
+    Win32WaitTimer(const Win32WaitTimer&) = delete;
+    Win32WaitTimer& operator=(const Win32WaitTimer&) = delete;
+    Win32WaitTimer(Win32WaitTimer&&) = delete;
+    Win32WaitTimer& operator=(Win32WaitTimer&&) = delete;
+
+    bool waitUntil(steady_clock::time_point deadline, bool wakeOnMessages) override;
+
+    bool isValid() const { return m_timer != nullptr; }
+    bool isHighResolution() const { return m_highResolution; }
+
+private:
+    HANDLE m_timer;
+    bool m_highResolution;
+};
+
+/* Waits with std::this_thread::sleep_until, at the resolution of the system timer */
+export class SleepWaitTimer : public IWaitTimer {
+public:
+    bool waitUntil(steady_clock::time_point deadline, bool wakeOnMessages) override;
+};
+
+/* Creates the most precise wait timer available */
+export std::unique_ptr<IWaitTimer> createWaitTimer();
+
+} // namespace rg
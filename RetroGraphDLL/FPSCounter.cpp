@@ -1,51 +1,77 @@
 module FPSCounter;
 
-import "WindowsHeaderUnit.h";
-
 namespace rg {
 
+using namespace std::chrono;
+
+void FPSCounter::RollingMean::push(steady_clock::duration value) {
+    m_sum += value - m_values[m_next];
+    m_values[m_next] = value;
+    m_next = (m_next + 1) % numFrameTimeSamples;
+    m_count = std::min(m_count + 1, numFrameTimeSamples);
+}
+
+steady_clock::duration FPSCounter::RollingMean::get() const {
+    return m_count == 0 ? steady_clock::duration{ 0 } : m_sum / static_cast<int64_t>(m_count);
+}
+
 FPSCounter::FPSCounter()
     : m_fps{ 0 }
-    , m_frameTime{ 0.0 }
-    , m_startTicks{ 0 }
-    , m_freq{ 0 }
-    , m_frameTimeHistory{ 0.0f }
-    , m_currFrameIdx{ 0 } {
-    QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&m_freq));
-}
+    , m_frameStart{ steady_clock::now() }
+    , m_frameIntervals{}
+    , m_frameTimes{}
+    , m_currentPhaseTimes{}
+    , m_phaseTimes{}
+    , m_windowTime{ 0 }
+    , m_windowFrameTimes{}
+    , m_lastWindowFrameTimes{} {}
 
 void FPSCounter::startFrame() {
-    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&m_startTicks));
+    const auto now{ steady_clock::now() };
+    recordFrameInterval(now - m_frameStart);
+    m_frameStart = now;
 }
 
 void FPSCounter::endFrame() {
-    calculateFPS();
+    recordFrame(steady_clock::now() - m_frameStart);
 }
 
-void FPSCounter::calculateFPS() {
-    int64_t endTicks;
-    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&endTicks));
+void FPSCounter::recordFrameInterval(steady_clock::duration interval) {
+    m_frameIntervals.push(interval);
+    const auto meanInterval{ duration<float>{ m_frameIntervals.get() }.count() };
+    m_fps = meanInterval > 0.0f ? 1.0f / meanInterval : 0.0f;
 
-    m_frameTime = static_cast<float>(endTicks - m_startTicks) / m_freq;
-    m_frameTimeHistory[m_currFrameIdx % numFrameTimeSamples] = m_frameTime;
+    // Windows are measured in real time, which frame times don't add up to while the limiter is waiting
+    m_windowTime += interval;
+}
 
-    int count{ numFrameTimeSamples };
-    ++m_currFrameIdx;
-    if (m_currFrameIdx < numFrameTimeSamples) {
-        count = m_currFrameIdx;
-    }
+void FPSCounter::recordFrame(steady_clock::duration frameTime) {
+    m_frameTimes.push(frameTime);
 
-    float frameTimeAverage{ 0.0f };
-    for (int i = 0; i < count; ++i) {
-        frameTimeAverage += m_frameTimeHistory[i];
+    for (size_t i{ 0 }; i < numPhases; ++i) {
+        m_phaseTimes[i].push(m_currentPhaseTimes[i]);
+        m_currentPhaseTimes[i] = steady_clock::duration{ 0 };
     }
-    frameTimeAverage /= count;
 
-    if (frameTimeAverage > 0) {
-        m_fps = 1.0f / frameTimeAverage;
-    } else {
-        m_fps = 0.0f;
+    // Percentiles are reported per window rather than over the whole run, so they show how the app is doing now
+    m_windowFrameTimes.record(duration_cast<microseconds>(frameTime));
+    if (m_windowTime >= percentileWindow) {
+        m_lastWindowFrameTimes = m_windowFrameTimes;
+        m_windowFrameTimes.clear();
+        m_windowTime = steady_clock::duration{ 0 };
     }
 }
 
+microseconds FPSCounter::getMeanFrameInterval() const {
+    return duration_cast<microseconds>(m_frameIntervals.get());
+}
+
+microseconds FPSCounter::getMeanFrameTime() const {
+    return duration_cast<microseconds>(m_frameTimes.get());
+}
+
+microseconds FPSCounter::getMeanPhaseTime(FramePhase phase) const {
+    return duration_cast<microseconds>(m_phaseTimes[static_cast<size_t>(phase)].get());
+}
+
 } // namespace rg
@@ -1,11 +1,30 @@
 export module FPSCounter;
 
+import RG.Core;
+
 import std.core;
 
 namespace rg {
 
+// Parts of a frame that are timed separately, to tell whether slow frames come from measures or rendering
+export enum class FramePhase {
+    Update, // Updating measures
+    Draw, // Drawing widgets and composing the frame
+    Present, // Swapping buffers
+    NumPhases
+};
+
+/* Tracks frame times. The frame rate comes from a rolling mean of the intervals between frame starts, which include
+ * waiting for the next frame. Frame times only cover the frame's work, up to endFrame. A rolling mean of them, their
+ * percentiles over a longer window to show stutter, and a rolling mean of each phase of the frame are kept
+ */
 export class FPSCounter {
 public:
+    static constexpr size_t numFrameTimeSamples{ 15 };
+
+    // How long frame time percentiles are collected for before they're reported
+    static constexpr std::chrono::seconds percentileWindow{ 5 };
+
     FPSCounter();
     ~FPSCounter() noexcept = default;
     FPSCounter(const FPSCounter&) = delete;
@@ -13,28 +32,59 @@ public:
     FPSCounter(FPSCounter&&) = delete;
     FPSCounter& operator=(FPSCounter&&) = delete;
 
-    /* Call at the beginning of the frame */
+    /* Call at the beginning of the frame. Records the interval since the previous frame started */
     __declspec(dllexport) void startFrame();
 
-    /* Called at the end of the frame to calculate frame time */
+    /* Call once the frame's work is done, before waiting for the next frame, to record the frame time */
     __declspec(dllexport) void endFrame();
 
+    /* Records the time between the starts of two frames. Called by startFrame */
+    void recordFrameInterval(std::chrono::steady_clock::duration interval);
+
+    /* Records a frame whose work took frameTime. Called by endFrame with the measured frame time */
+    void recordFrame(std::chrono::steady_clock::duration frameTime);
+
+    /* Adds to the time spent in a phase of the current frame */
+    void addPhaseTime(FramePhase phase, std::chrono::steady_clock::duration time) {
+        m_currentPhaseTimes[static_cast<size_t>(phase)] += time;
+    }
+
     float getFPS() const { return m_fps; }
+    std::chrono::microseconds getMeanFrameInterval() const;
+    std::chrono::microseconds getMeanFrameTime() const;
+    std::chrono::microseconds getMeanPhaseTime(FramePhase phase) const;
+
+    /* Frame times over the last complete percentile window. Empty until the first window completes */
+    const DurationHistogram& getFrameTimeHistogram() const { return m_lastWindowFrameTimes; }
 
 private:
-    /* Calculates the framerate using multiple previous frame times to smooth
-     * the value
-     */
-    void calculateFPS();
+    /* Mean of the last numFrameTimeSamples values. Kept as a running sum of integer durations, so adding a value is
+     * O(1) and the sum never drifts */
+    class RollingMean {
+    public:
+        void push(std::chrono::steady_clock::duration value);
+        std::chrono::steady_clock::duration get() const;
+
+    private:
+        std::array<std::chrono::steady_clock::duration, numFrameTimeSamples> m_values{};
+        std::chrono::steady_clock::duration m_sum{ 0 };
+        size_t m_next{ 0 };
+        size_t m_count{ 0 };
+    };
+
+    static constexpr size_t numPhases{ static_cast<size_t>(FramePhase::NumPhases) };
 
     float m_fps;
-    float m_frameTime;
-    int64_t m_startTicks;
-    int64_t m_freq;
+    std::chrono::steady_clock::time_point m_frameStart;
+    RollingMean m_frameIntervals;
+    RollingMean m_frameTimes;
+
+    std::array<std::chrono::steady_clock::duration, numPhases> m_currentPhaseTimes;
+    std::array<RollingMean, numPhases> m_phaseTimes;
 
-    static constexpr int numFrameTimeSamples{ 15 };
-    std::array<float, numFrameTimeSamples> m_frameTimeHistory;
-    int m_currFrameIdx;
+    std::chrono::steady_clock::duration m_windowTime;
+    DurationHistogram m_windowFrameTimes;
+    DurationHistogram m_lastWindowFrameTimes;
 };
 
 } // namespace rg
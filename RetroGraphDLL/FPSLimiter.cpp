@@ -6,14 +6,23 @@ namespace rg {
 
 using namespace std::chrono;
 
-constexpr microseconds fpsToFrameTime(int fps) {
-    return duration_cast<microseconds>(duration<double>{ 1 } / fps);
+// How often to check whether the window can be seen again while suspended. Unlocking the session sends a message,
+// which ends the wait sooner
+constexpr milliseconds suspendedPollInterval{ 250 };
+
+// Waits longer than this are ended early by window messages, so input is handled at once
+constexpr milliseconds interruptibleWaitThreshold{ 50 };
+
+FrameRateLimits getFrameRateLimitsFromSettings() {
+    auto& settings{ UserSettings::inst() };
+    return { .minFPS = settings.getVal<int>("Application.MinFPS"), .maxFPS = settings.getVal<int>("Application.FPS") };
 }
 
 FPSLimiter::FPSLimiter()
-    : m_frameTime{ fpsToFrameTime(UserSettings::inst().getVal<int>("Application.FPS")) }
-    , m_currentFrameStart{ system_clock::now() }
-    , m_currentFrameEnd{ m_currentFrameStart + m_frameTime }
+    : m_governor{ getFrameRateLimitsFromSettings() }
+    , m_waitTimer{ createWaitTimer() }
+    , m_currentFrameStart{ steady_clock::now() }
+    , m_currentFrameEnd{ m_currentFrameStart }
     , m_configRefreshedHandle{ RegisterConfigRefreshedCallback() } {}
 
 FPSLimiter::~FPSLimiter() {
@@ -21,26 +30,40 @@ FPSLimiter::~FPSLimiter() {
 }
 
 void FPSLimiter::startFrame() {
-    const auto now = system_clock::now();
+    const auto now = steady_clock::now();
     // std::cerr << "This frame: " << round<milliseconds>(now - m_currentFrameStart) << '\n';
     m_currentFrameStart = now;
 }
 
-void FPSLimiter::endFrame() {
-    const auto now = system_clock::now();
+void FPSLimiter::endFrame(const FrameRateInputs& inputs) {
+    const auto now = steady_clock::now();
+
+    // Frames are scheduled from when the last frame was due rather than when it actually started, so oversleeping
+    // doesn't lower the frame rate
+    auto nextFrame{ m_governor.getNextFrameTime(m_currentFrameEnd, inputs) };
 
-    sleepUntil(m_currentFrameEnd);
+    if (!nextFrame) {
+        m_waitTimer->waitUntil(now + suspendedPollInterval, true);
+        m_currentFrameEnd = steady_clock::now();
+        return;
+    }
 
     // Handle large jumps in time (e.g. pausing the debugger or putting computer to sleep)
-    if (m_currentFrameEnd < now)
-        m_currentFrameEnd = now;
+    if (*nextFrame < now)
+        nextFrame = m_governor.getNextFrameTime(now, inputs);
 
-    m_currentFrameEnd += m_frameTime;
+    if (m_waitTimer->waitUntil(*nextFrame, *nextFrame - now > interruptibleWaitThreshold)) {
+        m_wakeLateness.record(duration_cast<microseconds>(steady_clock::now() - *nextFrame));
+        m_currentFrameEnd = *nextFrame;
+    } else {
+        // Woken by a message, so the next frame starts now to handle it
+        m_currentFrameEnd = steady_clock::now();
+    }
 }
 
 ConfigRefreshedEvent::Handle FPSLimiter::RegisterConfigRefreshedCallback() {
     return UserSettings::inst().configRefreshed.attach(
-        [this]() { m_frameTime = fpsToFrameTime(UserSettings::inst().getVal<int>("Application.FPS")); });
+        [this]() { m_governor.setLimits(getFrameRateLimitsFromSettings()); });
 }
 
 } // namespace rg
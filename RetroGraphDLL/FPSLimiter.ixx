@@ -1,25 +1,41 @@
 export module FPSLimiter;
 
+import RG.Core;
 import RG.UserSettings;
 
 import std.core;
 
 namespace rg {
 
+/* Sleeps between frames so the window runs at the rate chosen by a FrameRateGovernor.
+ * Application.FPS is the maximum rate and Application.MinFPS the minimum rate while idle
+ */
 export class FPSLimiter {
 public:
     __declspec(dllexport) FPSLimiter();
     __declspec(dllexport) ~FPSLimiter();
 
     __declspec(dllexport) void startFrame();
-    __declspec(dllexport) void endFrame();
+
+    /* Sleeps until the next frame should start. Window messages end the sleep early so input is handled at once */
+    __declspec(dllexport) void endFrame(const FrameRateInputs& inputs);
+
+    void notifyUserInput() { m_governor.notifyUserInput(std::chrono::steady_clock::now()); }
+
+    FrameRateMode getMode() const { return m_governor.getMode(); }
+    double getTargetFPS() const { return m_governor.getTargetFPS(); }
+
+    /* How long after the scheduled frame time the limiter woke up, for every frame that wasn't woken by a message */
+    const DurationHistogram& getWakeLateness() const { return m_wakeLateness; }
 
 private:
     ConfigRefreshedEvent::Handle RegisterConfigRefreshedCallback();
 
-    std::chrono::microseconds m_frameTime;
-    std::chrono::system_clock::time_point m_currentFrameStart;
-    std::chrono::system_clock::time_point m_currentFrameEnd;
+    FrameRateGovernor m_governor;
+    std::unique_ptr<IWaitTimer> m_waitTimer;
+    DurationHistogram m_wakeLateness;
+    std::chrono::steady_clock::time_point m_currentFrameStart;
+    std::chrono::steady_clock::time_point m_currentFrameEnd;
     ConfigRefreshedEvent::Handle m_configRefreshedHandle;
 };
 
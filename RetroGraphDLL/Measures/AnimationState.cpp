@@ -5,95 +5,98 @@ import RG.Rendering;
 
 namespace rg {
 
-AnimationState::AnimationState()
+AnimationState::AnimationState(const AnimationSettings& settings)
     : Measure{ milliseconds{ 0 } }
-    , m_particles(createParticles())
-    , m_particleLines{}
-    , m_numLines{ 0 } {
-    for (const auto& p : m_particles)
-        m_cells[p.cellX][p.cellY].push_back(&p);
+    , m_particles{}
+    , m_simdLevel{ getSupportedSimdLevel() }
+    , m_rng{}
+    , m_seed{}
+    , m_timeSinceStep{ 0.0f }
+    , m_drawnPositions{}
+    , m_output{ nullptr }
+    , m_numLines{ 0 }
+    , m_expectedNumLines{ 0 }
+    , m_grid{}
+    , m_tuner{}
+    , m_jobs{} {
+    setSettings(settings);
 }
 
-auto AnimationState::createParticles() -> decltype(m_particles) {
-    std::srand(static_cast<unsigned int>(_time64(nullptr)));
-    return decltype(m_particles)(numParticles);
-}
+void AnimationState::setSettings(const AnimationSettings& settings) {
+    m_grid = ParticleGrid{ settings.connectionDistance, settings.gridCellsPerSide };
 
-bool AnimationState::updateInternal() {
-    using namespace std::chrono;
-    using clock = high_resolution_clock;
+    const auto numThreads{ settings.numThreads == 0 ? JobSystem::getDefaultNumThreads() : settings.numThreads };
+    if (!m_jobs || m_jobs->getNumThreads() != numThreads)
+        m_jobs = std::make_unique<JobSystem>(numThreads);
 
-    const auto deltaTimeStep{ since<clock, clock::duration, microseconds>(m_lastUpdateTime) };
-    auto dt{ duration_cast<duration<float>>(deltaTimeStep).count() };
+    if (m_seed != settings.seed) {
+        m_seed = settings.seed;
+        m_rng.reseed(settings.seed == 0 ? std::random_device{}() : settings.seed);
+        m_particles = Particles{};
+        m_timeSinceStep = std::chrono::duration<float>{ 0.0f };
+    }
 
-    // If a lot of time has passed, set dt to a small value so we don't have one large jump
-    if (dt > 1.0f)
-        dt = 0.016f;
+    const auto numParticles{ std::clamp(settings.numParticles, size_t{ 1U }, maxParticles) };
+    if (settings.autoTune)
+        m_tuner.emplace(settings.autoTuneBudget, numParticles, size_t{ 1U }, maxParticles);
+    else
+        m_tuner.reset();
 
-    for (auto& p : m_particles)
-        p.update(m_cells, dt);
+    setNumParticles(numParticles);
+}
 
-    updateParticleLines();
+void AnimationState::setOutput(ParticleOutput* output) {
+    m_output = output;
+    if (!m_output)
+        return;
 
-    return true;
+    m_particles.writeVertices(0, m_particles.count(), m_output->beginParticles(m_particles.count()));
+    m_output->endParticles();
 }
 
-void AnimationState::updateParticleLines() {
-    m_numLines = 0;
-
-    // draw lines to particles in neighbouring cells (but not the current cell)
-    for (const auto& p : m_particles) {
-        auto nextX = int{ p.cellX + 1 };
-        auto nextY = int{ p.cellY + 1 };
-        auto prevY = int{ static_cast<int>(p.cellY) - 1 }; // can be negative
-        if (nextX >= numCellsPerSide)
-            nextX = 0;
-        if (nextY >= numCellsPerSide)
-            nextY = 0;
-        if (prevY < 0)
-            prevY = numCellsPerSide - 1;
-
-        // We check four neighbouring cells since some collisions may
-        // occur across cell boundaries
-        const std::array<const CellParticleList*, 4> neighbouringCells = {
-            &(m_cells[p.cellX][nextY]),
-            &(m_cells[nextX][p.cellY]),
-            &(m_cells[nextX][prevY]),
-            &(m_cells[nextX][nextY]),
-        };
-
-        for (const auto* cell : neighbouringCells) {
-            for (const auto neighbour : *cell)
-                addLine(&p, neighbour);
-        }
-    }
+void AnimationState::setNumParticles(size_t numParticles) {
+    m_particles.resize(numParticles, m_rng);
+
+    // Leave some room above the estimate, as particles bunch up
+    const auto expectedLines{ m_grid.estimateNumClosePairs(numParticles) };
+    m_expectedNumLines = expectedLines + expectedLines / 2;
+}
 
-    // Handle the current cell particle lines here such that we only
-    // test each pair once
-    for (const auto& row : m_cells) {
-        for (const auto& cell : row) {
-            const auto cellParticles{ cell.size() };
-            for (auto i = size_t{ 0U }; i < cellParticles; ++i) {
-                // j starts at i+1 so we don't duplicate collision checks.
-                for (auto j = size_t{ i + 1 }; j < cellParticles; ++j)
-                    addLine(cell[i], cell[j]);
-            }
-        }
+bool AnimationState::updateInternal() {
+    const ProfileZone zone{ "AnimationState::updateInternal" };
+
+    using namespace std::chrono;
+    using clock = steady_clock;
+
+    const auto elapsed{ since<clock, clock::duration, microseconds>(m_lastUpdateTime) };
+    const auto updateTime{ recordTimeToExecute([this, elapsed]() { advance(elapsed); }) };
+
+    if (m_tuner) {
+        const auto numParticles{ m_tuner->addUpdateTime(duration_cast<microseconds>(updateTime)) };
+        if (numParticles != m_particles.count())
+            setNumParticles(numParticles);
     }
+
+    return true;
 }
 
-void AnimationState::addLine(const Particle* const p1, const Particle* const p2) {
-    if (p1 == p2)
+void AnimationState::advance(std::chrono::duration<float> elapsed) {
+    m_timeSinceStep = std::min(m_timeSinceStep + elapsed, maxTimePerUpdate);
+    while (m_timeSinceStep >= fixedTimestep) {
+        m_particles.update(fixedTimestep.count(), m_simdLevel, *m_jobs);
+        m_timeSinceStep -= fixedTimestep;
+    }
+
+    if (!m_output)
         return;
 
-    constexpr auto radiusSq{ particleConnectionDistance * particleConnectionDistance };
-    const auto dx{ fabs(p1->x - p2->x) };
-    const auto dy{ fabs(p1->y - p2->y) };
-    const auto distance{ dx * dx + dy * dy };
+    // The particles and lines are written to the output as they're produced, rather than copied there afterwards
+    const auto alpha{ m_timeSinceStep / fixedTimestep };
+    m_particles.interpolate(alpha, m_drawnPositions, *m_jobs, m_output->beginParticles(m_particles.count()));
+    m_output->endParticles();
 
-    if (distance < radiusSq) {
-        m_particleLines[m_numLines++] = ParticleLine{ p1->x, p1->y, p2->x, p2->y };
-    }
+    m_grid.build(m_drawnPositions.x, m_drawnPositions.y);
+    m_numLines = m_grid.findClosePairs(*m_jobs, *m_output, std::max(m_numLines, m_expectedNumLines));
 }
 
 } // namespace rg
@@ -2,46 +2,100 @@ export module RG.Measures:AnimationState;
 
 import :Measure;
 import :Particle;
+import :ParticleCountTuner;
+import :ParticleGrid;
 import :ParticleLine;
+import :ParticleOutput;
+
+import RG.Core;
 
 import std.core;
 
 namespace rg {
 
-constexpr size_t numParticles{ 100U };
-export constexpr size_t maxLines{ numParticles * numParticles };
+export struct AnimationSettings {
+    size_t numParticles{ 100U };
+    float connectionDistance{ ParticleGrid::defaultConnectionDistance };
+    int gridCellsPerSide{ ParticleGrid::defaultCellsPerSide };
+
+    // Picks the largest particle count whose updates fit in the budget instead of using numParticles
+    bool autoTune{ false };
+    std::chrono::microseconds autoTuneBudget{ 2000 };
 
+    // Threads to update particles on. 0 uses one per CPU core
+    size_t numThreads{ 0 };
+
+    // Particles start the same for the same seed. 0 picks a different seed every time
+    uint64_t seed{ 0 };
+};
+
+/* Particles moving around the world, and lines between the ones close together.
+ * The particles move in fixed steps, so the same seed and particle count give the same particles whatever the frame
+ * rate. Between steps they're drawn part way between their last two positions.
+ */
 export class AnimationState : public Measure {
 public:
-    AnimationState();
+    static constexpr size_t maxParticles{ 50'000U };
+    static constexpr std::chrono::duration<float> fixedTimestep{ 1.0f / 60.0f };
+
+    // After a long pause (e.g. the computer sleeping), the particles carry on rather than catching up on every step
+    static constexpr std::chrono::duration<float> maxTimePerUpdate{ 0.25f };
+
+    explicit AnimationState(const AnimationSettings& settings);
     ~AnimationState() = default;
 
-    const std::array<ParticleLine, maxLines>& getLines() const { return m_particleLines; }
-    const std::vector<Particle>& getParticles() const { return m_particles; }
-    int getNumLines() const { return m_numLines; }
+    /* Applies new settings. Changing the particle count keeps the existing particles where possible, and changing the
+     * seed starts them again
+     */
+    void setSettings(const AnimationSettings& settings);
+
+    /* Moves the particles on by elapsed time, taking as many fixed steps as fit, and writes them to the output.
+     * Updates call this with the time since the last update
+     */
+    void advance(std::chrono::duration<float> elapsed);
+
+    /* Sets where each update writes the particles and lines to draw, or nullptr to only move the particles.
+     * The current particles are written to it straight away, and lines from the next update on
+     */
+    void setOutput(ParticleOutput* output);
+
+    const Particles& getParticles() const { return m_particles; }
+
+    /* How many lines there are likely to be, with some room to spare */
+    size_t getExpectedNumLines() const { return m_expectedNumLines; }
 
 protected:
     /* Updates the positions of all particles */
     bool updateInternal() override;
 
 private:
-    void updateParticleLines();
-    void addLine(const Particle* const p1, const Particle* const p2);
+    void setNumParticles(size_t numParticles);
 
-    std::vector<Particle> m_particles{};
-    auto createParticles() -> decltype(m_particles);
+    Particles m_particles;
+    SimdLevel m_simdLevel;
+    Pcg32 m_rng;
+    std::optional<uint64_t> m_seed;
 
-    // Static buffer set to the maximum possible number of lines existing in worst case
-    // scenario (all particles are in neighbouring cells)
-    std::array<ParticleLine, maxLines> m_particleLines;
-    int m_numLines; // Tracks actual number of lines
+    // Time not yet simulated, always less than one step after advancing
+    std::chrono::duration<float> m_timeSinceStep;
+    ParticlePositions m_drawnPositions;
+
+    // Not owned. Lines are written straight to it rather than kept here
+    ParticleOutput* m_output;
+    size_t m_numLines;
+
+    // Estimated from the number of lines evenly spread particles would have
+    size_t m_expectedNumLines;
 
     // Members for spatial partitioning
     // The world space coordinates range from -1.0 to 1.0 for both x and y,
     // so we have a range of 2.0 for our world sides
-    Cells m_cells;
+    ParticleGrid m_grid;
+
+    std::optional<ParticleCountTuner> m_tuner;
 
-    friend struct Particle;
+    // Only recreated when the number of threads changes
+    std::unique_ptr<JobSystem> m_jobs;
 };
 
 } // namespace rg
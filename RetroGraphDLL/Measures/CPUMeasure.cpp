@@ -1,5 +1,7 @@
 module RG.Measures:CPUMeasure;
 
+import RG.Core;
+
 import "RGAssert.h";
 
 namespace rg {
@@ -9,13 +11,17 @@ CPUMeasure::CPUMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr
     , m_cpuDataSource{ std::move(cpuDataSource) } {}
 
 bool CPUMeasure::updateInternal() {
+    const ProfileZone zone{ "CPUMeasure::updateInternal" };
+
     m_cpuDataSource->update();
 
     for (int i{ 0 }; i < m_cpuDataSource->getNumCores(); ++i) {
         onCPUCoreUsage.raise(i, m_cpuDataSource->getCoreUsage(i));
     }
 
-    onCPUUsage.raise(m_cpuDataSource->getCPUUsage());
+    const auto usage{ m_cpuDataSource->getCPUUsage() };
+    onCPUUsage.raise(usage);
+    addAdaptiveSample(usage);
     return true;
 }
 
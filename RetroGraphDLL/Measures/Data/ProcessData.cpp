@@ -6,10 +6,11 @@ import "WindowsHeaderUnit.h";
 
 namespace rg {
 
-ProcessData::ProcessData(HANDLE pHandle, DWORD pID, const char* name)
+ProcessData::ProcessData(HANDLE pHandle, DWORD pID, const char* name, const CPUTimes& systemTimes)
     : m_pHandle{ pHandle }
     , m_processID{ pID }
-    , m_procName{ name } {
+    , m_procName{ name }
+    , m_lastSystemTimes{ systemTimes } {
     // Remove the ".exe" extension from the process name
     const auto p{ m_procName.find(".exe") };
     if (p != std::string::npos) {
@@ -23,9 +24,6 @@ ProcessData::ProcessData(HANDLE pHandle, DWORD pID, const char* name)
         m_procName.append("...");
     }
 
-    FILETIME sysIdle; // Dummy ft, won't be used
-    GetSystemTimes(&sysIdle, &m_lastSystemKernelTime, &m_lastSystemUserTime);
-
     // Get memory information for the process
     updateMemCounters();
 
@@ -38,14 +36,13 @@ ProcessData::~ProcessData() {
     CloseHandle(m_pHandle);
 }
 
-void ProcessData::setTimes(const FILETIME& cTime, const FILETIME& eTime, const FILETIME& kTime, const FILETIME& uTime) {
+void ProcessData::setTimes(const FILETIME& cTime, const FILETIME& eTime, const FILETIME& kTime, const FILETIME& uTime,
+                           const CPUTimes& systemTimes) {
     m_creationTime = cTime;
     m_exitTime = eTime;
     m_kernelTime = kTime;
     m_userTime = uTime;
-
-    FILETIME sysIdle; // dummy
-    GetSystemTimes(&sysIdle, &m_lastSystemKernelTime, &m_lastSystemUserTime);
+    m_lastSystemTimes = systemTimes;
 }
 
 void ProcessData::updateMemCounters() {
@@ -1,6 +1,7 @@
 export module RG.Measures.Data:ProcessData;
 
 import RG.Core;
+import RG.Measures.DataSources;
 
 import std.core;
 
@@ -13,7 +14,8 @@ namespace rg {
 /* Storage class that contains various information about a system process */
 export class ProcessData {
 public:
-    ProcessData(HANDLE pHandle, DWORD pID, const char* name);
+    /* systemTimes are the system's CPU times now, which the process's CPU usage is later measured against */
+    ProcessData(HANDLE pHandle, DWORD pID, const char* name, const CPUTimes& systemTimes);
     ~ProcessData() noexcept;
     ProcessData(const ProcessData&) = delete;
     ProcessData& operator=(const ProcessData&) = delete;
@@ -40,13 +42,8 @@ public:
        in the user mode */
     const FILETIME& getUserTime() const { return m_userTime; }
 
-    /* Returns FILETIME struct containing the total system kernel cpu time at
-       the point this object was last updated */
-    const FILETIME& getLastSystemKernelTime() const { return m_lastSystemKernelTime; }
-
-    /* Returns FILETIME struct containing the total system user cpu time at
-       the point this object was last updated */
-    const FILETIME& getLastSystemUserTime() const { return m_lastSystemUserTime; }
+    /* Returns the total system cpu times at the point this object was last updated */
+    const CPUTimes& getLastSystemTimes() const { return m_lastSystemTimes; }
 
     /* Returns the current memory usage of the process */
     SIZE_T getWorkingSetSizeMB() const { return m_memCounters.WorkingSetSize / MB; }
@@ -55,7 +52,8 @@ public:
        period between the previous and latest update of this object */
     double getCpuUsage() const { return m_cpuUsage; }
 
-    void setTimes(const FILETIME& cTime, const FILETIME& eTime, const FILETIME& kTime, const FILETIME& uTime);
+    void setTimes(const FILETIME& cTime, const FILETIME& eTime, const FILETIME& kTime, const FILETIME& uTime,
+                  const CPUTimes& systemTimes);
 
     void setCpuUsage(double u) { m_cpuUsage = u; }
 
@@ -72,8 +70,7 @@ private:
     FILETIME m_exitTime{};
     FILETIME m_kernelTime{};
     FILETIME m_userTime{};
-    FILETIME m_lastSystemKernelTime{};
-    FILETIME m_lastSystemUserTime{};
+    CPUTimes m_lastSystemTimes{};
 
     double m_cpuUsage{ 0.0 };
 };
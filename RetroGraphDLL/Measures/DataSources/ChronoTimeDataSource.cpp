@@ -4,8 +4,12 @@ import "WindowsHeaderUnit.h";
 
 namespace rg {
 
-TimeData ChronoTimeDataSource::getTimeData() const {
-    return TimeData{ .localTime{ getCurrentLocalTime() }, .uptime{ getCurrentUptime() } };
+void ChronoTimeDataSource::update() {
+    const TimeData timeData{ .localTime{ getCurrentLocalTime() }, .uptime{ getCurrentUptime() } };
+    if (timeData != m_timeData) {
+        m_timeData = timeData;
+        ++m_generation;
+    }
 }
 
 local_time<seconds> ChronoTimeDataSource::getCurrentLocalTime() const {
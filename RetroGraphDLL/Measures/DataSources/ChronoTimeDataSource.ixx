@@ -6,11 +6,16 @@ namespace rg {
 
 export class ChronoTimeDataSource : public ITimeDataSource {
 public:
-    TimeData getTimeData() const override;
+    void update() override;
+    const TimeData& getTimeData() const override { return m_timeData; }
+    uint64_t getGeneration() const override { return m_generation; }
 
 private:
     local_time<seconds> getCurrentLocalTime() const;
     seconds getCurrentUptime() const;
+
+    TimeData m_timeData;
+    uint64_t m_generation{ 0U };
 };
 
 } // namespace rg
@@ -13,6 +13,7 @@ export import :ChronoTimeDataSource;
 export import :CoreTempCPUDataSource;
 export import :FoobarMusicDataSource;
 export import :NvAPIGPUDataSource;
+export import :SystemTimes;
 export import :Win32CPUDataSource;
 export import :Win32DriveDataSource;
 export import :Win32NetDataSource;
@@ -9,25 +9,27 @@ namespace rg {
 
 constexpr const char* foobarWindowClassName{ "{97E27FAA-C0B3-4b8e-A693-ED7881E99FC1}" };
 
-MusicData FoobarMusicDataSource::getMusicData() const {
+void FoobarMusicDataSource::update() {
     // Check if the player window is currently open by matching the class name
     // We must validate existence of window every time before we scrape
     // title information
     const auto playerHandle{ FindWindow(foobarWindowClassName, nullptr) };
-    if (!playerHandle) {
-        m_musicDataCache.isMusicPlayerRunning = false;
-    } else {
-        m_musicDataCache.isMusicPlayerRunning = true;
+    const bool isPlayerRunning{ playerHandle != nullptr };
+    if (m_musicData.isMusicPlayerRunning != isPlayerRunning) {
+        m_musicData.isMusicPlayerRunning = isPlayerRunning;
+        ++m_generation;
+    }
 
-        const auto playerWindowTitle{ getFoobarWindowTitle(playerHandle) };
+    if (!isPlayerRunning)
+        return;
 
-        if (m_playerWindowTitleCache != playerWindowTitle) {
-            m_playerWindowTitleCache = playerWindowTitle;
-            populateDataFromTitle(playerWindowTitle, m_musicDataCache);
-        }
+    // Everything else comes from the title, so the data has only changed if the title has
+    auto playerWindowTitle{ getFoobarWindowTitle(playerHandle) };
+    if (m_playerWindowTitle != playerWindowTitle) {
+        populateDataFromTitle(playerWindowTitle, m_musicData);
+        m_playerWindowTitle = std::move(playerWindowTitle);
+        ++m_generation;
     }
-
-    return m_musicDataCache;
 }
 
 std::string FoobarMusicDataSource::getFoobarWindowTitle(HWND playerHandle) const {
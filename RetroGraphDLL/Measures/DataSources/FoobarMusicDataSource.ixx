@@ -10,7 +10,9 @@ namespace rg {
 
 export class FoobarMusicDataSource : public IMusicDataSource {
 public:
-    MusicData getMusicData() const override;
+    void update() override;
+    const MusicData& getMusicData() const override { return m_musicData; }
+    uint64_t getGeneration() const override { return m_generation; }
 
 private:
     std::string getFoobarWindowTitle(HWND playerHandle) const;
@@ -22,8 +24,9 @@ private:
     // clang-format on
     void populateDataFromTitle(const std::string& playerWindowTitle, MusicData& musicData) const;
 
-    mutable std::string m_playerWindowTitleCache;
-    mutable MusicData m_musicDataCache;
+    std::string m_playerWindowTitle;
+    MusicData m_musicData;
+    uint64_t m_generation{ 0U };
 };
 
 } // namespace rg
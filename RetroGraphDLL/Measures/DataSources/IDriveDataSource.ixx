@@ -30,7 +30,13 @@ export class IDriveDataSource {
 public:
     virtual ~IDriveDataSource() = default;
 
-    virtual DriveData getDriveData() const = 0;
+    /* Reads the drives again */
+    virtual void update() = 0;
+
+    virtual const DriveData& getDriveData() const = 0;
+
+    /* Increases whenever the drive data changes, so users can tell it changed without comparing it */
+    virtual uint64_t getGeneration() const = 0;
 };
 
 } // namespace rg
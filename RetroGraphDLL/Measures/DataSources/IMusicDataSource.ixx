@@ -20,7 +20,13 @@ export class IMusicDataSource {
 public:
     virtual ~IMusicDataSource() = default;
 
-    virtual MusicData getMusicData() const = 0;
+    /* Reads the player's status again */
+    virtual void update() = 0;
+
+    virtual const MusicData& getMusicData() const = 0;
+
+    /* Increases whenever the music data changes, so users can tell it changed without comparing it */
+    virtual uint64_t getGeneration() const = 0;
 };
 
 } // namespace rg
@@ -17,7 +17,13 @@ export class ITimeDataSource {
 public:
     virtual ~ITimeDataSource() = default;
 
-    virtual TimeData getTimeData() const = 0;
+    /* Reads the time again */
+    virtual void update() = 0;
+
+    virtual const TimeData& getTimeData() const = 0;
+
+    /* Increases whenever the time data changes, so users can tell it changed without comparing it */
+    virtual uint64_t getGeneration() const = 0;
 };
 
 } // namespace rg
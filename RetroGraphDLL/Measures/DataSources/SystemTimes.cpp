@@ -0,0 +1,66 @@
+module RG.Measures.DataSources:SystemTimes;
+
+import "WindowsHeaderUnit.h";
+
+#pragma comment(lib, "Ntdll.lib")
+
+namespace rg {
+
+namespace {
+
+uint64_t fileTimeToInt(const FILETIME& ft) {
+    return ((static_cast<unsigned long long>(ft.dwHighDateTime)) << 32) |
+           (static_cast<unsigned long long>(ft.dwLowDateTime));
+}
+
+} // namespace
+
+float getUsage(const CPUTimes& previous, const CPUTimes& current) {
+    const auto totalTicks{ current.total() - previous.total() };
+    const auto idleTicks{ current.idle - previous.idle };
+    if (totalTicks == 0 || idleTicks > totalTicks)
+        return 0.0f;
+
+    return 1.0f - static_cast<float>(idleTicks) / static_cast<float>(totalTicks);
+}
+
+void captureWin32SystemTimes(SystemTimesSnapshot& snapshot) {
+    FILETIME idleTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (GetSystemTimes(&idleTime, &kernelTime, &userTime))
+        snapshot.total = { fileTimeToInt(idleTime), fileTimeToInt(kernelTime), fileTimeToInt(userTime) };
+
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    std::vector<SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> coreTimes(systemInfo.dwNumberOfProcessors);
+
+    ULONG size{ 0U };
+    if (!NT_SUCCESS(NtQuerySystemInformation(SystemProcessorPerformanceInformation, coreTimes.data(),
+                                             static_cast<ULONG>(coreTimes.size() * sizeof(coreTimes[0])), &size)))
+        return;
+
+    snapshot.cores.resize(size / sizeof(coreTimes[0]));
+    for (size_t i{ 0 }; i < snapshot.cores.size(); ++i) {
+        snapshot.cores[i] = { static_cast<uint64_t>(coreTimes[i].IdleTime.QuadPart),
+                              static_cast<uint64_t>(coreTimes[i].KernelTime.QuadPart),
+                              static_cast<uint64_t>(coreTimes[i].UserTime.QuadPart) };
+    }
+}
+
+SystemTimes::SystemTimes(CaptureFunction capture)
+    : m_capture{ std::move(capture) }
+    , m_snapshot{}
+    , m_tick{ 1U }
+    , m_numCaptures{ 0U } {}
+
+const SystemTimesSnapshot& SystemTimes::get() {
+    if (m_snapshot.tick != m_tick) {
+        m_capture(m_snapshot);
+        m_snapshot.tick = m_tick;
+        ++m_numCaptures;
+    }
+    return m_snapshot;
+}
+
+} // namespace rg
@@ -0,0 +1,55 @@
+export module RG.Measures.DataSources:SystemTimes;
+
+import std.core;
+
+namespace rg {
+
+/* CPU time spent since boot, in 100 nanosecond ticks */
+export struct CPUTimes {
+    uint64_t idle{ 0U };
+    uint64_t kernel{ 0U }; // Includes the idle time
+    uint64_t user{ 0U };
+
+    uint64_t total() const { return kernel + user; }
+};
+
+/* Returns the fraction of time the CPU was busy between two readings, from 0 to 1 */
+export float getUsage(const CPUTimes& previous, const CPUTimes& current);
+
+export struct SystemTimesSnapshot {
+    CPUTimes total;
+    std::vector<CPUTimes> cores;
+
+    // The tick the snapshot was taken in
+    uint64_t tick{ 0U };
+};
+
+/* Reads the CPU times of the whole system and of each core from Windows */
+export void captureWin32SystemTimes(SystemTimesSnapshot& snapshot);
+
+/* The system's CPU times, read at most once per tick and shared by everything that needs them.
+ * Measures comparing their own CPU time against the system's all use the same reading, so their percentages agree and
+ * the system isn't asked again for every process
+ */
+export class SystemTimes {
+public:
+    using CaptureFunction = std::function<void(SystemTimesSnapshot&)>;
+
+    explicit SystemTimes(CaptureFunction capture = captureWin32SystemTimes);
+
+    /* Starts a new tick, so the next read gets new times */
+    void nextTick() { ++m_tick; }
+
+    /* Returns the times for this tick, reading them if nothing has this tick yet */
+    const SystemTimesSnapshot& get();
+
+    uint64_t getNumCaptures() const { return m_numCaptures; }
+
+private:
+    CaptureFunction m_capture;
+    SystemTimesSnapshot m_snapshot;
+    uint64_t m_tick;
+    uint64_t m_numCaptures;
+};
+
+} // namespace rg
@@ -9,20 +9,24 @@ import "WindowsHeaderUnit.h";
 
 namespace rg {
 
-static uint64_t fileTimeToInt(const FILETIME& ft) {
-    return ((static_cast<unsigned long long>(ft.dwHighDateTime)) << 32) |
-           (static_cast<unsigned long long>(ft.dwLowDateTime));
-}
-
-Win32CPUDataSource::Win32CPUDataSource()
+Win32CPUDataSource::Win32CPUDataSource(std::shared_ptr<SystemTimes> systemTimes)
     : m_cpuName{ determineCPUName() }
     , m_numCores{ determineNumCores() }
+    , m_cpuUsage{ 0.0f }
     , m_cpuClockSpeed{ determineClockSpeed() }
-    , m_cpuUsage{ getCPUUsage() } {}
+    , m_systemTimes{ std::move(systemTimes) }
+    , m_lastTimes{}
+    , m_lastCoreTimes{}
+    , m_coreUsages(m_numCores, 0.0f) {
+    // Usage is measured from here on
+    const auto& snapshot{ m_systemTimes->get() };
+    m_lastTimes = snapshot.total;
+    m_lastCoreTimes = snapshot.cores;
+}
 
 void Win32CPUDataSource::update() {
     m_cpuClockSpeed = determineClockSpeed();
-    m_cpuUsage = calculateCPUUsage();
+    calculateCPUUsage();
 }
 
 std::string Win32CPUDataSource::determineCPUName() const {
@@ -61,30 +65,16 @@ float Win32CPUDataSource::determineClockSpeed() const {
     return static_cast<float>(processorInformation[0].CurrentMhz);
 }
 
-float Win32CPUDataSource::calculateCPUUsage() const {
-    FILETIME idleTime;
-    FILETIME kernelTime;
-    FILETIME userTime;
-    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
-        return -1.0f;
-    }
-
-    const uint64_t idleTicks{ fileTimeToInt(idleTime) };
-    const uint64_t totalTicks{ fileTimeToInt(kernelTime) + fileTimeToInt(userTime) };
-    static uint64_t prevTotalTicks{ 0U };
-    static uint64_t prevIdleTicks{ 0U };
-
-    const uint64_t totalTicksSinceLastTime{ totalTicks - prevTotalTicks };
-    const uint64_t idleTicksSinceLastTime{ idleTicks - prevIdleTicks };
-
-    const float cpuLoad{ 1.0f - ((totalTicksSinceLastTime > 0)
-                                     ? (static_cast<float>(idleTicksSinceLastTime)) / totalTicksSinceLastTime
-                                     : 0) };
+void Win32CPUDataSource::calculateCPUUsage() {
+    const auto& snapshot{ m_systemTimes->get() };
+    m_cpuUsage = getUsage(m_lastTimes, snapshot.total);
 
-    prevTotalTicks = totalTicks;
-    prevIdleTicks = idleTicks;
+    const auto numCores{ std::min({ m_coreUsages.size(), m_lastCoreTimes.size(), snapshot.cores.size() }) };
+    for (size_t i{ 0 }; i < numCores; ++i)
+        m_coreUsages[i] = getUsage(m_lastCoreTimes[i], snapshot.cores[i]);
 
-    return cpuLoad;
+    m_lastTimes = snapshot.total;
+    m_lastCoreTimes = snapshot.cores;
 }
 
 } // namespace rg
@@ -1,19 +1,22 @@
 export module RG.Measures.DataSources:Win32CPUDataSource;
 
 import :ICPUDataSource;
+import :SystemTimes;
+
+import std.core;
 
 namespace rg {
 
 export class Win32CPUDataSource : public ICPUDataSource {
 public:
-    Win32CPUDataSource();
+    explicit Win32CPUDataSource(std::shared_ptr<SystemTimes> systemTimes);
 
     void update() override;
 
     const std::string& getCPUName() const override { return m_cpuName; }
     float getCPUUsage() const override { return m_cpuUsage; }
     int getNumCores() const override { return m_numCores; };
-    float getCoreUsage(int /*coreIdx*/) const override { return m_cpuUsage; /*TODO*/ }
+    float getCoreUsage(int coreIdx) const override { return m_coreUsages[coreIdx]; }
     float getClockSpeed() const override { return m_cpuClockSpeed; }
     float getVoltage() const override { return 0.0f; /*TODO*/ }
     float getTemp(int /*coreIdx*/) const override { return 0.0f; /*TODO*/ }
@@ -22,12 +25,17 @@ private:
     std::string determineCPUName() const;
     int determineNumCores() const;
     float determineClockSpeed() const; // #TODO this only returns the base clock not the current clock.
-    float calculateCPUUsage() const;
+    void calculateCPUUsage();
 
     std::string m_cpuName;
     int m_numCores;
     float m_cpuUsage;
     float m_cpuClockSpeed;
+
+    std::shared_ptr<SystemTimes> m_systemTimes;
+    CPUTimes m_lastTimes;
+    std::vector<CPUTimes> m_lastCoreTimes;
+    std::vector<float> m_coreUsages;
 };
 
 } // namespace rg
@@ -6,34 +6,46 @@ namespace rg {
 
 constexpr auto maxVolumeNameSize = int{ 64U };
 
-DriveData Win32DriveDataSource::getDriveData() const {
-    DriveData driveData;
+void Win32DriveDataSource::update() {
+    auto& drives{ m_driveData.drives };
+    size_t numDrives{ 0U };
+    bool changed{ false };
 
-    std::vector<std::string> drivePaths;
-
-    // Enumerate all available logical drives and store the drive paths
+    // Enumerate all available logical drives. Drives are only written to when they've changed
     const auto driveMask{ GetLogicalDrives() };
     for (int8_t i{ 0U }; i < 26; ++i) {
-        if ((driveMask & (1 << i))) {
-            char driveName[] = { 'A' + i, ':', '\\', '\0' };
-            drivePaths.emplace_back(driveName);
+        if (!(driveMask & (1 << i)))
+            continue;
+
+        const char drivePath[] = { static_cast<char>('A' + i), ':', '\\', '\0' };
+
+        ULARGE_INTEGER freeBytesAvailable{};
+        ULARGE_INTEGER totalBytes{};
+        ULARGE_INTEGER totalFreeBytes{};
+        GetDiskFreeSpaceEx(drivePath, &freeBytesAvailable, &totalBytes, &totalFreeBytes);
+
+        char volumeNameBuff[maxVolumeNameSize]{};
+        GetVolumeInformation(drivePath, volumeNameBuff, maxVolumeNameSize, nullptr, nullptr, nullptr, nullptr, 0);
+
+        Drive drive{ drivePath[0], totalFreeBytes.QuadPart, totalBytes.QuadPart, volumeNameBuff };
+        if (numDrives == drives.size()) {
+            drives.push_back(std::move(drive));
+            changed = true;
+        } else if (drives[numDrives] != drive) {
+            drives[numDrives] = std::move(drive);
+            changed = true;
         }
+        ++numDrives;
     }
 
-    for (const auto& drivePath : drivePaths) {
-        ULARGE_INTEGER freeBytesAvailable;
-        ULARGE_INTEGER totalBytes;
-        ULARGE_INTEGER totalFreeBytes;
-        GetDiskFreeSpaceEx(drivePath.c_str(), &freeBytesAvailable, &totalBytes, &totalFreeBytes);
-
-        char volumeNameBuff[maxVolumeNameSize];
-        GetVolumeInformation(drivePath.c_str(), volumeNameBuff, maxVolumeNameSize, nullptr, nullptr, nullptr, nullptr,
-                             0);
-
-        driveData.drives.emplace_back(drivePath[0], totalFreeBytes.QuadPart, totalBytes.QuadPart, volumeNameBuff);
+    // Drives that were removed
+    if (numDrives < drives.size()) {
+        drives.erase(drives.begin() + numDrives, drives.end());
+        changed = true;
     }
 
-    return driveData;
+    if (changed)
+        ++m_generation;
 }
 
 } // namespace rg
@@ -2,6 +2,8 @@ export module RG.Measures.DataSources:Win32DriveDataSource;
 
 import :IDriveDataSource;
 
+import std.core;
+
 namespace rg {
 
 export class Win32DriveDataSource : public IDriveDataSource {
@@ -9,7 +11,13 @@ public:
     Win32DriveDataSource() = default;
     ~Win32DriveDataSource() = default;
 
-    DriveData getDriveData() const override;
+    void update() override;
+    const DriveData& getDriveData() const override { return m_driveData; }
+    uint64_t getGeneration() const override { return m_generation; }
+
+private:
+    DriveData m_driveData;
+    uint64_t m_generation{ 0U };
 };
 
 } // namespace rg
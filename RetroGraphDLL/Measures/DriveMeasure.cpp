@@ -1,5 +1,7 @@
 module RG.Measures:DriveMeasure;
 
+import RG.Core;
+
 import "WindowsHeaderUnit.h";
 
 namespace rg {
@@ -7,15 +9,24 @@ namespace rg {
 constexpr auto axVolumeNameSize = int{ 64U };
 
 DriveMeasure::DriveMeasure(std::chrono::milliseconds updateInterval,
-                           std::unique_ptr<const IDriveDataSource> driveDataSource)
+                           std::unique_ptr<IDriveDataSource> driveDataSource)
     : Measure{ updateInterval }
     , m_driveDataSource{ std::move(driveDataSource) }
-    , m_driveData{ m_driveDataSource->getDriveData() } {}
+    , m_sourceGeneration{ 0U } {
+    m_driveDataSource->update();
+    m_sourceGeneration = m_driveDataSource->getGeneration();
+}
 
 bool DriveMeasure::updateInternal() {
-    const DriveData oldDriveData{ m_driveData };
-    m_driveData = m_driveDataSource->getDriveData();
-    return oldDriveData != m_driveData;
+    const ProfileZone zone{ "DriveMeasure::updateInternal" };
+
+    // The data source counts its changes, so the drives don't need copying and comparing here
+    m_driveDataSource->update();
+    if (m_driveDataSource->getGeneration() == m_sourceGeneration)
+        return false;
+
+    m_sourceGeneration = m_driveDataSource->getGeneration();
+    return true;
 }
 
 } // namespace rg
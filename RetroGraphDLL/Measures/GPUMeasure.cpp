@@ -1,5 +1,7 @@
 module RG.Measures:GPUMeasure;
 
+import RG.Core;
+
 namespace rg {
 
 GPUMeasure::GPUMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<IGPUDataSource> gpuDataSource)
@@ -7,7 +9,11 @@ GPUMeasure::GPUMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr
     , m_gpuDataSource{ std::move(gpuDataSource) } {}
 
 bool GPUMeasure::updateInternal() {
-    onGPUUsage.raise(m_gpuDataSource->getGPUUsage());
+    const ProfileZone zone{ "GPUMeasure::updateInternal" };
+
+    const auto usage{ m_gpuDataSource->getGPUUsage() };
+    onGPUUsage.raise(usage);
+    addAdaptiveSample(usage);
     return true;
 }
 
@@ -14,7 +14,11 @@ export class Measure {
 public:
     Measure(std::optional<milliseconds> updateInterval)
         : m_lastUpdateTime{ steady_clock::now() }
-        , m_updateInterval{ updateInterval } {}
+        , m_updateInterval{ updateInterval }
+        , m_generation{ 0U }
+        , m_suspended{ false }
+        , m_adaptiveInterval{}
+        , m_sampleSpan{ 1 } {}
 
     virtual ~Measure() = default;
 
@@ -24,29 +28,89 @@ public:
     Measure& operator=(Measure&&) = delete;
 
     void update() {
-        if (m_updateInterval) {
-            if (since(m_lastUpdateTime) > *m_updateInterval) {
+        if (m_updateInterval && !m_suspended) {
+            // Compared at full precision so a measure updates on the frame scheduled for its next update time
+            if (steady_clock::now() - m_lastUpdateTime >= *m_updateInterval) {
+                m_sampleSpan = m_adaptiveInterval ? m_adaptiveInterval->getSampleSpan() : 1;
                 if (updateInternal()) {
+                    ++m_generation;
                     postUpdate.raise();
                 }
-                m_lastUpdateTime = high_resolution_clock::now();
+                m_lastUpdateTime = steady_clock::now();
             }
         }
     }
 
+    /* When the measure is next due to update, or nothing if it doesn't update by itself or is suspended */
+    std::optional<steady_clock::time_point> getNextUpdateTime() const {
+        if (!m_updateInterval || m_suspended)
+            return std::nullopt;
+        return m_lastUpdateTime + *m_updateInterval;
+    }
+
     void setUpdateInterval(std::optional<milliseconds> updateInterval) {
         m_updateInterval = updateInterval;
-        m_lastUpdateTime = high_resolution_clock::now();
+        m_lastUpdateTime = steady_clock::now();
+    }
+
+    std::optional<milliseconds> getUpdateInterval() const { return m_updateInterval; }
+
+    /* Lets the update interval widen while what the measure samples is stable and tighten again when it changes,
+     * between the settings' minimum and maximum. Without settings the interval stays fixed at the minimum.
+     * Only measures that report their samples with addAdaptiveSample adapt their interval
+     */
+    void setAdaptiveInterval(std::optional<AdaptiveIntervalSettings> settings) {
+        if (settings) {
+            m_adaptiveInterval.emplace(*settings);
+            m_updateInterval = m_adaptiveInterval->getInterval();
+        } else if (m_adaptiveInterval) {
+            m_updateInterval = m_adaptiveInterval->getSettings().minInterval;
+            m_adaptiveInterval.reset();
+        }
+        m_sampleSpan = 1;
+    }
+
+    /* How many of the shortest update intervals the latest update covered. Graphs that space their points one
+     * shortest interval apart add the latest sample this many times, so it lands where it was taken in time
+     */
+    int getSampleSpan() const { return m_sampleSpan; }
+
+    /* Stops the measure sampling while nothing showing it can be seen. Once resumed, it samples on the next update
+     * whether or not it's due, to catch up on what changed in the meantime
+     */
+    void setSuspended(bool suspended) {
+        if (m_suspended && !suspended)
+            m_lastUpdateTime = steady_clock::time_point{};
+        m_suspended = suspended;
     }
 
+    bool isSuspended() const { return m_suspended; }
+
+    /* Increases every time the measure's data changes. Users can remember the generation they last saw to tell
+     * whether anything changed since, without comparing the data
+     */
+    uint64_t getGeneration() const { return m_generation; }
+
     PostUpdateEvent postUpdate;
 
 protected:
     // The implementation of measure updates. Returns true if any data was modified, otherwise returns false.
     virtual bool updateInternal() = 0;
 
-    high_resolution_clock::time_point m_lastUpdateTime;
+    // Adapts the update interval to the value sampled by the latest update, if the interval is adaptive
+    void addAdaptiveSample(float value) {
+        if (m_adaptiveInterval)
+            m_updateInterval = m_adaptiveInterval->addSample(value);
+    }
+
+    steady_clock::time_point m_lastUpdateTime;
     std::optional<milliseconds> m_updateInterval;
+
+private:
+    uint64_t m_generation;
+    bool m_suspended;
+    std::optional<AdaptiveInterval> m_adaptiveInterval;
+    int m_sampleSpan;
 };
 
 } // namespace rg
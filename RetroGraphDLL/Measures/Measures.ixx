@@ -9,7 +9,10 @@ export import :Measure;
 export import :MusicMeasure;
 export import :NetMeasure;
 export import :Particle;
+export import :ParticleCountTuner;
+export import :ParticleGrid;
 export import :ParticleLine;
+export import :ParticleOutput;
 export import :ProcessMeasure;
 export import :RAMMeasure;
 export import :SystemMeasure;
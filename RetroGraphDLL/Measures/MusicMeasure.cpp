@@ -1,17 +1,28 @@
 module RG.Measures:MusicMeasure;
 
+import RG.Core;
+
 namespace rg {
 
 MusicMeasure::MusicMeasure(std::chrono::milliseconds updateInterval,
-                           std::unique_ptr<const IMusicDataSource> musicDataSource)
+                           std::unique_ptr<IMusicDataSource> musicDataSource)
     : Measure{ updateInterval }
     , m_musicDataSource{ std::move(musicDataSource) }
-    , m_musicData{ m_musicDataSource->getMusicData() } {}
+    , m_sourceGeneration{ 0U } {
+    m_musicDataSource->update();
+    m_sourceGeneration = m_musicDataSource->getGeneration();
+}
 
 bool MusicMeasure::updateInternal() {
-    const MusicData oldMusicData{ m_musicData };
-    m_musicData = m_musicDataSource->getMusicData();
-    return oldMusicData != m_musicData;
+    const ProfileZone zone{ "MusicMeasure::updateInternal" };
+
+    // The data source counts its changes, so the strings don't need copying and comparing here
+    m_musicDataSource->update();
+    if (m_musicDataSource->getGeneration() == m_sourceGeneration)
+        return false;
+
+    m_sourceGeneration = m_musicDataSource->getGeneration();
+    return true;
 }
 
 } // namespace rg
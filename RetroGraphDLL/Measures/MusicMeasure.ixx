@@ -13,17 +13,17 @@ namespace rg {
  */
 export class MusicMeasure : public Measure {
 public:
-    MusicMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<const IMusicDataSource> musicDataSource);
+    MusicMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<IMusicDataSource> musicDataSource);
     ~MusicMeasure() noexcept = default;
 
-    bool isPlayerRunning() const { return m_musicData.isMusicPlayerRunning; }
+    bool isPlayerRunning() const { return getMusicData().isMusicPlayerRunning; }
 
-    bool isMusicPlaying() const { return m_musicData.isMusicPlaying; }
-    std::string_view getTrackName() const { return m_musicData.trackName; }
-    std::string_view getArtist() const { return m_musicData.artist; }
-    std::string_view getAlbum() const { return m_musicData.album; }
-    std::chrono::seconds getElapsedTime() const { return m_musicData.elapsedTime; }
-    std::chrono::seconds getTotalTime() const { return m_musicData.totalTime; }
+    bool isMusicPlaying() const { return getMusicData().isMusicPlaying; }
+    std::string_view getTrackName() const { return getMusicData().trackName; }
+    std::string_view getArtist() const { return getMusicData().artist; }
+    std::string_view getAlbum() const { return getMusicData().album; }
+    std::chrono::seconds getElapsedTime() const { return getMusicData().elapsedTime; }
+    std::chrono::seconds getTotalTime() const { return getMusicData().totalTime; }
 
 protected:
     /* If the player class name isn't yet set, enumerates all running windows
@@ -33,8 +33,10 @@ protected:
     bool updateInternal() override;
 
 private:
-    std::unique_ptr<const IMusicDataSource> m_musicDataSource;
-    MusicData m_musicData;
+    const MusicData& getMusicData() const { return m_musicDataSource->getMusicData(); }
+
+    std::unique_ptr<IMusicDataSource> m_musicDataSource;
+    uint64_t m_sourceGeneration;
 };
 
 } // namespace rg
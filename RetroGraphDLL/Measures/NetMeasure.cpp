@@ -9,6 +9,8 @@ NetMeasure::NetMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr
     , m_netDataSource{ std::move(netDataSource) } {}
 
 bool NetMeasure::updateInternal() {
+    const ProfileZone zone{ "NetMeasure::updateInternal" };
+
     // Check if the best network interface has changed and update to the new one if so.
     static Timer updateBestInterfaceTime{ std::chrono::seconds{ 30 } };
     if (updateBestInterfaceTime.hasElapsed()) {
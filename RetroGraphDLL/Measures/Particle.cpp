@@ -1,68 +1,248 @@
+module;
+
+#include <immintrin.h>
+#include <intrin.h>
+
 module RG.Measures:Particle;
 
-import "CSTDHeaderUnit.h";
+import RG.Core;
+
+import "RGAssert.h";
 
 namespace rg {
 
-Particle::Particle()
-    : x{ particleMinPos +
-         static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxPos - particleMinPos))) }
-    , y{ particleMinPos +
-         static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxPos - particleMinPos))) }
-    , dirX{ particleMinPos +
-            static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxPos - particleMinPos))) }
-    , dirY{ particleMinPos +
-            static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxPos - particleMinPos))) }
-    , size{ particleMinSize +
-            static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxSize - particleMinSize))) }
-    , speed{ particleMinSpeed +
-             static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (particleMaxSpeed - particleMinSpeed))) }
-    , cellX{ static_cast<int>((x + 1.0f) / cellSize) }
-    , cellY{ static_cast<int>((y + 1.0f) / cellSize) } {}
-
-void Particle::update(Cells& cells, float dt) {
-    x += speed * dirX * dt;
-    y += speed * dirY * dt;
-
-    // If we move off the screen, wrap the particle around to the other side
-    bool teleported{ false };
-    if (x < particleMinPos) {
-        x = particleMaxPos;
-        y = std::clamp(-y, particleMinPos, particleMaxPos);
-        teleported = true;
-    } else if (x > particleMaxPos) {
-        x = particleMinPos;
-        y = std::clamp(-y, particleMinPos, particleMaxPos);
-        teleported = true;
+namespace {
+
+/* Calls f(begin, end) for ranges of the particles in parallel, with at least minParticlesPerJob in each. Ranges are
+ * multiples of 8 particles, so only the last one has any left over from the SIMD kernels
+ */
+template<typename F>
+void forEachParticleRange(JobSystem& jobs, size_t numParticles, const F& f) {
+    const auto numJobs{ std::min(jobs.getNumThreads() * 4,
+                                 (numParticles + Particles::minParticlesPerJob - 1) / Particles::minParticlesPerJob) };
+    if (numJobs == 0)
+        return;
+
+    const auto particlesPerJob{ ((numParticles + numJobs - 1) / numJobs + 7) & ~size_t{ 7 } };
+    jobs.parallelFor(numJobs, [&](size_t job, size_t) {
+        const auto begin{ std::min(job * particlesPerJob, numParticles) };
+        f(begin, std::min(begin + particlesPerJob, numParticles));
+    });
+}
+
+/* The kernels below all do the same float operations in the same order, so they give identical results.
+ * A particle leaving the world through a side is moved to the opposite side and mirrored along the other axis, e.g.
+ * leaving through the left at height y puts it on the right at height -y. Particles leaving through a corner are
+ * wrapped in x only, otherwise they'd land back in the same spot and be stuck forever
+ */
+
+void updateScalar(Particles& p, size_t begin, size_t end, float dt) {
+    for (auto i{ begin }; i < end; ++i) {
+        const auto x{ p.x[i] + p.speed[i] * p.dirX[i] * dt };
+        const auto y{ p.y[i] + p.speed[i] * p.dirY[i] * dt };
+
+        const bool xLow{ x < particleMinPos };
+        const bool xHigh{ x > particleMaxPos };
+        const bool xOut{ xLow || xHigh };
+        const bool yOut{ !xOut && (y < particleMinPos || y > particleMaxPos) };
+
+        // Same as std::clamp(-v, particleMinPos, particleMaxPos) and the SIMD min(max(-v, lo), hi)
+        const auto negX{ -x };
+        const auto negY{ -y };
+        const auto mirroredX{ std::min(std::max(negX, particleMinPos), particleMaxPos) };
+        const auto mirroredY{ std::min(std::max(negY, particleMinPos), particleMaxPos) };
+
+        p.x[i] = xLow ? particleMaxPos : xHigh ? particleMinPos : yOut ? mirroredX : x;
+        p.y[i] = xOut ? mirroredY : y < particleMinPos ? particleMaxPos : y > particleMaxPos ? particleMinPos : y;
     }
+}
 
-    // Check the need to wrap in the y direction ONLY if we didn't wrap in the x direction,
-    // otherwise we'll just put the particle back in the same spot and it will be stuck forever
-    if (!teleported) {
-        if (y < particleMinPos) {
-            x = std::clamp(-x, particleMinPos, particleMaxPos);
-            y = particleMaxPos;
-        } else if (y > particleMaxPos) {
-            x = std::clamp(-x, particleMinPos, particleMaxPos);
-            y = particleMinPos;
-        }
+// Selects b where mask is set, otherwise a. SSE4.1's blendv isn't guaranteed on x64
+__m128 select(__m128 a, __m128 b, __m128 mask) {
+    return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+/* Updates particles from begin in groups of 4. Returns where it stopped, leaving fewer than 4 before end */
+size_t updateSSE2(Particles& p, size_t begin, size_t end, float dt) {
+    const auto minPos{ _mm_set1_ps(particleMinPos) };
+    const auto maxPos{ _mm_set1_ps(particleMaxPos) };
+    const auto signBit{ _mm_set1_ps(-0.0f) };
+    const auto dtv{ _mm_set1_ps(dt) };
+
+    const auto n{ begin + ((end - begin) & ~size_t{ 3 }) };
+    for (auto i{ begin }; i < n; i += 4) {
+        const auto speed{ _mm_loadu_ps(&p.speed[i]) };
+        const auto x{ _mm_add_ps(_mm_loadu_ps(&p.x[i]), _mm_mul_ps(_mm_mul_ps(speed, _mm_loadu_ps(&p.dirX[i])), dtv)) };
+        const auto y{ _mm_add_ps(_mm_loadu_ps(&p.y[i]), _mm_mul_ps(_mm_mul_ps(speed, _mm_loadu_ps(&p.dirY[i])), dtv)) };
+
+        const auto xLow{ _mm_cmplt_ps(x, minPos) };
+        const auto xHigh{ _mm_cmpgt_ps(x, maxPos) };
+        const auto xOut{ _mm_or_ps(xLow, xHigh) };
+        const auto yLow{ _mm_cmplt_ps(y, minPos) };
+        const auto yHigh{ _mm_cmpgt_ps(y, maxPos) };
+        const auto yOut{ _mm_andnot_ps(xOut, _mm_or_ps(yLow, yHigh)) };
+
+        const auto mirroredX{ _mm_min_ps(_mm_max_ps(_mm_xor_ps(x, signBit), minPos), maxPos) };
+        const auto mirroredY{ _mm_min_ps(_mm_max_ps(_mm_xor_ps(y, signBit), minPos), maxPos) };
+
+        auto newX{ select(x, mirroredX, yOut) };
+        newX = select(newX, minPos, xHigh);
+        newX = select(newX, maxPos, xLow);
+
+        auto newY{ select(y, minPos, yHigh) };
+        newY = select(newY, maxPos, yLow);
+        newY = select(newY, mirroredY, xOut);
+
+        _mm_storeu_ps(&p.x[i], newX);
+        _mm_storeu_ps(&p.y[i], newY);
     }
+    return n;
+}
+
+/* Updates particles from begin in groups of 8. Returns where it stopped, leaving fewer than 8 before end */
+size_t updateAVX2(Particles& p, size_t begin, size_t end, float dt) {
+    const auto minPos{ _mm256_set1_ps(particleMinPos) };
+    const auto maxPos{ _mm256_set1_ps(particleMaxPos) };
+    const auto signBit{ _mm256_set1_ps(-0.0f) };
+    const auto dtv{ _mm256_set1_ps(dt) };
 
-    const int newCellX{ static_cast<int>((x + 1.0f) / cellSize) };
-    const int newCellY{ static_cast<int>((y + 1.0f) / cellSize) };
+    const auto n{ begin + ((end - begin) & ~size_t{ 7 }) };
+    for (auto i{ begin }; i < n; i += 8) {
+        const auto speed{ _mm256_loadu_ps(&p.speed[i]) };
+        const auto x{ _mm256_add_ps(_mm256_loadu_ps(&p.x[i]),
+                                    _mm256_mul_ps(_mm256_mul_ps(speed, _mm256_loadu_ps(&p.dirX[i])), dtv)) };
+        const auto y{ _mm256_add_ps(_mm256_loadu_ps(&p.y[i]),
+                                    _mm256_mul_ps(_mm256_mul_ps(speed, _mm256_loadu_ps(&p.dirY[i])), dtv)) };
 
-    // If we've shifted into a new cell, we have to update the cell's particle list
-    if (newCellX != cellX || newCellY != cellY) {
-        // remove from old cell
-        auto& cell{ cells[cellX][cellY] };
-        cell.erase(std::remove(cell.begin(), cell.end(), this), cell.end());
+        const auto xLow{ _mm256_cmp_ps(x, minPos, _CMP_LT_OQ) };
+        const auto xHigh{ _mm256_cmp_ps(x, maxPos, _CMP_GT_OQ) };
+        const auto xOut{ _mm256_or_ps(xLow, xHigh) };
+        const auto yLow{ _mm256_cmp_ps(y, minPos, _CMP_LT_OQ) };
+        const auto yHigh{ _mm256_cmp_ps(y, maxPos, _CMP_GT_OQ) };
+        const auto yOut{ _mm256_andnot_ps(xOut, _mm256_or_ps(yLow, yHigh)) };
 
-        // add to new cell
-        cells[newCellX][newCellY].push_back(this);
+        const auto mirroredX{ _mm256_min_ps(_mm256_max_ps(_mm256_xor_ps(x, signBit), minPos), maxPos) };
+        const auto mirroredY{ _mm256_min_ps(_mm256_max_ps(_mm256_xor_ps(y, signBit), minPos), maxPos) };
 
-        cellX = newCellX;
-        cellY = newCellY;
+        auto newX{ _mm256_blendv_ps(x, mirroredX, yOut) };
+        newX = _mm256_blendv_ps(newX, minPos, xHigh);
+        newX = _mm256_blendv_ps(newX, maxPos, xLow);
+
+        auto newY{ _mm256_blendv_ps(y, minPos, yHigh) };
+        newY = _mm256_blendv_ps(newY, maxPos, yLow);
+        newY = _mm256_blendv_ps(newY, mirroredY, xOut);
+
+        _mm256_storeu_ps(&p.x[i], newX);
+        _mm256_storeu_ps(&p.y[i], newY);
     }
+    return n;
+}
+
+SimdLevel detectSimdLevel() {
+    int info[4]{};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return SimdLevel::SSE2;
+
+    // AVX also needs the OS to save the upper halves of the registers on context switches
+    __cpuid(info, 1);
+    const bool hasAVX{ (info[2] & (1 << 28)) != 0 };
+    const bool osSavesAVX{ (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6 };
+
+    __cpuidex(info, 7, 0);
+    const bool hasAVX2{ (info[1] & (1 << 5)) != 0 };
+
+    return hasAVX && osSavesAVX && hasAVX2 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+}
+
+} // namespace
+
+SimdLevel getSupportedSimdLevel() {
+    static const SimdLevel simdLevel{ detectSimdLevel() };
+    return simdLevel;
+}
+
+void Particles::addRandom(size_t count, Pcg32& rng) {
+    for (auto i = size_t{ 0U }; i < count; ++i) {
+        x.push_back(rng.nextFloat(particleMinPos, particleMaxPos));
+        y.push_back(rng.nextFloat(particleMinPos, particleMaxPos));
+        dirX.push_back(rng.nextFloat(particleMinPos, particleMaxPos));
+        dirY.push_back(rng.nextFloat(particleMinPos, particleMaxPos));
+        size.push_back(rng.nextFloat(particleMinSize, particleMaxSize));
+        speed.push_back(rng.nextFloat(particleMinSpeed, particleMaxSpeed));
+        prevX.push_back(x.back());
+        prevY.push_back(y.back());
+    }
+}
+
+void Particles::resize(size_t count, Pcg32& rng) {
+    if (count > this->count()) {
+        addRandom(count - this->count(), rng);
+        return;
+    }
+
+    for (auto* values : { &x, &y, &dirX, &dirY, &speed, &size, &prevX, &prevY })
+        values->resize(count);
+}
+
+void Particles::update(float dt, SimdLevel simd) {
+    updateRange(dt, simd, 0, count());
+}
+
+void Particles::update(float dt, SimdLevel simd, JobSystem& jobs) {
+    forEachParticleRange(jobs, count(), [&](size_t begin, size_t end) {
+        const ProfileZone zone{ "Particles::update job" };
+
+        updateRange(dt, simd, begin, end);
+    });
+}
+
+void Particles::updateRange(float dt, SimdLevel simd, size_t begin, size_t end) {
+    std::copy(x.cbegin() + begin, x.cbegin() + end, prevX.begin() + begin);
+    std::copy(y.cbegin() + begin, y.cbegin() + end, prevY.begin() + begin);
+
+    auto numUpdated{ begin };
+    switch (simd) {
+        case SimdLevel::AVX2:
+            numUpdated = updateAVX2(*this, begin, end, dt);
+            break;
+        case SimdLevel::SSE2:
+            numUpdated = updateSSE2(*this, begin, end, dt);
+            break;
+        default:
+            break;
+    }
+
+    // Particles left over from the SIMD kernels
+    updateScalar(*this, numUpdated, end, dt);
+}
+
+void Particles::interpolate(float alpha, ParticlePositions& positions, JobSystem& jobs,
+                            std::span<ParticleVertex> vertices) const {
+    RGASSERT(vertices.empty() || vertices.size() == count(), "Vertices must have room for every particle");
+
+    positions.x.resize(count());
+    positions.y.resize(count());
+    forEachParticleRange(jobs, count(), [&](size_t begin, size_t end) {
+        const ProfileZone zone{ "Particles::interpolate job" };
+
+        for (auto i{ begin }; i < end; ++i) {
+            // An update moves a particle far less than half the world, unless it wrapped around
+            const bool wrapped{ std::abs(x[i] - prevX[i]) > 1.0f || std::abs(y[i] - prevY[i]) > 1.0f };
+            positions.x[i] = wrapped ? x[i] : lerp(prevX[i], x[i], alpha);
+            positions.y[i] = wrapped ? y[i] : lerp(prevY[i], y[i], alpha);
+        }
+
+        if (!vertices.empty()) {
+            for (auto i{ begin }; i < end; ++i)
+                vertices[i] = ParticleVertex{ { positions.x[i], positions.y[i] }, size[i] };
+        }
+    });
+}
+
+void Particles::writeVertices(size_t begin, size_t end, std::span<ParticleVertex> vertices) const {
+    for (auto i{ begin }; i < end; ++i)
+        vertices[i] = ParticleVertex{ { x[i], y[i] }, size[i] };
 }
 
 } // namespace rg
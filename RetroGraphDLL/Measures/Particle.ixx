@@ -1,44 +1,89 @@
 export module RG.Measures:Particle;
 
+import :ParticleOutput;
+
+import RG.Core;
+
 import std.core;
 
 namespace rg {
 
-struct Particle;
-
 export {
-    // NOTE: numCellsPerSide == (2.0 / cellSize)
-    // cellSize should be no smaller than particleConnectionDistance
-    constexpr auto particleConnectionDistance = float{ 0.2f };
-    constexpr auto cellSize = float{ particleConnectionDistance };
-    constexpr auto numCellsPerSide = int{ 10 };
-
     constexpr auto particleMinSize = float{ 1.0f };
     constexpr auto particleMaxSize = float{ 10.0f };
     constexpr auto particleMinPos = float{ -0.998f };
     constexpr auto particleMaxPos = float{ 0.998f };
     constexpr auto particleMinSpeed = float{ 0.01f };
     constexpr auto particleMaxSpeed = float{ 0.1f };
-
-    using CellParticleList = std::vector<const Particle*>;
-    using Cells = std::array<std::array<CellParticleList, numCellsPerSide>, numCellsPerSide>;
 }
 
-export struct Particle {
-    // Initialises members with random values. Should seed before constructing.
-    Particle();
+/* Instruction sets the particle update can use, from slowest to fastest */
+export enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+/* The fastest SIMD level the CPU and OS support */
+export SimdLevel getSupportedSimdLevel();
+
+/* Positions to draw the particles at */
+export struct ParticlePositions {
+    std::vector<float> x;
+    std::vector<float> y;
+};
+
+/* Every particle's state, with each field in its own array so the update kernels can load several particles at once.
+ * All arrays are always the same size.
+ */
+export struct Particles {
+    static constexpr size_t minParticlesPerJob{ 4096U };
+
+    size_t count() const { return x.size(); }
+
+    /* Appends count particles with random positions, directions, sizes and speeds. The same rng state always gives the
+     * same particles
+     */
+    void addRandom(size_t count, Pcg32& rng);
+
+    /* Adds random particles or removes the newest ones until there are count particles */
+    void resize(size_t count, Pcg32& rng);
+
+    /* Moves every particle along its direction, wrapping particles that leave the world around to the other side.
+     * Every SIMD level gives exactly the same positions
+     */
+    void update(float dt, SimdLevel simd);
+
+    /* Same as update, but splits the particles into jobs run in parallel. Few particles are updated in one job, as
+     * spreading them over threads would cost more than it saves
+     */
+    void update(float dt, SimdLevel simd, JobSystem& jobs);
+
+    /* Updates the particles in [begin, end) */
+    void updateRange(float dt, SimdLevel simd, size_t begin, size_t end);
+
+    /* Sets positions to alpha of the way from where the particles were before the last update to where they are now,
+     * for drawing between updates. Particles that wrapped around in the last update are drawn where they are now,
+     * rather than crossing the world. Split into jobs like update, which also write the vertices if there are any
+     */
+    void interpolate(float alpha, ParticlePositions& positions, JobSystem& jobs,
+                     std::span<ParticleVertex> vertices = {}) const;
 
-    void update(Cells& cells, float dt);
+    /* Writes the vertices of the particles in [begin, end) at their current positions to the same range of vertices.
+     * Only writes, so vertices can be write-only memory
+     */
+    void writeVertices(size_t begin, size_t end, std::span<ParticleVertex> vertices) const;
 
-    float x{ 0.0f };
-    float y{ 0.0f };
-    float dirX{ 0.0f };
-    float dirY{ 0.0f };
-    float size{ 0.0f };
-    float speed{ 0.0f };
+    std::vector<float> x;
+    std::vector<float> y;
 
-    int cellX{ 0 };
-    int cellY{ 0 };
+    // Positions before the last update
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    std::vector<float> dirX;
+    std::vector<float> dirY;
+    std::vector<float> speed;
+    std::vector<float> size;
 };
 
 } // namespace rg
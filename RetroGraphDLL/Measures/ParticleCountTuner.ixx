@@ -0,0 +1,100 @@
+export module RG.Measures:ParticleCountTuner;
+
+import std.core;
+
+namespace rg {
+
+using namespace std::chrono;
+
+/* Finds the largest particle count whose updates fit in a time budget.
+ * Update times are averaged over a batch of updates before each decision, so one slow update doesn't throw it off. The
+ * count doubles until it's too slow, then is bisected between the largest count that fit and the smallest that didn't.
+ * Once those are close it settles on the one that fit, backing off if updates later get slower (e.g. the machine is
+ * busy) and searching upwards again if they get much faster.
+ */
+export class ParticleCountTuner {
+public:
+    static constexpr int updatesPerDecision{ 30 };
+
+    // The search stops when the count that fits is within this fraction of the one that doesn't
+    static constexpr double settledPrecision{ 0.05 };
+
+    ParticleCountTuner(microseconds budget, size_t startCount, size_t minCount, size_t maxCount)
+        : m_budget{ budget }
+        , m_minCount{ std::max(minCount, size_t{ 1U }) }
+        , m_maxCount{ std::max(maxCount, m_minCount) }
+        , m_count{ std::clamp(startCount, m_minCount, m_maxCount) }
+        , m_largestFitting{ 0 }
+        , m_smallestTooSlow{ std::nullopt }
+        , m_totalTime{ 0 }
+        , m_numUpdates{ 0 } {}
+
+    /* Records how long an update with the current count took. Returns the count to use from now on */
+    size_t addUpdateTime(microseconds updateTime) {
+        m_totalTime += updateTime;
+        if (++m_numUpdates < updatesPerDecision)
+            return m_count;
+
+        const auto meanTime{ m_totalTime / m_numUpdates };
+        m_totalTime = microseconds{ 0 };
+        m_numUpdates = 0;
+
+        if (meanTime <= m_budget) {
+            m_largestFitting = std::max(m_largestFitting, m_count);
+
+            // Much faster than expected at the settled count, so there may be room for more
+            if (isSettled() && meanTime * 2 < m_budget)
+                m_smallestTooSlow.reset();
+        } else {
+            m_smallestTooSlow = m_count;
+
+            // Counts that used to fit may not any more, so estimate a new one assuming time grows with the count
+            if (m_largestFitting >= m_count) {
+                const auto scale{ static_cast<double>(m_budget.count()) / static_cast<double>(meanTime.count()) };
+                m_largestFitting = static_cast<size_t>(static_cast<double>(m_count) * scale);
+            }
+        }
+
+        m_count = std::clamp(getNextCount(), m_minCount, m_maxCount);
+        return m_count;
+    }
+
+    size_t getCount() const { return m_count; }
+
+    /* Whether the search has found the largest count that fits */
+    bool isSettled() const {
+        if (!m_smallestTooSlow)
+            return m_largestFitting >= m_maxCount;
+
+        // Can't go any lower
+        if (*m_smallestTooSlow <= m_minCount)
+            return true;
+
+        const auto gap{ static_cast<double>(*m_smallestTooSlow - std::min(m_largestFitting, *m_smallestTooSlow)) };
+        return gap <= static_cast<double>(m_largestFitting) * settledPrecision;
+    }
+
+private:
+    size_t getNextCount() const {
+        if (!m_smallestTooSlow)
+            return std::max(m_count * 2, m_largestFitting * 2);
+
+        if (isSettled())
+            return m_largestFitting;
+
+        return (m_largestFitting + *m_smallestTooSlow) / 2;
+    }
+
+    microseconds m_budget;
+    size_t m_minCount;
+    size_t m_maxCount;
+    size_t m_count;
+
+    size_t m_largestFitting;
+    std::optional<size_t> m_smallestTooSlow;
+
+    microseconds m_totalTime;
+    int m_numUpdates;
+};
+
+} // namespace rg
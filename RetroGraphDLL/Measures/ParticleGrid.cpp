@@ -0,0 +1,122 @@
+module RG.Measures:ParticleGrid;
+
+import RG.Core;
+
+import "RGAssert.h";
+
+namespace rg {
+
+namespace {
+
+constexpr float worldSize{ 2.0f };
+
+} // namespace
+
+ParticleGrid::ParticleGrid(float connectionDistance, int cellsPerSide)
+    : m_connectionDistance{ std::clamp(connectionDistance, minConnectionDistance, maxConnectionDistance) }
+    , m_cellsPerSide{ std::clamp(cellsPerSide, 3, static_cast<int>(worldSize / m_connectionDistance + 0.0001f)) }
+    , m_cellsPerUnit{ static_cast<float>(m_cellsPerSide) / worldSize }
+    , m_cellStarts(static_cast<size_t>(m_cellsPerSide * m_cellsPerSide + 1), 0)
+    , m_nextSlots(m_cellStarts.size(), 0)
+    , m_particleCells{}
+    , m_particleIndices{}
+    , m_x{}
+    , m_y{}
+    , m_threadLines{} {}
+
+void ParticleGrid::build(std::span<const float> x, std::span<const float> y) {
+    RGASSERT(x.size() == y.size(), "Every particle needs an x and y position");
+
+    const auto numParticles{ x.size() };
+    m_particleCells.resize(numParticles);
+    m_particleIndices.resize(numParticles);
+    m_x.resize(numParticles);
+    m_y.resize(numParticles);
+
+    // Count the particles in each cell, offset by one so the running total below gives each cell's start
+    std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+    for (auto i = size_t{ 0U }; i < numParticles; ++i) {
+        const auto cell{ getCellIndex(getCell(x[i]), getCell(y[i])) };
+        m_particleCells[i] = cell;
+        ++m_cellStarts[cell + 1];
+    }
+
+    for (auto cell = size_t{ 1U }; cell < m_cellStarts.size(); ++cell)
+        m_cellStarts[cell] += m_cellStarts[cell - 1];
+
+    // Place each particle at the next free slot of its cell
+    std::copy(m_cellStarts.cbegin(), m_cellStarts.cend(), m_nextSlots.begin());
+    for (auto i = size_t{ 0U }; i < numParticles; ++i) {
+        const auto slot{ m_nextSlots[m_particleCells[i]]++ };
+        m_particleIndices[slot] = static_cast<uint32_t>(i);
+        m_x[slot] = x[i];
+        m_y[slot] = y[i];
+    }
+}
+
+size_t ParticleGrid::findClosePairs(JobSystem& jobs, ParticleOutput& output, size_t expectedLines) {
+    // Too few particles to be worth spreading out
+    if (jobs.getNumThreads() == 1 || m_particleIndices.size() < Particles::minParticlesPerJob) {
+        auto lines{ output.beginLines(expectedLines) };
+        size_t numLines{ 0 };
+        forEachClosePair([&](float x1, float y1, float x2, float y2) {
+            if (numLines < lines.size())
+                lines[numLines] = ParticleLine{ x1, y1, x2, y2 };
+            ++numLines;
+        });
+
+        // More lines than there was room for. The output can't be read back, so search again now it has enough room
+        if (numLines > lines.size()) {
+            output.endLines(0);
+            lines = output.beginLines(numLines);
+
+            size_t lineIndex{ 0 };
+            forEachClosePair([&](float x1, float y1, float x2, float y2) {
+                lines[lineIndex++] = ParticleLine{ x1, y1, x2, y2 };
+            });
+        }
+
+        output.endLines(numLines);
+        return numLines;
+    }
+
+    m_threadLines.resize(jobs.getNumThreads());
+    for (auto& threadLines : m_threadLines)
+        threadLines.lines.clear();
+
+    // Strips of one column each, as there are few enough columns that each still has plenty of work
+    jobs.parallelFor(static_cast<size_t>(m_cellsPerSide), [&](size_t strip, size_t threadIndex) {
+        const ProfileZone zone{ "ParticleGrid::findClosePairs strip" };
+
+        auto& lines{ m_threadLines[threadIndex].lines };
+        const auto cellX{ static_cast<int>(strip) };
+        forEachClosePairInColumns(cellX, cellX + 1, [&lines](float x1, float y1, float x2, float y2) {
+            lines.emplace_back(x1, y1, x2, y2);
+        });
+    });
+
+    size_t numLines{ 0 };
+    for (auto& threadLines : m_threadLines) {
+        threadLines.offset = numLines;
+        numLines += threadLines.lines.size();
+    }
+
+    const auto lines{ output.beginLines(numLines) };
+    jobs.parallelFor(m_threadLines.size(), [&](size_t thread, size_t) {
+        const auto& threadLines{ m_threadLines[thread] };
+        std::copy(threadLines.lines.cbegin(), threadLines.lines.cend(), lines.data() + threadLines.offset);
+    });
+    output.endLines(numLines);
+
+    return numLines;
+}
+
+size_t ParticleGrid::estimateNumClosePairs(size_t numParticles) const {
+    // Each pair is connected with the chance that one is within a circle around the other
+    const auto numPairs{ static_cast<double>(numParticles) * (static_cast<double>(numParticles) - 1.0) / 2.0 };
+    const auto circleArea{ std::numbers::pi * m_connectionDistance * m_connectionDistance };
+    const auto connectChance{ circleArea / (worldSize * worldSize) };
+    return static_cast<size_t>(numPairs * connectChance);
+}
+
+} // namespace rg
@@ -0,0 +1,148 @@
+export module RG.Measures:ParticleGrid;
+
+import :Particle;
+import :ParticleLine;
+import :ParticleOutput;
+
+import RG.Core;
+
+import std.core;
+
+namespace rg {
+
+/* Uniform grid over the world for finding particles close to each other.
+ * The grid is rebuilt from scratch every update with a counting sort, so each cell's particles are a contiguous range
+ * of one array rather than a list of their own. Once it has seen the largest particle count, building doesn't allocate.
+ */
+export class ParticleGrid {
+public:
+    static constexpr float defaultConnectionDistance{ 0.2f };
+    static constexpr int defaultCellsPerSide{ 10 };
+
+    // Only neighbouring cells are searched, so cells can't be smaller than the connection distance. The world is 2.0
+    // wide, and with fewer than 3 cells per side a cell's neighbours would include itself
+    static constexpr float minConnectionDistance{ 0.01f };
+    static constexpr float maxConnectionDistance{ 2.0f / 3.0f };
+
+    /* Particles closer than connectionDistance are connected. The distance and number of cells are limited to what the
+     * search supports, so cellsPerSide is reduced if the cells would be too small for the distance
+     */
+    explicit ParticleGrid(float connectionDistance = defaultConnectionDistance,
+                          int cellsPerSide = defaultCellsPerSide);
+
+    /* Sorts the particles into their cells */
+    void build(const Particles& particles) { build(particles.x, particles.y); }
+
+    /* Sorts particles at the given positions into their cells */
+    void build(std::span<const float> x, std::span<const float> y);
+
+    /* Calls f(x1, y1, x2, y2) once for every pair of particles closer together than the connection distance */
+    template<typename F>
+    void forEachClosePair(F&& f) const { forEachClosePairInColumns(0, m_cellsPerSide, f); }
+
+    /* Same as forEachClosePair, but only for pairs whose first particle is in a cell in columns [beginX, endX).
+     * Only reads the grid, so separate columns can be searched in parallel
+     */
+    template<typename F>
+    void forEachClosePairInColumns(int beginX, int endX, F&& f) const;
+
+    /* Writes a line for every close pair to output, returning how many there were. expectedLines is how much room to
+     * ask the output for up front.
+     * Few particles are searched on the calling thread, writing straight to the output. Otherwise strips of cell columns
+     * are searched in parallel, each thread adding lines to its own buffer. The buffers are then copied to separate
+     * ranges of the output in parallel, so no locks are needed
+     */
+    size_t findClosePairs(JobSystem& jobs, ParticleOutput& output, size_t expectedLines);
+
+    /* Roughly how many pairs forEachClosePair finds for evenly spread particles */
+    size_t estimateNumClosePairs(size_t numParticles) const;
+
+    float getConnectionDistance() const { return m_connectionDistance; }
+    int getCellsPerSide() const { return m_cellsPerSide; }
+
+    /* The cell a world space position falls in along either axis */
+    int getCell(float pos) const {
+        return std::clamp(static_cast<int>((pos + 1.0f) * m_cellsPerUnit), 0, m_cellsPerSide - 1);
+    }
+
+    /* Indices of the particles in the given cell, into the particles the grid was built from */
+    std::span<const uint32_t> getCellParticles(int cellX, int cellY) const {
+        const auto cell{ getCellIndex(cellX, cellY) };
+        return { m_particleIndices.data() + m_cellStarts[cell], m_cellStarts[cell + 1] - m_cellStarts[cell] };
+    }
+
+private:
+    int getCellIndex(int cellX, int cellY) const { return cellX * m_cellsPerSide + cellY; }
+
+    float m_connectionDistance;
+    int m_cellsPerSide;
+    float m_cellsPerUnit;
+
+    // Where each cell's particles start in the sorted arrays. Has an extra entry so cell i ends at m_cellStarts[i + 1]
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_nextSlots;
+
+    // Cell of each particle, in the order they were given
+    std::vector<uint32_t> m_particleCells;
+
+    // Particles sorted by cell. Positions are copied in so neighbour searches read memory in order
+    std::vector<uint32_t> m_particleIndices;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+
+    // Padded so threads adding lines don't contend on the same cache line
+    struct alignas(std::hardware_destructive_interference_size) ThreadLines {
+        std::vector<ParticleLine> lines;
+        size_t offset{ 0 };
+    };
+
+    // Lines found by each thread in findClosePairs, and where they go in the combined lines. Keep their capacity
+    std::vector<ThreadLines> m_threadLines;
+};
+
+template<typename F>
+void ParticleGrid::forEachClosePairInColumns(int beginX, int endX, F&& f) const {
+    const auto radiusSq{ m_connectionDistance * m_connectionDistance };
+    const auto testPair = [&](uint32_t i, uint32_t j) {
+        const auto dx{ m_x[i] - m_x[j] };
+        const auto dy{ m_y[i] - m_y[j] };
+        if (dx * dx + dy * dy < radiusSq)
+            f(m_x[i], m_y[i], m_x[j], m_y[j]);
+    };
+
+    for (auto cellX{ beginX }; cellX < endX; ++cellX) {
+        for (int cellY{ 0 }; cellY < m_cellsPerSide; ++cellY) {
+            const auto cell{ getCellIndex(cellX, cellY) };
+            const auto begin{ m_cellStarts[cell] };
+            const auto end{ m_cellStarts[cell + 1] };
+            if (begin == end)
+                continue;
+
+            const auto nextX{ (cellX + 1) % m_cellsPerSide };
+            const auto nextY{ (cellY + 1) % m_cellsPerSide };
+            const auto prevY{ (cellY + m_cellsPerSide - 1) % m_cellsPerSide };
+
+            // Pairs can cross cell boundaries. Checking half of the neighbouring cells tests each pair of cells once,
+            // as the other half check this cell
+            const std::array neighbouringCells{
+                getCellIndex(cellX, nextY),
+                getCellIndex(nextX, cellY),
+                getCellIndex(nextX, prevY),
+                getCellIndex(nextX, nextY),
+            };
+
+            for (auto i{ begin }; i < end; ++i) {
+                // j starts at i+1 so each pair in the cell is only tested once
+                for (auto j{ i + 1 }; j < end; ++j)
+                    testPair(i, j);
+
+                for (const auto neighbour : neighbouringCells) {
+                    for (auto j{ m_cellStarts[neighbour] }; j < m_cellStarts[neighbour + 1]; ++j)
+                        testPair(i, j);
+                }
+            }
+        }
+    }
+}
+
+} // namespace rg
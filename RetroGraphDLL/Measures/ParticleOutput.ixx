@@ -0,0 +1,62 @@
+export module RG.Measures:ParticleOutput;
+
+import :ParticleLine;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+#pragma pack(push)
+#pragma pack(1)
+/* A particle as particle.vert takes it */
+export struct ParticleVertex {
+    glm::vec2 position;
+    float scale;
+};
+#pragma pack(pop)
+
+/* Where the particle simulation writes what gets drawn each update, in the vertex layouts of particle.vert and
+ * particleLine.vert. A renderer can hand out mapped GPU buffers, so the output doesn't need copying again afterwards.
+ * The memory handed out may be write-only, so it must never be read from.
+ */
+export class ParticleOutput {
+public:
+    virtual ~ParticleOutput() = default;
+
+    /* Returns room for exactly numParticles vertices, which can be written until endParticles is called */
+    virtual std::span<ParticleVertex> beginParticles(size_t numParticles) = 0;
+    virtual void endParticles() = 0;
+
+    /* Returns room for at least numLines lines, which can be written until endLines is called with how many were */
+    virtual std::span<ParticleLine> beginLines(size_t numLines) = 0;
+    virtual void endLines(size_t numWritten) = 0;
+};
+
+/* Keeps the output in ordinary memory */
+export class ParticleVectorOutput : public ParticleOutput {
+public:
+    std::span<ParticleVertex> beginParticles(size_t numParticles) override {
+        m_vertices.resize(numParticles);
+        return m_vertices;
+    }
+
+    void endParticles() override {}
+
+    std::span<ParticleLine> beginLines(size_t numLines) override {
+        m_lines.resize(std::max(numLines, m_lines.capacity()));
+        return m_lines;
+    }
+
+    void endLines(size_t numWritten) override { m_lines.resize(numWritten); }
+
+    const std::vector<ParticleVertex>& getVertices() const { return m_vertices; }
+    const std::vector<ParticleLine>& getLines() const { return m_lines; }
+
+private:
+    std::vector<ParticleVertex> m_vertices;
+    std::vector<ParticleLine> m_lines;
+};
+
+} // namespace rg
@@ -12,8 +12,9 @@ import "WindowsHeaderUnit.h";
 namespace rg {
 
 // TODO DataSource
-ProcessMeasure::ProcessMeasure()
+ProcessMeasure::ProcessMeasure(std::shared_ptr<SystemTimes> systemTimes)
     : Measure{ seconds{ 2 } }
+    , m_systemTimes{ std::move(systemTimes) }
     , m_numCPUProcessesToDisplay{ UserSettings::inst().getVal<int>("Widgets-ProcessesCPU.NumProcessesDisplayed") }
     , m_numRAMProcessesToDisplay{ UserSettings::inst().getVal<int>("Widgets-ProcessesRAM.NumProcessesDisplayed") }
     , m_configRefreshedHandle{ UserSettings::inst().configRefreshed.attach([&]() {
@@ -41,6 +42,8 @@ ProcessMeasure::~ProcessMeasure() {
 }
 
 bool ProcessMeasure::updateInternal() {
+    const ProfileZone zone{ "ProcessMeasure::updateInternal" };
+
     // Update the process list vector every 10 seconds
     static Timer newProcessUpdateTimer{ std::chrono::seconds{ 10 } };
     if (newProcessUpdateTimer.hasElapsed()) {
@@ -49,6 +52,9 @@ bool ProcessMeasure::updateInternal() {
         newProcessUpdateTimer.restart();
     }
 
+    // Every process is measured against the same system times, so their percentages add up
+    const auto& systemTimes{ m_systemTimes->get().total };
+
     // Track iterator outside while scope for std::erase
     auto it{ m_allProcessData.begin() };
     while (it != m_allProcessData.end()) {
@@ -77,7 +83,7 @@ bool ProcessMeasure::updateInternal() {
             it = m_allProcessData.erase(it);
         } else {
             // Get new timing information and calculate the CPU usage
-            const auto cpuUsage{ calculateCPUUsage(pHandle, pd) };
+            const auto cpuUsage{ calculateCPUUsage(pHandle, pd, systemTimes) };
             pd.setCpuUsage(cpuUsage);
             pd.updateMemCounters();
 
@@ -169,7 +175,7 @@ void ProcessMeasure::fillRAMData() {
     }
 }
 
-double ProcessMeasure::calculateCPUUsage(HANDLE pHandle, ProcessData& oldData) {
+double ProcessMeasure::calculateCPUUsage(HANDLE pHandle, ProcessData& oldData, const CPUTimes& systemTimes) {
     // Find delta in the process's total CPU usage time
     FILETIME cTime;
     FILETIME eTime;
@@ -180,17 +186,13 @@ double ProcessMeasure::calculateCPUUsage(HANDLE pHandle, ProcessData& oldData) {
     const auto procUserDiff{ subtractTimes(uTime, oldData.getUserTime()) };
     const auto totalProc{ procKernelDiff + procUserDiff };
 
-    // Find delta in the entire system's CPU usage time
-    FILETIME sysIdle, sysKernel, sysUser;
-    GetSystemTimes(&sysIdle, &sysKernel, &sysUser);
-    const auto sysKernelDiff{ subtractTimes(sysKernel, oldData.getLastSystemKernelTime()) };
-    const auto sysUserDiff{ subtractTimes(sysUser, oldData.getLastSystemUserTime()) };
-    const auto totalSys{ sysKernelDiff + sysUserDiff };
+    // Find delta in the entire system's CPU usage time. Processes found this update have no time to measure yet
+    const auto totalSys{ systemTimes.total() - oldData.getLastSystemTimes().total() };
 
     // Get the CPU usage as a percentage
-    const double cpuUse = static_cast<double>(100 * totalProc) / static_cast<double>(totalSys);
+    const double cpuUse{ totalSys == 0 ? 0.0 : static_cast<double>(100 * totalProc) / static_cast<double>(totalSys) };
 
-    oldData.setTimes(cTime, eTime, kTime, uTime);
+    oldData.setTimes(cTime, eTime, kTime, uTime, systemTimes);
 
     return cpuUse;
 }
@@ -214,6 +216,8 @@ void ProcessMeasure::populateList() {
         return;
     }
 
+    const auto& systemTimes{ m_systemTimes->get().total };
+
     // Loop over the process list and fill allProcessData with new ProcessData
     // object for each process
     for (; spi->NextEntryOffset;
@@ -235,7 +239,8 @@ void ProcessMeasure::populateList() {
             char* nameBuff = new char[spi->ImageName.Length];
             wcstombs_s(&charsConverted, nameBuff, spi->ImageName.Length, spi->ImageName.Buffer, spi->ImageName.Length);
 
-            m_allProcessData.emplace_back(std::make_unique<ProcessData>(pHandle, static_cast<DWORD>(procID), nameBuff));
+            m_allProcessData.emplace_back(
+                std::make_unique<ProcessData>(pHandle, static_cast<DWORD>(procID), nameBuff, systemTimes));
 
             delete[] nameBuff;
         }
@@ -262,6 +267,8 @@ void ProcessMeasure::detectNewProcesses() {
         return;
     }
 
+    const auto& systemTimes{ m_systemTimes->get().total };
+
     // Loop over the process list for any new processes
     // #TODO BUG: doesn't remove dead processes!
     // #TODO use a map of PID -> data instead, should have much more efficient lookups for existing processes.
@@ -291,8 +298,8 @@ void ProcessMeasure::detectNewProcesses() {
                 if (errCode) {
                     RGERROR(std::format("Failed to convert process name encoding: {}", errCode).c_str());
                 } else {
-                    m_allProcessData.emplace_back(
-                        std::make_unique<ProcessData>(pHandle, static_cast<DWORD>(procID), nameBuff.data()));
+                    m_allProcessData.emplace_back(std::make_unique<ProcessData>(pHandle, static_cast<DWORD>(procID),
+                                                                                nameBuff.data(), systemTimes));
                 }
             }
         }
@@ -15,7 +15,7 @@ namespace rg {
 /* Tracks system processes and their CPU/RAM usage */
 export class ProcessMeasure : public Measure {
 public:
-    ProcessMeasure();
+    explicit ProcessMeasure(std::shared_ptr<SystemTimes> systemTimes);
     ~ProcessMeasure() noexcept;
 
     size_t getNumProcessesRunning() const { return m_allProcessData.size(); }
@@ -43,8 +43,9 @@ private:
     /* Fills the RAM usage process vector with top RAM using processes */
     void fillRAMData();
 
-    /* Calculates the CPU usage of the given process */
-    double calculateCPUUsage(HANDLE pHandle, ProcessData& oldData);
+    /* Calculates the CPU usage of the given process since it was last updated, against the system times for this
+       update */
+    double calculateCPUUsage(HANDLE pHandle, ProcessData& oldData, const CPUTimes& systemTimes);
 
     /* Fills m_allProcessData with new process information */
     void populateList();
@@ -52,6 +53,7 @@ private:
     /* Polls window's process list to find any new processes and adds their process data to the list */
     void detectNewProcesses();
 
+    std::shared_ptr<SystemTimes> m_systemTimes;
     std::vector<std::unique_ptr<ProcessData>> m_allProcessData;
 
     int m_numCPUProcessesToDisplay;
@@ -1,5 +1,7 @@
 module RG.Measures:RAMMeasure;
 
+import RG.Core;
+
 namespace rg {
 
 RAMMeasure::RAMMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<const IRAMDataSource> ramDataSource)
@@ -7,7 +9,11 @@ RAMMeasure::RAMMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr
     , m_ramDataSource{ std::move(ramDataSource) } {}
 
 bool RAMMeasure::updateInternal() {
-    onRAMUsage.raise(m_ramDataSource->getRAMUsage());
+    const ProfileZone zone{ "RAMMeasure::updateInternal" };
+
+    const auto usage{ m_ramDataSource->getRAMUsage() };
+    onRAMUsage.raise(usage);
+    addAdaptiveSample(usage);
     return true;
 }
 
@@ -1,17 +1,27 @@
 module RG.Measures:TimeMeasure;
 
+import RG.Core;
+
 namespace rg {
 
 TimeMeasure::TimeMeasure(std::chrono::milliseconds updateInterval,
-                         std::unique_ptr<const ITimeDataSource> timeDataSource)
+                         std::unique_ptr<ITimeDataSource> timeDataSource)
     : Measure{ updateInterval }
     , m_timeDataSource{ std::move(timeDataSource) }
-    , m_timeData{ m_timeDataSource->getTimeData() } {}
+    , m_sourceGeneration{ 0U } {
+    m_timeDataSource->update();
+    m_sourceGeneration = m_timeDataSource->getGeneration();
+}
 
 bool TimeMeasure::updateInternal() {
-    const TimeData oldTimeData{ m_timeData };
-    m_timeData = m_timeDataSource->getTimeData();
-    return oldTimeData != m_timeData;
+    const ProfileZone zone{ "TimeMeasure::updateInternal" };
+
+    m_timeDataSource->update();
+    if (m_timeDataSource->getGeneration() == m_sourceGeneration)
+        return false;
+
+    m_sourceGeneration = m_timeDataSource->getGeneration();
+    return true;
 }
 
 } // namespace rg
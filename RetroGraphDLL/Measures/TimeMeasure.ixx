@@ -12,19 +12,19 @@ using namespace std::chrono;
 
 export class TimeMeasure : public Measure {
 public:
-    TimeMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<const ITimeDataSource> timeDataSource);
+    TimeMeasure(std::chrono::milliseconds updateInterval, std::unique_ptr<ITimeDataSource> timeDataSource);
     ~TimeMeasure() noexcept = default;
 
-    local_time<seconds> getLocalTime() const { return m_timeData.localTime; }
-    seconds getUptime() const { return m_timeData.uptime; }
+    local_time<seconds> getLocalTime() const { return m_timeDataSource->getTimeData().localTime; }
+    seconds getUptime() const { return m_timeDataSource->getTimeData().uptime; }
 
 protected:
     /* Updates each drive with new values */
     bool updateInternal() override;
 
 private:
-    std::unique_ptr<const ITimeDataSource> m_timeDataSource;
-    TimeData m_timeData;
+    std::unique_ptr<ITimeDataSource> m_timeDataSource;
+    uint64_t m_sourceGeneration;
 };
 
 } // namespace rg
@@ -0,0 +1,79 @@
+export module RG.Rendering:DamageRegion;
+
+import :Viewport;
+
+import std.core;
+
+namespace rg {
+
+/* The areas of the window that have changed since the last frame was presented.
+ * Either a set of rectangles, or the whole window when everything has to be drawn again (e.g. after the layout
+ * changes, or when the back buffer isn't kept between frames).
+ */
+export class DamageRegion {
+public:
+    void add(const Viewport& rect) {
+        if (rect.width > 0 && rect.height > 0)
+            m_rects.push_back(rect);
+    }
+
+    void addAll() { m_full = true; }
+
+    /* Starts the next frame with no damage. Keeps the rect storage so adding damage doesn't allocate every frame */
+    void clear() {
+        m_rects.clear();
+        m_full = false;
+    }
+
+    bool isEmpty() const { return !m_full && m_rects.empty(); }
+    bool isFull() const { return m_full; }
+    const std::vector<Viewport>& getRects() const { return m_rects; }
+
+    bool intersects(const Viewport& rect) const {
+        if (m_full)
+            return true;
+
+        return std::any_of(m_rects.cbegin(), m_rects.cend(), [&rect](const Viewport& damage) {
+            return rect.x < damage.x + damage.width && damage.x < rect.x + rect.width &&
+                   rect.y < damage.y + damage.height && damage.y < rect.y + rect.height;
+        });
+    }
+
+    /* Gets the smallest rect containing all of the damage */
+    Viewport getBounds(int windowWidth, int windowHeight) const {
+        if (m_full)
+            return { 0, 0, windowWidth, windowHeight };
+        if (m_rects.empty())
+            return {};
+
+        auto left{ m_rects.front().x };
+        auto bottom{ m_rects.front().y };
+        auto right{ left + m_rects.front().width };
+        auto top{ bottom + m_rects.front().height };
+        for (const auto& rect : m_rects) {
+            left = std::min(left, rect.x);
+            bottom = std::min(bottom, rect.y);
+            right = std::max(right, rect.x + rect.width);
+            top = std::max(top, rect.y + rect.height);
+        }
+
+        return { left, bottom, right - left, top - bottom };
+    }
+
+    /* Gets the number of pixels that are drawn to present the damage. Damage rects come from widgets, which don't
+     * overlap, so their areas are summed */
+    int64_t getNumPixels(int windowWidth, int windowHeight) const {
+        if (m_full)
+            return static_cast<int64_t>(windowWidth) * windowHeight;
+
+        return std::accumulate(m_rects.cbegin(), m_rects.cend(), int64_t{ 0 }, [](int64_t sum, const Viewport& rect) {
+            return sum + static_cast<int64_t>(rect.width) * rect.height;
+        });
+    }
+
+private:
+    std::vector<Viewport> m_rects;
+    bool m_full{ false };
+};
+
+} // namespace rg
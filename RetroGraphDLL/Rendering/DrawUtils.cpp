@@ -81,14 +81,23 @@ void drawSerifLine(GLfloat x1, GLfloat x2, GLfloat y) {
     glEnd();
 }
 
+// Kept in sync with the GL viewport by setGLViewport, so reading the viewport doesn't need a round trip to GL
+Viewport currentViewport{};
+GLint viewportOriginX{ 0 };
+GLint viewportOriginY{ 0 };
+
 void setGLViewport(const Viewport& vp) {
-    glViewport(vp.x, vp.y, vp.width, vp.height);
+    currentViewport = vp;
+    glViewport(vp.x - viewportOriginX, vp.y - viewportOriginY, vp.width, vp.height);
+}
+
+void setGLViewportOrigin(GLint x, GLint y) {
+    viewportOriginX = x;
+    viewportOriginY = y;
 }
 
 Viewport getGLViewport() {
-    GLint vp[4];
-    glGetIntegerv(GL_VIEWPORT, vp);
-    return { vp[0], vp[1], vp[2], vp[3] };
+    return currentViewport;
 }
 
 GLenum checkGLErrors() {
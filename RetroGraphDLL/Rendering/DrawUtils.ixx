@@ -33,10 +33,17 @@ export void drawHorizontalProgressBar(float barWidth, float startX, float endX,
 // Primitive drawing
 export void drawSerifLine(GLfloat x1, GLfloat x2, GLfloat y);
 
+/* The viewport must always be set through setGLViewport rather than glViewport, so getGLViewport can return it
+   without querying GL */
 export void setGLViewport(const Viewport& vp);
 
 export Viewport getGLViewport();
 
+/* Sets the window position of the bottom left corner of the framebuffer being drawn to, for offscreen framebuffers
+   that cover part of the window. Viewports are still given in window coordinates, and setGLViewport offsets them
+   into the framebuffer */
+export void setGLViewportOrigin(GLint x, GLint y);
+
 export GLenum checkGLErrors();
 
 export constexpr inline float clampToViewport(float f) {
@@ -2,13 +2,20 @@ module RG.Rendering:FontManager;
 
 import :DrawUtils;
 
+import Colors;
+
+import RG.Core;
+
 import "GLHeaderUnit.h";
 import "RGAssert.h";
 
 namespace rg {
 
 FontManager::FontManager(HWND hWnd, int windowHeight)
-    : m_hWnd{ hWnd } {
+    : m_hWnd{ hWnd }
+    , m_textColor{ TEXT_R, TEXT_G, TEXT_B, TEXT_A } {
+    m_glyphs.reserve(maxGlyphsPerDraw);
+    initGlyphVAO();
     initFonts(windowHeight);
 }
 
@@ -17,9 +24,11 @@ FontManager::~FontManager() {
 }
 
 void FontManager::release() {
-    for (const auto base : m_fontBases) {
-        glDeleteLists(base, RG_NUM_CHARS_IN_FONT);
-    }
+    m_glyphAtlas.release();
+    m_glyphs.clear();
+
+    // Cached layouts were measured with the old fonts
+    m_layoutCache.clear();
 }
 
 void FontManager::refreshFonts(int newWindowHeight) {
@@ -27,128 +36,186 @@ void FontManager::refreshFonts(int newWindowHeight) {
     initFonts(newWindowHeight);
 }
 
+void FontManager::initGlyphVAO() {
+    auto vaoScope{ m_glyphVAO.bind() };
+    auto vboScope{ m_glyphVBO.bind() };
+
+    // One instance per glyph. The quad's corners are generated from gl_VertexID in text.vert
+    const auto setInstanceAttrib = [](GLuint index, GLint size, size_t offset) {
+        glEnableVertexAttribArray(index);
+        glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(index, 1);
+    };
+    setInstanceAttrib(0, 2, offsetof(GlyphInstance, position));
+    setInstanceAttrib(1, 2, offsetof(GlyphInstance, size));
+    setInstanceAttrib(2, 2, offsetof(GlyphInstance, texel));
+    setInstanceAttrib(3, 4, offsetof(GlyphInstance, color));
+}
+
 void FontManager::renderLine(GLfloat rasterX, GLfloat rasterY, RGFONTCODE fontCode, const char* text) const {
     renderLine(rasterX, rasterY, fontCode, text, static_cast<int>(strlen(text)));
 }
 
 void FontManager::renderLine(GLfloat rasterX, GLfloat rasterY, RGFONTCODE fontCode, const char* text,
                              int textLen) const {
-    glRasterPos2f(rasterX, rasterY);
+    const ProfileZone zone{ "FontManager::renderLine" };
 
-    glListBase(m_fontBases[fontCode]);
-    glCallLists(textLen, GL_UNSIGNED_BYTE, text);
+    const auto vp{ getGLViewport() };
+    addGlyphs(m_glyphs, fontCode, { text, static_cast<size_t>(textLen) }, vp.x + vpCoordsToPixels(rasterX, vp.width),
+              vp.y + vpCoordsToPixels(rasterY, vp.height), m_textColor);
 }
 
 void FontManager::renderLine(RGFONTCODE fontCode, std::string_view text, int areaX, int areaY, int areaWidth,
                              int areaHeight, int alignFlags, int alignMarginX /*=10U*/,
                              int alignMarginY /*=10U*/) const {
-    GLint vp[4];
-    glGetIntegerv(GL_VIEWPORT, vp);
-
-    // Set the area to viewport if default values are given
-    if (areaWidth == 0 && areaHeight == 0 && areaX == 0 && areaY == 0) {
-        areaWidth = vp[2];
-        areaHeight = vp[3];
-    } else {
-        glViewport(vp[0] + areaX, vp[1] + areaY, areaWidth, areaHeight);
-    }
-
-    const auto fontHeightPx{ m_fontCharHeights[fontCode] };
+    const ProfileZone zone{ "FontManager::renderLine" };
 
-    // Handle vertical alignment
-    auto rasterY = float{ 0.0f };
-    if (alignFlags & RG_ALIGN_CENTERED_VERTICAL) {
-        const auto drawYMidPx{ (areaHeight - fontHeightPx) / 2 };
-        rasterY = pixelsToVPCoords(drawYMidPx + m_fontCharDescents[fontCode], areaHeight);
-    } else if (alignFlags & RG_ALIGN_BOTTOM) {
-        rasterY = pixelsToVPCoords(alignMarginY + m_fontCharDescents[fontCode], areaHeight);
-    } else if (alignFlags & RG_ALIGN_TOP) {
-        rasterY = pixelsToVPCoords(areaHeight - m_fontCharAscents[fontCode] - alignMarginY, areaHeight);
-    }
+    const auto area{ getRenderArea(getGLViewport(), areaX, areaY, areaWidth, areaHeight) };
+    const auto rasterYPx{ getRasterYAlignment(fontCode, alignFlags, area.height, alignMarginY) };
 
-    const auto maxStrLenPx{ areaWidth - alignMarginX };
-    auto strWidthPx{ calculateStringWidth(text, fontCode) };
-    const std::string& toRender{ (strWidthPx > maxStrLenPx) ? getTruncated(fontCode, text, maxStrLenPx)
-                                                            : std::string{ text } };
-    if (strWidthPx > maxStrLenPx)
-        strWidthPx = calculateStringWidth(toRender, fontCode);
+    addLineGlyphs(m_glyphs, fontCode, text, area, alignFlags, alignMarginX, rasterYPx, m_textColor);
+}
 
-    const auto rasterX{ getRasterXAlignment(alignFlags, strWidthPx, areaWidth, alignMarginX) };
+void FontManager::renderLine(RGFONTCODE fontCode, const TextRun& run, int areaX, int areaY, int areaWidth,
+                             int areaHeight, int alignFlags, int alignMarginX /*=10U*/,
+                             int alignMarginY /*=10U*/) const {
+    const ProfileZone zone{ "FontManager::renderLine" };
 
-    glRasterPos2f(rasterX, rasterY);
-    glListBase(m_fontBases[fontCode]);
-    glCallLists(static_cast<GLsizei>(toRender.size()), GL_UNSIGNED_BYTE, toRender.data());
+    const auto area{ getRenderArea(getGLViewport(), areaX, areaY, areaWidth, areaHeight) };
+    const auto rasterYPx{ getRasterYAlignment(fontCode, alignFlags, area.height, alignMarginY) };
 
-    glViewport(vp[0], vp[1], vp[2], vp[3]);
+    addRunGlyphs(run, fontCode, area, alignFlags, alignMarginX, rasterYPx);
 }
 
 void FontManager::renderLines(RGFONTCODE fontCode, const std::vector<std::string>& lines, int areaX, int areaY,
                               int areaWidth, int areaHeight, int alignFlags, int alignMarginX /*=10U*/,
                               int alignMarginY /*=10U*/) const {
-    GLint vp[4];
-    glGetIntegerv(GL_VIEWPORT, vp);
-
-    /* If width and height are given default values, use the current viewport
-       as area */
-    if (areaWidth == 0 && areaHeight == 0 && areaX == 0 && areaY == 0) {
-        areaWidth = vp[2];
-        areaHeight = vp[3];
-    } else {
-        glViewport(vp[0] + areaX, vp[1] + areaY, areaWidth, areaHeight);
-    }
+    const ProfileZone zone{ "FontManager::renderLines" };
+
+    const auto area{ getRenderArea(getGLViewport(), areaX, areaY, areaWidth, areaHeight) };
 
-    const auto maxStrLenPx{ areaWidth - alignMarginX };
     auto [rasterYPx, rasterLineDeltaY, maxRenderableLines] =
-        calculateLinesRenderParameters(static_cast<int>(lines.size()), fontCode, alignFlags, areaHeight, alignMarginY);
+        calculateLinesRenderParameters(static_cast<int>(lines.size()), fontCode, alignFlags, area.height, alignMarginY);
 
     // Start at top, render downwards
     for (int i{ 0 }; i < maxRenderableLines; ++i) {
-        const auto& str{ lines[i] };
-        auto strWidthPx{ calculateStringWidth(str, fontCode) };
-        const std::string& toRender{ (strWidthPx > maxStrLenPx) ? getTruncated(fontCode, str, maxStrLenPx) : str };
-        if (strWidthPx > maxStrLenPx)
-            strWidthPx = calculateStringWidth(toRender, fontCode);
+        addLineGlyphs(m_glyphs, fontCode, lines[i], area, alignFlags, alignMarginX, rasterYPx, m_textColor);
+
+        // Set the raster position to the next line
+        rasterYPx -= rasterLineDeltaY;
+    }
+}
 
-        const auto rasterX{ getRasterXAlignment(alignFlags, strWidthPx, areaWidth, alignMarginX) };
-        const auto rasterY{ pixelsToVPCoords(rasterYPx, areaHeight) };
+void FontManager::renderLines(RGFONTCODE fontCode, std::span<const TextRun> lines, int areaX, int areaY,
+                              int areaWidth, int areaHeight, int alignFlags, int alignMarginX /*=10U*/,
+                              int alignMarginY /*=10U*/) const {
+    const ProfileZone zone{ "FontManager::renderLines" };
 
-        // Draw the string
-        glRasterPos2f(rasterX, rasterY);
-        glListBase(m_fontBases[fontCode]);
-        glCallLists(static_cast<GLsizei>(toRender.size()), GL_UNSIGNED_BYTE, toRender.c_str());
+    const auto area{ getRenderArea(getGLViewport(), areaX, areaY, areaWidth, areaHeight) };
 
-        // Set the raster position to the next line
+    auto [rasterYPx, rasterLineDeltaY, maxRenderableLines] =
+        calculateLinesRenderParameters(static_cast<int>(lines.size()), fontCode, alignFlags, area.height, alignMarginY);
+
+    for (int i{ 0 }; i < maxRenderableLines; ++i) {
+        addRunGlyphs(lines[i], fontCode, area, alignFlags, alignMarginX, rasterYPx);
         rasterYPx -= rasterLineDeltaY;
     }
+}
+
+Viewport FontManager::getRenderArea(const Viewport& vp, int areaX, int areaY, int areaWidth, int areaHeight) const {
+    // Use the whole viewport as the area if default values are given
+    if (areaWidth == 0 && areaHeight == 0 && areaX == 0 && areaY == 0)
+        return vp;
+
+    return { vp.x + areaX, vp.y + areaY, areaWidth, areaHeight };
+}
+
+const TextLayout& FontManager::getLayout(RGFONTCODE fontCode, std::string_view text, int maxWidthPx) const {
+    return m_layoutCache.get(fontCode, m_fontCharWidths[fontCode], text, maxWidthPx);
+}
+
+int FontManager::addGlyphs(std::vector<GlyphInstance>& glyphs, RGFONTCODE fontCode, std::string_view text, int x,
+                           int y, const glm::vec4& color) const {
+    // Glyph rects are the full height of the font, so the bottom sits on the descent line
+    const auto bottomY{ static_cast<float>(y - m_fontCharDescents[fontCode]) };
+    auto penX{ static_cast<float>(x) };
+    for (const char c : text) {
+        const auto& rect{ m_glyphAtlas.getGlyphRect(fontCode, static_cast<unsigned char>(c)) };
+        glyphs.push_back(GlyphInstance{ { penX, bottomY },
+                                        { static_cast<float>(rect.width), static_cast<float>(rect.height) },
+                                        { static_cast<float>(rect.x), static_cast<float>(rect.y) },
+                                        color });
+        penX += rect.width;
+    }
+
+    return static_cast<int>(penX);
+}
+
+void FontManager::addLineGlyphs(std::vector<GlyphInstance>& glyphs, RGFONTCODE fontCode, std::string_view text,
+                                const Viewport& area, int alignFlags, int alignMarginX, int rasterYPx,
+                                const glm::vec4& color) const {
+    const auto& layout{ getLayout(fontCode, text, area.width - alignMarginX) };
+    const auto x{ area.x + getRasterXAlignment(alignFlags, layout.widthPx, area.width, alignMarginX) };
+    const auto y{ area.y + rasterYPx };
+
+    const auto penX{ addGlyphs(glyphs, fontCode, text.substr(0, layout.visibleLength), x, y, color) };
+    if (layout.ellipsis)
+        addGlyphs(glyphs, fontCode, textLayoutEllipsis, penX, y, color);
+}
+
+void FontManager::addRunGlyphs(const TextRun& run, RGFONTCODE fontCode, const Viewport& area, int alignFlags,
+                               int alignMarginX, int rasterYPx) const {
+    const TextPlacement placement{ fontCode, area, alignFlags, alignMarginX, rasterYPx, m_textColor,
+                                   m_fontGeneration };
+    const auto runGlyphs{ run.getGlyphs(placement, [&](std::string_view text, std::vector<GlyphInstance>& glyphs) {
+        addLineGlyphs(glyphs, fontCode, text, area, alignFlags, alignMarginX, rasterYPx, placement.color);
+    }) };
+
+    m_glyphs.insert(m_glyphs.end(), runGlyphs.begin(), runGlyphs.end());
+}
+
+void FontManager::drawText() const {
+    const ProfileZone zone{ "FontManager::drawText" };
+
+    if (m_glyphs.empty())
+        return;
 
-    glViewport(vp[0], vp[1], vp[2], vp[3]);
-}
-
-std::string FontManager::getTruncated(RGFONTCODE fontCode, std::string_view str, int maxLengthPx) const {
-    char newText[255];
-
-    // Copy char by char into the new buffer while there is enough width
-    auto newStrWidthPx = int{ 0U };
-    for (auto i = size_t{ 0U }; i < str.size(); ++i) {
-        newText[i] = str[i];
-        newStrWidthPx += m_fontCharWidths[fontCode][newText[i]];
-
-        // If we've gone over, remove last character and replace chars before
-        // with ellipses
-        if (newStrWidthPx > maxLengthPx) {
-            // Ensure there are enough characters to put in ellipses
-            if (i > 2) {
-                newText[i] = '\0';
-                newText[i - 1] = '.';
-                newText[i - 2] = '.';
-            } else {
-                newText[i] = '\0';
-            }
-            return { newText, i };
-        }
+    // Glyph positions are in window pixels, so draw over the whole window
+    RECT clientRect;
+    GetClientRect(m_hWnd, &clientRect);
+    setGLViewport({ 0, 0, clientRect.right - clientRect.left, clientRect.bottom - clientRect.top });
+
+    auto shaderScope{ m_textShader.bind() };
+    glUniform2f(m_textShader.getUniformLocation("windowSize"), static_cast<float>(clientRect.right - clientRect.left),
+                static_cast<float>(clientRect.bottom - clientRect.top));
+    glUniform2f(m_textShader.getUniformLocation("atlasSize"), static_cast<float>(m_glyphAtlas.getWidth()),
+                static_cast<float>(m_glyphAtlas.getHeight()));
+    glUniform1i(m_textShader.getUniformLocation("atlas"), 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_glyphAtlas.getTextureID());
+    auto vaoScope{ m_glyphVAO.bind() };
+
+    // Normally every glyph fits in one draw. If not, the rest are drawn in further draws
+    for (size_t first{ 0 }; first < m_glyphs.size(); first += maxGlyphsPerDraw) {
+        const auto count{ std::min(maxGlyphsPerDraw, m_glyphs.size() - first) };
+
+        // Every widget's text goes into the same region until it fills up, so drawing each widget's text doesn't
+        // wait for the GPU to finish with the text of widgets drawn just before it
+        auto* const data{ m_glyphVBO.beginAppend(static_cast<GLsizeiptr>(count * sizeof(GlyphInstance))) };
+        if (!data)
+            break;
+
+        std::memcpy(data, &m_glyphs[first], count * sizeof(GlyphInstance));
+        m_glyphVBO.endWrite();
+
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count),
+                                          m_glyphVBO.firstVertex(sizeof(GlyphInstance)));
+        m_glyphVBO.fenceDraw();
     }
 
-    return newText;
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_glyphs.clear();
 }
 
 void FontManager::initFonts(int windowHeight) {
@@ -172,18 +239,20 @@ void FontManager::initFonts(int windowHeight) {
 
     createFont(standardFontHeight, FW_BOLD, typefaces[7], RG_FONT_MUSIC);
 
-    // Set default font
-    glListBase(m_fontBases[RG_FONT_STANDARD]);
+    m_glyphAtlas.upload();
+
+    // Retained text runs were laid out with the old fonts
+    ++m_fontGeneration;
 }
 
 void FontManager::createFont(int fontHeight, int weight, const char* typeface, RGFONTCODE code) {
+    RGASSERT(code == m_glyphAtlas.getNumFonts(), "Fonts must be created in the order of their font codes");
     const auto hdc{ GetDC(m_hWnd) };
 
-    m_fontBases[code] = glGenLists(RG_NUM_CHARS_IN_FONT);
     HFONT hFont = CreateFontA(fontHeight, 0, 0, 0, weight, FALSE, FALSE, FALSE, ANSI_CHARSET, OUT_TT_PRECIS,
                               CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY, DEFAULT_PITCH | FF_DONTCARE, typeface);
     SelectObject(hdc, hFont);
-    wglUseFontBitmaps(hdc, 0, RG_NUM_CHARS_IN_FONT, m_fontBases[code]);
+    m_glyphAtlas.addFont(hdc, hFont);
 
     setFontCharacteristics(code, hdc);
     ReleaseDC(m_hWnd, hdc);
@@ -203,19 +272,6 @@ void FontManager::setFontCharacteristics(RGFONTCODE c, HDC hdc) {
     m_fontCharInternalLeadings[c] = tm.tmInternalLeading;
 }
 
-int FontManager::calculateStringWidth(std::string_view text, RGFONTCODE c) const {
-    auto strWidthPx = int{ 0 };
-    for (auto i = size_t{ 0U }; i < text.size(); ++i) {
-        // Make sure the character is in range, if not, add default value
-        if (text[i] > RG_NUM_CHARS_IN_FONT || text[i] < 0) {
-            strWidthPx += m_fontCharWidths[c]['A'];
-        } else {
-            strWidthPx += m_fontCharWidths[c][text[i]];
-        }
-    }
-    return strWidthPx;
-}
-
 std::tuple<int, int, int> FontManager::calculateLinesRenderParameters(int numLines, RGFONTCODE code, int alignFlags,
                                                                       int areaHeight, int marginY) const {
     const auto renderHeight{ areaHeight - marginY * 2 };
@@ -239,16 +295,27 @@ std::tuple<int, int, int> FontManager::calculateLinesRenderParameters(int numLin
     return { rasterYPx, rasterLineDeltaY, maxRenderableLines };
 }
 
-float FontManager::getRasterXAlignment(int alignFlags, int strWidthPx, int areaWidth, int alignMargin) const {
+int FontManager::getRasterYAlignment(RGFONTCODE fontCode, int alignFlags, int areaHeight, int alignMargin) const {
+    if (alignFlags & RG_ALIGN_CENTERED_VERTICAL) {
+        const auto drawYMidPx{ (areaHeight - m_fontCharHeights[fontCode]) / 2 };
+        return drawYMidPx + m_fontCharDescents[fontCode];
+    } else if (alignFlags & RG_ALIGN_BOTTOM) {
+        return alignMargin + m_fontCharDescents[fontCode];
+    } else if (alignFlags & RG_ALIGN_TOP) {
+        return areaHeight - m_fontCharAscents[fontCode] - alignMargin;
+    }
+    return 0;
+}
+
+int FontManager::getRasterXAlignment(int alignFlags, int strWidthPx, int areaWidth, int alignMargin) const {
     if (alignFlags & RG_ALIGN_CENTERED_HORIZONTAL) {
-        const auto drawXPx{ (areaWidth - strWidthPx) / 2 };
-        return pixelsToVPCoords(drawXPx, areaWidth);
+        return (areaWidth - strWidthPx) / 2;
     } else if (alignFlags & RG_ALIGN_LEFT) {
-        return pixelsToVPCoords(alignMargin, areaWidth);
+        return alignMargin;
     } else if (alignFlags & RG_ALIGN_RIGHT) {
-        return pixelsToVPCoords(areaWidth - strWidthPx - alignMargin, areaWidth);
+        return areaWidth - strWidthPx - alignMargin;
     }
-    return 0.0f;
+    return areaWidth / 2;
 }
 
 } // namespace rg
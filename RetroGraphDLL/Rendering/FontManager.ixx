@@ -1,5 +1,13 @@
 export module RG.Rendering:FontManager;
 
+import :GlyphAtlas;
+import :Shader;
+import :StreamingVBO;
+import :TextLayout;
+import :TextRun;
+import :VAO;
+import :Viewport;
+
 import std.core;
 
 import "GLHeaderUnit.h";
@@ -30,6 +38,10 @@ export enum RGFontCode : char {
 
 export constexpr size_t RG_NUM_CHARS_IN_FONT{ 256 };
 
+/* Renders text from a glyph atlas holding every font.
+ * Rendering a line only lays out its glyphs on the CPU. The glyphs of every line rendered since the last call to
+ * drawText() are drawn together in a single instanced draw call.
+ */
 export class FontManager {
 public:
     FontManager(HWND hWnd, int windowHeight);
@@ -67,15 +79,38 @@ public:
                     int alignFlags = RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL, int alignMarginX = 10U,
                     int alignMarginY = 10U) const;
 
+    /* Renders a retained text run with the same rules as above. The run's glyphs are only laid out again if its
+       text, the area, alignment, colour or fonts have changed since it was last rendered */
+    void renderLine(RGFONTCODE fontCode, const TextRun& run, int areaX, int areaY, int areaWidth, int areaHeight,
+                    int alignFlags = RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL, int alignMarginX = 10U,
+                    int alignMarginY = 10U) const;
+
     /* Renders multiple lines. Assumes lines.size() > 1
      * Lines that will not fit in the given space will not be rendered.
      */
     void renderLines(RGFONTCODE fontCode, const std::vector<std::string>& lines, int areaX, int areaY, int areaWidth,
                      int areaHeight, int alignFlags = RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL,
                      int alignMarginX = 10U, int alignMarginY = 10U) const;
+    void renderLines(RGFONTCODE fontCode, std::span<const TextRun> lines, int areaX, int areaY, int areaWidth,
+                     int areaHeight, int alignFlags = RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL,
+                     int alignMarginX = 10U, int alignMarginY = 10U) const;
+
+    /* Sets the colour that text rendered from now on is drawn in */
+    void setTextColor(const glm::vec4& color) const { m_textColor = color; }
+
+    /* Draws all text rendered since the last call into the current framebuffer. Called after drawing each widget,
+       so the widget's text ends up in its render cache */
+    void drawText() const;
+
+    /* Gets the fraction of lines whose layout was found in the layout cache */
+    double getLayoutCacheHitRate() const { return m_layoutCache.hitRate(); }
 
 private:
+    static constexpr size_t maxGlyphsPerDraw{ 4096 };
+    static constexpr size_t layoutCacheCapacity{ 512 };
+
     void initFonts(int windowHeight);
+    void initGlyphVAO();
 
     /* Releases font resources */
     void release();
@@ -84,15 +119,37 @@ private:
        character width/pixel information */
     void createFont(int fontHeight, int weight, const char* typeface, RGFONTCODE code);
     void setFontCharacteristics(RGFONTCODE c, HDC hdc);
-    int calculateStringWidth(std::string_view text, RGFONTCODE c) const;
-    std::string getTruncated(RGFONTCODE fontCode, std::string_view str, int maxLengthPx) const;
+    const TextLayout& getLayout(RGFONTCODE fontCode, std::string_view text, int maxWidthPx) const;
     std::tuple<int, int, int> calculateLinesRenderParameters(int numLines, RGFONTCODE code, int alignFlags,
                                                              int areaHeight, int marginY) const;
-    float getRasterXAlignment(int alignFlags, int strWidthPx, int areaWidth, int alignMargin) const;
+    int getRasterXAlignment(int alignFlags, int strWidthPx, int areaWidth, int alignMargin) const;
+    int getRasterYAlignment(RGFONTCODE fontCode, int alignFlags, int areaHeight, int alignMargin) const;
+    Viewport getRenderArea(const Viewport& vp, int areaX, int areaY, int areaWidth, int areaHeight) const;
+
+    /* Lays out the glyphs of text into glyphs with the pen starting at x and the baseline at y, in window pixels.
+       Returns the pen position after the text */
+    int addGlyphs(std::vector<GlyphInstance>& glyphs, RGFONTCODE fontCode, std::string_view text, int x, int y,
+                  const glm::vec4& color) const;
+
+    /* Lays out the glyphs of a line of text within the area, truncating the text if it doesn't fit */
+    void addLineGlyphs(std::vector<GlyphInstance>& glyphs, RGFONTCODE fontCode, std::string_view text,
+                       const Viewport& area, int alignFlags, int alignMarginX, int rasterYPx,
+                       const glm::vec4& color) const;
+
+    /* Adds the glyphs of a retained run, laying them out again first if anything they depend on has changed */
+    void addRunGlyphs(const TextRun& run, RGFONTCODE fontCode, const Viewport& area, int alignFlags, int alignMarginX,
+                      int rasterYPx) const;
 
     HWND m_hWnd{ nullptr };
-    std::array<GLuint, RG_NUM_FONTS> m_fontBases{};
-    std::array<std::array<int, RG_NUM_CHARS_IN_FONT>, RG_NUM_FONTS> m_fontCharWidths{};
+    GlyphAtlas m_glyphAtlas;
+    Shader m_textShader{ "text" };
+    VAO m_glyphVAO;
+    StreamingVBO m_glyphVBO{ maxGlyphsPerDraw * sizeof(GlyphInstance) };
+    mutable std::vector<GlyphInstance> m_glyphs;
+    mutable glm::vec4 m_textColor;
+    mutable TextLayoutCache m_layoutCache{ layoutCacheCapacity };
+    std::array<GlyphWidths, RG_NUM_FONTS> m_fontCharWidths{};
+    uint32_t m_fontGeneration{ 0 };
     std::array<int, RG_NUM_FONTS> m_fontCharHeights{};
     std::array<int, RG_NUM_FONTS> m_fontCharAscents{};
     std::array<int, RG_NUM_FONTS> m_fontCharDescents{};
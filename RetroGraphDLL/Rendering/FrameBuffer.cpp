@@ -0,0 +1,64 @@
+module RG.Rendering:FrameBuffer;
+
+import RG.Core;
+
+import "GLHeaderUnit.h";
+import "RGAssert.h";
+
+namespace rg {
+
+FrameBuffer::~FrameBuffer() {
+    release();
+}
+
+void FrameBuffer::release() {
+    if (m_frameBufferID != invalidGLID) {
+        glDeleteFramebuffers(1, &m_frameBufferID);
+        glDeleteRenderbuffers(1, &m_colorBufferID);
+        m_frameBufferID = invalidGLID;
+        m_colorBufferID = invalidGLID;
+    }
+}
+
+bool FrameBuffer::setArea(const Viewport& area) {
+    const bool sizeChanged{ area.width != m_area.width || area.height != m_area.height };
+    m_area = area;
+    if (!sizeChanged && !isEmpty())
+        return false;
+
+    release();
+    if (area.width <= 0 || area.height <= 0)
+        return false;
+
+    // Blitting between multisampled buffers needs both to have the same number of samples
+    GLint windowSamples{ 0 };
+    glGetIntegerv(GL_SAMPLES, &windowSamples);
+
+    glGenRenderbuffers(1, &m_colorBufferID);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBufferID);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, windowSamples, GL_RGBA8, area.width, area.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_frameBufferID);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferID);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBufferID);
+    RGASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Incomplete widget framebuffer");
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+void FrameBuffer::blitToWindow() const {
+    const ProfileZone zone{ "FrameBuffer::blitToWindow" };
+
+    if (isEmpty())
+        return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_frameBufferID);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, m_area.width, m_area.height, m_area.x, m_area.y, m_area.x + m_area.width,
+                      m_area.y + m_area.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+} // namespace rg
@@ -0,0 +1,61 @@
+export module RG.Rendering:FrameBuffer;
+
+import :DrawUtils;
+import :Viewport;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+export class [[nodiscard]] FrameBufferBindScope {
+public:
+    FrameBufferBindScope(GLuint id, const Viewport& area) {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, id);
+        setGLViewportOrigin(area.x, area.y);
+    }
+    ~FrameBufferBindScope() {
+        setGLViewportOrigin(0, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    }
+    FrameBufferBindScope(const FrameBufferBindScope&) = delete;
+    FrameBufferBindScope& operator=(const FrameBufferBindScope&) = delete;
+    FrameBufferBindScope(FrameBufferBindScope&&) = delete;
+    FrameBufferBindScope& operator=(FrameBufferBindScope&&) = delete;
+};
+
+/* An offscreen colour buffer covering an area of the window.
+ * While it's bound, drawing goes into the buffer with viewports still given in window coordinates. The buffer has
+ * the same number of samples as the window, so it can be copied into its area of the window with a single blit and
+ * looks the same as if it was drawn to the window directly.
+ */
+export class FrameBuffer {
+public:
+    FrameBuffer() = default;
+    ~FrameBuffer();
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+    FrameBuffer(FrameBuffer&&) = delete;
+    FrameBuffer& operator=(FrameBuffer&&) = delete;
+
+    /* Moves the buffer to cover the given area, recreating it if the size changed. Returns true if the buffer was
+       recreated, in which case its contents are undefined. Must be called while the window's framebuffer is bound */
+    bool setArea(const Viewport& area);
+
+    FrameBufferBindScope bind() const { return { m_frameBufferID, m_area }; }
+
+    /* Copies the buffer into its area of the window */
+    void blitToWindow() const;
+
+    bool isEmpty() const { return m_frameBufferID == invalidGLID; }
+
+private:
+    void release();
+
+    GLuint m_frameBufferID{ invalidGLID };
+    GLuint m_colorBufferID{ invalidGLID };
+    Viewport m_area{};
+};
+
+} // namespace rg
@@ -0,0 +1,110 @@
+module RG.Rendering:GlyphAtlas;
+
+import "GLHeaderUnit.h";
+import "RGAssert.h";
+
+namespace rg {
+
+GlyphAtlas::~GlyphAtlas() {
+    release();
+}
+
+void GlyphAtlas::release() {
+    if (m_textureID != invalidGLID) {
+        glDeleteTextures(1, &m_textureID);
+        m_textureID = invalidGLID;
+    }
+
+    m_glyphRects.clear();
+    m_pendingFonts.clear();
+    m_width = 0;
+    m_height = 0;
+}
+
+void GlyphAtlas::addFont(HDC hdc, HFONT font) {
+    const auto memDC{ CreateCompatibleDC(hdc) };
+    const auto oldFont{ SelectObject(memDC, font) };
+
+    TEXTMETRIC tm;
+    GetTextMetrics(memDC, &tm);
+    std::array<int, numGlyphs> advanceWidths;
+    GetCharWidth32(memDC, 0, numGlyphs - 1, advanceWidths.data());
+
+    const int cellWidth{ tm.tmMaxCharWidth + tm.tmOverhang };
+    const int cellHeight{ tm.tmHeight };
+    const int bitmapWidth{ cellWidth * glyphsPerRow };
+    const int bitmapHeight{ cellHeight * (numGlyphs / glyphsPerRow) };
+
+    // Draw white glyphs on black into a top-down 32 bit DIB. Antialiased glyphs come out greyscale, so any
+    // channel can be used as the coverage
+    BITMAPINFO bmi{};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = bitmapWidth;
+    bmi.bmiHeader.biHeight = -bitmapHeight;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits{ nullptr };
+    const auto bitmap{ CreateDIBSection(memDC, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0) };
+    RGASSERT(bitmap && bits, "Failed to create glyph bitmap");
+    const auto oldBitmap{ SelectObject(memDC, bitmap) };
+
+    SetTextColor(memDC, RGB(255, 255, 255));
+    SetBkMode(memDC, TRANSPARENT);
+
+    const auto fontY{ m_height };
+    auto& glyphRects{ m_glyphRects.emplace_back() };
+    for (int i{ 0 }; i < numGlyphs; ++i) {
+        const int cellX{ (i % glyphsPerRow) * cellWidth };
+        const int cellY{ (i / glyphsPerRow) * cellHeight };
+        const char c{ static_cast<char>(i) };
+        TextOutA(memDC, cellX, cellY, &c, 1);
+
+        glyphRects[i] = { cellX, fontY + cellY, advanceWidths[i], cellHeight };
+    }
+    GdiFlush();
+
+    FontBitmap fontBitmap{ bitmapWidth, bitmapHeight, std::vector<uint8_t>(bitmapWidth * bitmapHeight) };
+    const auto* pixels{ static_cast<const uint32_t*>(bits) };
+    std::transform(pixels, pixels + fontBitmap.texels.size(), fontBitmap.texels.begin(),
+                   [](uint32_t pixel) { return static_cast<uint8_t>(pixel & 0xFF); });
+    m_pendingFonts.push_back(std::move(fontBitmap));
+
+    m_width = std::max(m_width, bitmapWidth);
+    m_height += bitmapHeight;
+
+    SelectObject(memDC, oldBitmap);
+    SelectObject(memDC, oldFont);
+    DeleteObject(bitmap);
+    DeleteDC(memDC);
+}
+
+void GlyphAtlas::upload() {
+    if (m_textureID == invalidGLID)
+        glGenTextures(1, &m_textureID);
+
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+    // Glyph quads are drawn at whole pixel positions at the same size as the glyphs, so no filtering is needed
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_width, m_height, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+
+    int fontY{ 0 };
+    for (const auto& font : m_pendingFonts) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, fontY, font.width, font.height, GL_RED, GL_UNSIGNED_BYTE,
+                        font.texels.data());
+        fontY += font.height;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_pendingFonts.clear();
+}
+
+} // namespace rg
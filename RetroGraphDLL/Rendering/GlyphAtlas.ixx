@@ -0,0 +1,68 @@
+export module RG.Rendering:GlyphAtlas;
+
+import :DrawUtils;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+// Location of a glyph in the atlas texture, in texels from the top left
+export struct GlyphRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+/* A single texture holding the glyphs of every font, rasterized by GDI.
+ * Each font's glyphs are laid out in a grid of equally sized cells, and the fonts' grids are stacked vertically.
+ * Glyph rects are as wide as the glyph's advance width and as tall as the font, so a glyph's rect can be drawn
+ * directly at the pen position with its bottom on the font's descent line.
+ */
+export class GlyphAtlas {
+public:
+    static constexpr int numGlyphs{ 256 };
+    static constexpr int glyphsPerRow{ 16 };
+
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    GlyphAtlas(GlyphAtlas&&) = delete;
+    GlyphAtlas& operator=(GlyphAtlas&&) = delete;
+
+    /* Rasterizes every glyph of the font into the atlas. Fonts are indexed in the order they are added.
+     * The atlas must be uploaded once all fonts are added */
+    void addFont(HDC hdc, HFONT font);
+
+    /* Creates the atlas texture from every added font and frees the CPU side copy of the glyphs */
+    void upload();
+
+    /* Frees the texture and all fonts */
+    void release();
+
+    const GlyphRect& getGlyphRect(size_t fontIndex, unsigned char c) const { return m_glyphRects[fontIndex][c]; }
+
+    size_t getNumFonts() const { return m_glyphRects.size(); }
+    GLuint getTextureID() const { return m_textureID; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    // Glyphs of a single font waiting to be uploaded
+    struct FontBitmap {
+        int width;
+        int height;
+        std::vector<uint8_t> texels;
+    };
+
+    std::vector<std::array<GlyphRect, numGlyphs>> m_glyphRects;
+    std::vector<FontBitmap> m_pendingFonts;
+    GLuint m_textureID{ invalidGLID };
+    int m_width{ 0 };
+    int m_height{ 0 };
+};
+
+} // namespace rg
@@ -1,9 +1,15 @@
 export module RG.Rendering;
 
+export import :DamageRegion;
 export import :DrawUtils;
 export import :FontManager;
+export import :FrameBuffer;
 export import :GLListContainer;
+export import :GlyphAtlas;
 export import :Shader;
+export import :StreamingVBO;
+export import :TextLayout;
+export import :TextRun;
 export import :VAO;
 export import :VBO;
 export import :Viewport;
@@ -0,0 +1,160 @@
+module RG.Rendering:StreamingVBO;
+
+import "GLHeaderUnit.h";
+import "RGAssert.h";
+
+namespace rg {
+
+constexpr GLbitfield persistentMapFlags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+StreamingVBO::StreamingVBO(GLsizeiptr regionBytes)
+    : m_id{ invalidGLID }
+    , m_regionBytes{ regionBytes }
+    , m_currentRegion{ 0 }
+    , m_regionUsed{ 0 }
+    , m_writeOffset{ 0 }
+    , m_persistentData{ nullptr }
+    , m_writeMapped{ false }
+    , m_fences{} {
+    create();
+}
+
+StreamingVBO::~StreamingVBO() {
+    destroy();
+}
+
+void StreamingVBO::resize(GLsizeiptr regionBytes) {
+    destroy();
+    m_regionBytes = regionBytes;
+    m_currentRegion = 0;
+    m_regionUsed = 0;
+    m_writeOffset = 0;
+    create();
+}
+
+void StreamingVBO::create() {
+    glGenBuffers(1, &m_id);
+
+    if (GLEW_ARB_buffer_storage) {
+        auto vboScope{ bind() };
+        glBufferStorage(GL_ARRAY_BUFFER, numRegions * m_regionBytes, nullptr, persistentMapFlags);
+        m_persistentData = static_cast<std::byte*>(
+            glMapBufferRange(GL_ARRAY_BUFFER, 0, numRegions * m_regionBytes, persistentMapFlags));
+        if (isPersistentlyMapped())
+            return;
+
+        RGERROR("Failed to persistently map streaming VBO, falling back to orphaning");
+
+        // Storage from glBufferStorage is immutable, so the buffer is made again to fall back to mutable storage
+        glDeleteBuffers(1, &m_id);
+        glGenBuffers(1, &m_id);
+    }
+
+    auto vboScope{ bind() };
+    glBufferData(GL_ARRAY_BUFFER, m_regionBytes, nullptr, GL_STREAM_DRAW);
+}
+
+void StreamingVBO::destroy() {
+    for (auto& fence : m_fences) {
+        if (fence)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    if (isPersistentlyMapped()) {
+        auto vboScope{ bind() };
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        m_persistentData = nullptr;
+    }
+
+    if (m_writeMapped) {
+        auto vboScope{ bind() };
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        m_writeMapped = false;
+    }
+
+    if (m_id != invalidGLID) {
+        glDeleteBuffers(1, &m_id);
+        m_id = invalidGLID;
+    }
+}
+
+void* StreamingVBO::beginWrite() {
+    nextRegion();
+    return mapRange(0, m_regionBytes);
+}
+
+void* StreamingVBO::beginAppend(GLsizeiptr bytes) {
+    RGASSERT(bytes <= m_regionBytes, "Streaming VBO write is larger than a region");
+
+    if (m_regionUsed + bytes > m_regionBytes)
+        nextRegion();
+    return mapRange(m_regionUsed, bytes);
+}
+
+void StreamingVBO::nextRegion() {
+    m_regionUsed = 0;
+
+    if (isPersistentlyMapped()) {
+        m_currentRegion = (m_currentRegion + 1) % numRegions;
+        waitForFence(m_fences[m_currentRegion]);
+        return;
+    }
+
+    // Orphan the old storage so the driver can hand back fresh memory instead of waiting for the GPU to finish with it
+    auto vboScope{ bind() };
+    glBufferData(GL_ARRAY_BUFFER, m_regionBytes, nullptr, GL_STREAM_DRAW);
+}
+
+void* StreamingVBO::mapRange(GLsizeiptr offset, GLsizeiptr bytes) {
+    m_writeOffset = offset;
+    m_regionUsed = offset + bytes;
+
+    if (isPersistentlyMapped())
+        return m_persistentData + regionOffset() + offset;
+
+    // Nothing has been written to the range since the storage was orphaned, so there's no need to sync with the GPU
+    auto vboScope{ bind() };
+    void* const data{ glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes,
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT) };
+    RGASSERT(data, "Failed to map streaming VBO");
+    m_writeMapped = data != nullptr;
+    return data;
+}
+
+void StreamingVBO::endWrite() {
+    // Persistent mappings are coherent, so the writes are visible to the GPU without any extra work
+    if (m_writeMapped) {
+        auto vboScope{ bind() };
+        m_writeMapped = false;
+        RGVERIFY(glUnmapBuffer(GL_ARRAY_BUFFER), "Streaming VBO data was corrupted while mapped");
+    }
+}
+
+void StreamingVBO::fenceDraw() const {
+    if (!isPersistentlyMapped())
+        return;
+
+    // A region can be drawn more than once between writes, only the latest draw matters
+    auto& fence{ m_fences[m_currentRegion] };
+    if (fence)
+        glDeleteSync(fence);
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamingVBO::waitForFence(GLsync& fence) const {
+    if (!fence)
+        return;
+
+    constexpr GLuint64 timeoutNs{ 1'000'000 };
+    GLenum result{ glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs) };
+    while (result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, 0, timeoutNs);
+    }
+    RGASSERT(result != GL_WAIT_FAILED, "Failed waiting for streaming VBO fence");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+} // namespace rg
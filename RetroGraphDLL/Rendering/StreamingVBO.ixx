@@ -0,0 +1,85 @@
+export module RG.Rendering:StreamingVBO;
+
+import :DrawUtils;
+import :VBO;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+// A vertex buffer for data that is completely rewritten every update (e.g. particles).
+// Where GL_ARB_buffer_storage is available, the buffer is split into regions that are persistently mapped, and each
+// update writes straight into the next region while the GPU may still be reading the previous ones. A fence placed
+// after each draw stops a region from being overwritten before the GPU has finished with it.
+// Otherwise the buffer falls back to a single region that is orphaned and re-mapped on each update.
+export class StreamingVBO {
+public:
+    static constexpr int numRegions{ 3 };
+
+    // regionBytes is the most data that can be written in one update. It should be a multiple of the vertex size
+    // so regions can be selected with the first vertex of a draw call.
+    explicit StreamingVBO(GLsizeiptr regionBytes);
+    ~StreamingVBO();
+
+    StreamingVBO(const StreamingVBO&) = delete;
+    StreamingVBO& operator=(const StreamingVBO&) = delete;
+    StreamingVBO(StreamingVBO&&) = delete;
+    StreamingVBO& operator=(StreamingVBO&&) = delete;
+
+    VBOBindScope bind() const { return { m_id, GL_ARRAY_BUFFER }; }
+
+    // Replaces the buffer with a new one with room for regionBytes per update. The buffer's ID changes, so vertex
+    // attributes pointing into it have to be set up again
+    void resize(GLsizeiptr regionBytes);
+
+    GLsizeiptr getRegionBytes() const { return m_regionBytes; }
+
+    // Moves to the next region and returns a pointer to write to. Waits for the GPU if it's still reading the region.
+    // The memory is write-only, it should never be read from.
+    // Returns nullptr if the buffer couldn't be mapped, in which case nothing should be drawn from the region.
+    void* beginWrite();
+
+    // Returns a pointer to write bytes to after whatever was written to the current region since it was started, so
+    // many small writes (e.g. each widget's text) share a region. Only moves to the next region, and possibly waits
+    // for the GPU, once the current one is full. bytes must fit in a region. Otherwise the same as beginWrite.
+    void* beginAppend(GLsizeiptr bytes);
+
+    // Must be called after writing and before drawing the region
+    void endWrite();
+
+    // Places a fence after the draw calls that read the current region. Call after each draw.
+    void fenceDraw() const;
+
+    // Index of the first vertex of the current region, to be passed to the draw call
+    GLint firstVertex(GLsizei vertexBytes) const {
+        return static_cast<GLint>((regionOffset() + m_writeOffset) / vertexBytes);
+    }
+
+    bool isPersistentlyMapped() const { return m_persistentData != nullptr; }
+
+private:
+    void create();
+    void destroy();
+
+    // Starts writing the next region from its beginning
+    void nextRegion();
+
+    // Returns a pointer to the given range of the current region, mapping it if the buffer isn't persistently mapped
+    void* mapRange(GLsizeiptr offset, GLsizeiptr bytes);
+
+    GLsizeiptr regionOffset() const { return m_currentRegion * m_regionBytes; }
+    void waitForFence(GLsync& fence) const;
+
+    GLuint m_id;
+    GLsizeiptr m_regionBytes;
+    int m_currentRegion;
+    GLsizeiptr m_regionUsed; // Bytes written to the current region since it was started
+    GLsizeiptr m_writeOffset; // Offset of the latest write within the current region
+    std::byte* m_persistentData;
+    bool m_writeMapped; // Whether the fallback region is mapped between beginWrite and endWrite
+    mutable std::array<GLsync, numRegions> m_fences;
+};
+
+} // namespace rg
@@ -0,0 +1,43 @@
+module RG.Rendering:TextLayout;
+
+namespace rg {
+
+int calculateStringWidth(const GlyphWidths& glyphWidths, std::string_view text) {
+    auto strWidthPx = int{ 0 };
+    for (const char c : text)
+        strWidthPx += glyphWidths[static_cast<unsigned char>(c)];
+
+    return strWidthPx;
+}
+
+TextLayout layoutText(const GlyphWidths& glyphWidths, std::string_view text, int maxWidthPx) {
+    auto strWidthPx = int{ 0 };
+    for (auto i = size_t{ 0U }; i < text.size(); ++i) {
+        strWidthPx += glyphWidths[static_cast<unsigned char>(text[i])];
+        if (strWidthPx <= maxWidthPx)
+            continue;
+
+        // Character i doesn't fit. Replace the characters before it with an ellipsis if there are enough of them
+        if (i > textLayoutEllipsis.size()) {
+            const auto visibleLength{ i - textLayoutEllipsis.size() };
+            return { visibleLength, true,
+                     calculateStringWidth(glyphWidths, text.substr(0, visibleLength)) +
+                         calculateStringWidth(glyphWidths, textLayoutEllipsis) };
+        }
+
+        return { i, false, calculateStringWidth(glyphWidths, text.substr(0, i)) };
+    }
+
+    return { text.size(), false, strWidthPx };
+}
+
+const TextLayout& TextLayoutCache::get(int fontCode, const GlyphWidths& glyphWidths, std::string_view text,
+                                       int maxWidthPx) {
+    if (const auto* layout{ m_cache.find(TextLayoutLookup{ fontCode, maxWidthPx, text }) })
+        return *layout;
+
+    return m_cache.insert(TextLayoutKey{ fontCode, maxWidthPx, std::string{ text } },
+                          layoutText(glyphWidths, text, maxWidthPx));
+}
+
+} // namespace rg
@@ -0,0 +1,90 @@
+export module RG.Rendering:TextLayout;
+
+import RG.Core;
+
+import std.core;
+
+namespace rg {
+
+// Advance width in pixels of each character of a font
+export using GlyphWidths = std::array<int, 256>;
+
+/* How a line of text fits within a maximum width.
+ * Text that is too wide is cut to its first visibleLength characters, followed by an ellipsis if ellipsis is set.
+ */
+export struct TextLayout {
+    size_t visibleLength;
+    bool ellipsis;
+    int widthPx; // Width of the visible text including the ellipsis
+};
+
+export constexpr std::string_view textLayoutEllipsis{ ".." };
+
+/* Gets the width of text in pixels */
+export int calculateStringWidth(const GlyphWidths& glyphWidths, std::string_view text);
+
+/* Works out how much of text can be drawn within maxWidthPx. If the text doesn't fit, the last two characters
+ * that do fit are replaced with an ellipsis */
+export TextLayout layoutText(const GlyphWidths& glyphWidths, std::string_view text, int maxWidthPx);
+
+struct TextLayoutKey {
+    int fontCode;
+    int maxWidthPx;
+    std::string text;
+};
+
+// Used to look up layouts without copying the text into a TextLayoutKey
+struct TextLayoutLookup {
+    int fontCode;
+    int maxWidthPx;
+    std::string_view text;
+};
+
+struct TextLayoutKeyHash {
+    using is_transparent = void;
+
+    size_t operator()(const TextLayoutKey& key) const {
+        return (*this)(TextLayoutLookup{ key.fontCode, key.maxWidthPx, key.text });
+    }
+
+    size_t operator()(const TextLayoutLookup& key) const {
+        auto hash{ std::hash<std::string_view>{}(key.text) };
+        hash ^= std::hash<int>{}(key.fontCode) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>{}(key.maxWidthPx) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+struct TextLayoutKeyEqual {
+    using is_transparent = void;
+
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        return a.fontCode == b.fontCode && a.maxWidthPx == b.maxWidthPx && std::string_view{ a.text } == b.text;
+    }
+};
+
+/* Caches the layouts of recently drawn lines. Most text is redrawn unchanged every frame, so once a line has been
+ * laid out, drawing it again doesn't need to measure it or allocate.
+ */
+export class TextLayoutCache {
+public:
+    explicit TextLayoutCache(size_t capacity)
+        : m_cache{ capacity } {}
+
+    /* Gets the layout of text in the given font, laying it out with glyphWidths if it isn't cached */
+    const TextLayout& get(int fontCode, const GlyphWidths& glyphWidths, std::string_view text, int maxWidthPx);
+
+    /* Removes every layout. Must be called when the fonts change */
+    void clear() { m_cache.clear(); }
+
+    size_t size() const { return m_cache.size(); }
+    uint64_t hits() const { return m_cache.hits(); }
+    uint64_t misses() const { return m_cache.misses(); }
+    double hitRate() const { return m_cache.hitRate(); }
+
+private:
+    LRUCache<TextLayoutKey, TextLayout, TextLayoutKeyHash, TextLayoutKeyEqual> m_cache;
+};
+
+} // namespace rg
@@ -0,0 +1,93 @@
+export module RG.Rendering:TextRun;
+
+import :Viewport;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+// A glyph quad to draw, matching the instance attributes in text.vert
+export struct GlyphInstance {
+    glm::vec2 position; // Bottom left corner in window pixels
+    glm::vec2 size;
+    glm::vec2 texel; // Top left corner in the glyph atlas
+    glm::vec4 color;
+};
+
+/* Everything other than the text that decides where a run's glyphs go.
+ * The horizontal position depends on the width of the text, so it isn't part of the placement.
+ */
+export struct TextPlacement {
+    int fontCode;
+    Viewport area; // In window pixels
+    int alignFlags;
+    int alignMarginX;
+    int baselineY; // Relative to the bottom of the area
+    glm::vec4 color;
+    uint32_t fontGeneration; // Changes whenever the fonts are recreated
+
+    bool operator==(const TextPlacement& other) const {
+        return fontCode == other.fontCode && area.x == other.area.x && area.y == other.area.y &&
+               area.width == other.area.width && area.height == other.area.height &&
+               alignFlags == other.alignFlags && alignMarginX == other.alignMarginX &&
+               baselineY == other.baselineY && color == other.color && fontGeneration == other.fontGeneration;
+    }
+};
+
+/* A line of text that keeps its laid out glyphs between frames.
+ * Widgets own a run for each piece of text they draw and only set its text when the value it shows changes. Drawing
+ * a run whose text and placement haven't changed copies its glyphs without formatting, measuring or allocating.
+ */
+export class TextRun {
+public:
+    // Longest text format() can produce
+    static constexpr size_t maxFormattedLength{ 128 };
+
+    TextRun() = default;
+    explicit TextRun(std::string_view text)
+        : m_text{ text } {}
+
+    /* Sets the text of the run. The glyphs are only laid out again if the text is different */
+    void setText(std::string_view text) {
+        if (text == m_text)
+            return;
+
+        // Reuses the string's storage, so only allocates if the text is longer than any text it has held before
+        m_text.assign(text);
+        m_placement.reset();
+    }
+
+    /* Formats the text into a buffer on the stack and sets it, so a value that hasn't changed doesn't allocate */
+    template<typename... Args>
+    void format(std::format_string<Args...> fmt, Args&&... args) {
+        std::array<char, maxFormattedLength> buffer;
+        const auto result{ std::format_to_n(buffer.data(), buffer.size(), fmt, std::forward<Args>(args)...) };
+        setText({ buffer.data(), static_cast<size_t>(result.out - buffer.data()) });
+    }
+
+    const std::string& getText() const { return m_text; }
+
+    /* Gets the glyphs of the run at the given placement. If the text or placement changed since the glyphs were last
+     * laid out, layout is called with the text and an empty glyph vector to fill */
+    template<typename LayoutFunc>
+    std::span<const GlyphInstance> getGlyphs(const TextPlacement& placement, LayoutFunc&& layout) const {
+        if (!m_placement || !(*m_placement == placement)) {
+            m_glyphs.clear();
+            layout(std::string_view{ m_text }, m_glyphs);
+            m_placement = placement;
+        }
+
+        return m_glyphs;
+    }
+
+private:
+    std::string m_text;
+
+    // The placement the glyphs were laid out for, if they have been laid out since the text last changed
+    mutable std::optional<TextPlacement> m_placement;
+    mutable std::vector<GlyphInstance> m_glyphs;
+};
+
+} // namespace rg
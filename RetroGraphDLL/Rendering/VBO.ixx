@@ -47,6 +47,9 @@ public:
 
     VBOBindScope bind() const { return { id, target }; }
 
+    // Binds the buffer to an indexed binding point of an indexed target, e.g. GL_SHADER_STORAGE_BUFFER
+    void bindBase(GLuint index) const { glBindBufferBase(target, index, id); }
+
     void bufferData(GLsizeiptr bytes, const void* data) const { glBufferData(target, bytes, data, usage); }
 
     void bufferSubData(GLintptr offset, GLsizeiptr bytes, const void* data) const {
@@ -55,17 +55,25 @@ void UserSettings::readMembers(const INIReader& reader) {
     // #TODO typesafe keys
     m_settings["Application.AutoReadConfig"] = reader.GetBoolean("Application", "AutoReadConfig", true);
     m_settings["Application.FPS"] = reader.GetInteger("Application", "FPS", 30);
+    m_settings["Application.MinFPS"] = reader.GetInteger("Application", "MinFPS", 1);
     m_settings["Window.Monitor"] = reader.GetInteger("Window", "Monitor", 0);
     m_settings["Window.WidgetBackground"] = reader.GetBoolean("Window", "WidgetBackground", true);
+    m_settings["Graphs.PointFormat"] = reader.Get("Graphs", "PointFormat", "float");
 
     m_settings["Measures-CPU.UpdateInterval"] = reader.GetInteger("Measures-CPU", "UpdateInterval", 1000);
+    m_settings["Measures-CPU.MaxUpdateInterval"] = reader.GetInteger("Measures-CPU", "MaxUpdateInterval", 1000);
+    m_settings["Measures-CPU.ChangeThreshold"] = reader.GetReal("Measures-CPU", "ChangeThreshold", 0.05);
     m_settings["Measures-Drive.UpdateInterval"] = reader.GetInteger("Measures-Drive", "UpdateInterval", 30000);
     m_settings["Measures-GPU.UpdateInterval"] = reader.GetInteger("Measures-GPU", "UpdateInterval", 1000);
+    m_settings["Measures-GPU.MaxUpdateInterval"] = reader.GetInteger("Measures-GPU", "MaxUpdateInterval", 1000);
+    m_settings["Measures-GPU.ChangeThreshold"] = reader.GetReal("Measures-GPU", "ChangeThreshold", 0.05);
     m_settings["Measures-Music.UpdateInterval"] = reader.GetInteger("Measures-Music", "UpdateInterval", 1000);
     m_settings["Measures-Net.PingServer"] = reader.Get("Measures-Net", "PingServer", "http://www.google.com/");
     m_settings["Measures-Net.PingFrequency"] = reader.GetInteger("Measures-Net", "PingFrequency", 60000);
     m_settings["Measures-Net.UpdateInterval"] = reader.GetInteger("Measures-Net", "UpdateInterval", 1000);
     m_settings["Measures-RAM.UpdateInterval"] = reader.GetInteger("Measures-RAM", "UpdateInterval", 1000);
+    m_settings["Measures-RAM.MaxUpdateInterval"] = reader.GetInteger("Measures-RAM", "MaxUpdateInterval", 1000);
+    m_settings["Measures-RAM.ChangeThreshold"] = reader.GetReal("Measures-RAM", "ChangeThreshold", 0.05);
     m_settings["Measures-Time.UpdateInterval"] = reader.GetInteger("Measures-Time", "UpdateInterval", 1000);
 
     m_settings["Widgets-ProcessesCPU.NumProcessesDisplayed"] =
@@ -81,10 +89,20 @@ void UserSettings::readMembers(const INIReader& reader) {
         reader.GetInteger("Widgets-NetGraph", "DownloadDataScaleLowerBoundKB", 100);
     m_settings["Widgets-NetGraph.UploadDataScaleLowerBoundKB"] =
         reader.GetInteger("Widgets-NetGraph", "UploadDataScaleLowerBoundKB", 100);
+    m_settings["Widgets-NetGraph.ScaleHysteresis"] = reader.GetReal("Widgets-NetGraph", "ScaleHysteresis", 0.2);
     m_settings["Widgets-CPUGraph.NumUsageSamples"] = reader.GetInteger("Widgets-CPUGraph", "NumUsageSamples", 40);
     m_settings["Widgets-CPUStats.NumUsageSamples"] = reader.GetInteger("Widgets-CPUStats", "NumUsageSamples", 40);
+    m_settings["Widgets-CPUStats.HeatmapCoreThreshold"] =
+        reader.GetInteger("Widgets-CPUStats", "HeatmapCoreThreshold", 32);
     m_settings["Widgets-GPUGraph.NumUsageSamples"] = reader.GetInteger("Widgets-GPUGraph", "NumUsageSamples", 40);
     m_settings["Widgets-RAMGraph.NumUsageSamples"] = reader.GetInteger("Widgets-RAMGraph", "NumUsageSamples", 40);
+    m_settings["Widgets-Main.NumParticles"] = reader.GetInteger("Widgets-Main", "NumParticles", 100);
+    m_settings["Widgets-Main.ConnectionDistance"] = reader.GetReal("Widgets-Main", "ConnectionDistance", 0.2);
+    m_settings["Widgets-Main.GridCellsPerSide"] = reader.GetInteger("Widgets-Main", "GridCellsPerSide", 10);
+    m_settings["Widgets-Main.AutoTuneParticles"] = reader.GetBoolean("Widgets-Main", "AutoTuneParticles", false);
+    m_settings["Widgets-Main.AutoTuneBudgetUs"] = reader.GetInteger("Widgets-Main", "AutoTuneBudgetUs", 2000);
+    m_settings["Widgets-Main.NumThreads"] = reader.GetInteger("Widgets-Main", "NumThreads", 0);
+    m_settings["Widgets-Main.Seed"] = reader.Get("Widgets-Main", "Seed", "0");
 
     m_settings["Widgets-Time.Visible"] = reader.GetBoolean("Widgets-Time", "Visible", true);
     m_settings["Widgets-CPUStats.Visible"] = reader.GetBoolean("Widgets-CPUStats", "Visible", true);
@@ -2,6 +2,8 @@ module RG.Widgets:CPUGraphWidget;
 
 import Colors;
 
+import RG.Core;
+
 namespace rg {
 
 CPUGraphWidget::CPUGraphWidget(const FontManager* fontManager, std::shared_ptr<const CPUMeasure> cpuMeasure)
@@ -18,25 +20,27 @@ CPUGraphWidget::~CPUGraphWidget() {
 }
 
 void CPUGraphWidget::draw() const {
+    const ProfileZone zone{ "CPUGraphWidget::draw" };
+
     // Set the viewport for the graph to be left section
-    glViewport(m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height);
+    setGLViewport({ m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height });
     m_graph.draw();
 
     // Text
-    glViewport(m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5, m_viewport.height);
+    setGLViewport({ m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5, m_viewport.height });
 
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
-    m_fontManager->renderLine(RG_FONT_SMALL, "0%", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
+    m_fontManager->renderLine(RG_FONT_SMALL, m_minLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_BOTTOM | RG_ALIGN_LEFT, 10);
-    m_fontManager->renderLine(RG_FONT_SMALL, "CPU Load", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->renderLine(RG_FONT_SMALL, m_titleLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_LEFT, 10);
-    m_fontManager->renderLine(RG_FONT_SMALL, "100%", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->renderLine(RG_FONT_SMALL, m_maxLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_TOP | RG_ALIGN_LEFT, 10);
 }
 
 CPUUsageEvent::Handle CPUGraphWidget::RegisterCPUUsageCallback() {
     return m_cpuMeasure->onCPUUsage.attach([this](float usage) {
-        m_graph.addPoint(usage);
+        m_graph.addPoint(usage, m_cpuMeasure->getSampleSpan());
         invalidate();
     });
 }
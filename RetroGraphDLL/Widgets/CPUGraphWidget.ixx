@@ -27,6 +27,10 @@ private:
     ConfigRefreshedEvent::Handle m_configRefreshedHandle;
     int m_graphSampleSize;
     SmoothLineGraph m_graph;
+
+    TextRun m_minLabel{ "0%" };
+    TextRun m_titleLabel{ "CPU Load" };
+    TextRun m_maxLabel{ "100%" };
 };
 
 } // namespace rg
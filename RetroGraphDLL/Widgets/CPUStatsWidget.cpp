@@ -2,6 +2,7 @@ module RG.Widgets:CPUStatsWidget;
 
 import Colors;
 
+import RG.Core;
 import RG.Rendering;
 
 import "GLHeaderUnit.h";
@@ -9,22 +10,78 @@ import "RGAssert.h";
 
 namespace rg {
 
-auto CPUStatsWidget::createCoreGraphs(const CPUMeasure& cpuMeasure) {
-    decltype(m_coreGraphs) coreGraphs{};
+void CPUStatsWidget::createCoreGraphs() {
+    const auto numCores{ m_cpuMeasure->getNumCores() };
+    const auto numSamples{ static_cast<size_t>(m_coreGraphSampleSize) };
 
-    for (int i{ 0 }; i < cpuMeasure.getNumCores(); ++i)
-        coreGraphs.emplace_back(static_cast<size_t>(m_coreGraphSampleSize));
+    // Past a certain number of cores the line graphs are too small to read, so switch to a heatmap
+    if (numCores > m_heatmapCoreThreshold) {
+        m_coreGraphs.reset();
+        m_coreHeatmap = std::make_unique<HeatmapGraph>(numSamples, numCores);
 
-    return coreGraphs;
+        m_coreLabels.resize(1);
+        m_coreLabels[0].format("Cores 0-{}", numCores - 1);
+        return;
+    }
+
+    m_coreHeatmap.reset();
+    m_coreGraphs = std::make_unique<LineGraphBatch>(numCores, getNumberOfCurvePoints(numSamples));
+    for (int i{ 0 }; i < numCores; ++i)
+        m_coreGraphs->addGraph<SmoothLineGraph>(numSamples);
+
+    m_coreLabels.resize(numCores);
+    for (int i{ 0 }; i < numCores; ++i)
+        m_coreLabels[i].format("Core {}", i);
+
+    updateCoreGraphModelViews();
+}
+
+int CPUStatsWidget::getNumCoreGraphs() const {
+    return static_cast<int>(m_coreHeatmap ? m_coreHeatmap->numRows() : m_coreGraphs->size());
+}
+
+Viewport CPUStatsWidget::getCoreGraphViewport(int coreIdx) const {
+    // Graphs are stacked top to bottom in the left three quarters of the viewport
+    const auto numGraphs{ static_cast<int>(m_coreGraphs->size()) };
+    const auto yOffset{ (numGraphs - 1) * m_coreGraphViewport.height / numGraphs -
+                        coreIdx * m_coreGraphViewport.height / numGraphs };
+
+    return { m_coreGraphViewport.x, m_coreGraphViewport.y + yOffset, 3 * m_coreGraphViewport.width / 4,
+             m_coreGraphViewport.height / numGraphs };
+}
+
+void CPUStatsWidget::updateCoreGraphModelViews() {
+    if (!m_coreGraphs || m_coreGraphViewport.height == 0)
+        return;
+
+    // The batch draws every graph at once in the area covering all graphs, so each graph is scaled and moved into
+    // its own part of that area
+    for (int i{ 0 }; i < static_cast<int>(m_coreGraphs->size()); ++i) {
+        const auto graphViewport{ getCoreGraphViewport(i) };
+        const auto areaHeight{ static_cast<float>(m_coreGraphViewport.height) };
+        const auto graphBottom{ (graphViewport.y - m_coreGraphViewport.y) / areaHeight };
+        const auto graphHeight{ graphViewport.height / areaHeight };
+        const auto graphCentreY{ (graphBottom + graphHeight / 2.0f) * viewportWidth + viewportMin };
+
+        glm::mat4 modelView{};
+        modelView = glm::translate(modelView, { 0.0f, graphCentreY, 0.0f });
+        modelView = glm::scale(modelView, { 1.0f, graphHeight, 1.0f });
+        (*m_coreGraphs)[i].setModelView(modelView);
+    }
 }
 
 CPUStatsWidget::CPUStatsWidget(const FontManager* fontManager, std::shared_ptr<const CPUMeasure> cpuMeasure)
     : Widget{ fontManager }
     , m_cpuMeasure{ cpuMeasure }
     , m_coreGraphSampleSize{ UserSettings::inst().getVal<int>("Widgets-CPUStats.NumUsageSamples") }
-    , m_coreGraphs{ createCoreGraphs(*cpuMeasure) }
+    , m_heatmapCoreThreshold{ UserSettings::inst().getVal<int>("Widgets-CPUStats.HeatmapCoreThreshold") }
+    , m_coreGraphs{}
+    , m_coreHeatmap{}
     , m_onCPUCoreUsageHandle{ RegisterOnCPUCoreUsageCallback() }
-    , m_configRefreshedHandle{ RegisterConfigRefreshedCallback() } {}
+    , m_configRefreshedHandle{ RegisterConfigRefreshedCallback() } {
+    createCoreGraphs();
+    updateStatsText();
+}
 
 CPUStatsWidget::~CPUStatsWidget() {
     UserSettings::inst().configRefreshed.detach(m_configRefreshedHandle);
@@ -35,9 +92,12 @@ void CPUStatsWidget::setViewport(const Viewport& vp) {
     m_viewport = vp;
     m_coreGraphViewport = { vp.x, vp.y, (vp.width / 4) * 3, vp.height };
     m_statsViewport = { m_coreGraphViewport.width + vp.x, vp.y, (vp.width / 4), vp.height };
+    updateCoreGraphModelViews();
 };
 
 void CPUStatsWidget::draw() const {
+    const ProfileZone zone{ "CPUStatsWidget::draw" };
+
     drawCoreGraphs();
     drawStats();
 }
@@ -45,62 +105,108 @@ void CPUStatsWidget::draw() const {
 void CPUStatsWidget::drawStats() const {
     setGLViewport(m_statsViewport);
 
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
     constexpr auto bottomTextMargin{ 10U };
 
-    char voltBuff[7];
-    char clockBuff[12];
-    snprintf(voltBuff, sizeof(voltBuff), "%.3fv", m_cpuMeasure->getVoltage());
-    snprintf(clockBuff, sizeof(clockBuff), "%.0fMHz", m_cpuMeasure->getClockSpeed());
-
-    m_fontManager->renderLine(RG_FONT_STANDARD, voltBuff, 0, 0, 0, 0, RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_TOP,
-                              bottomTextMargin, bottomTextMargin);
-    m_fontManager->renderLine(RG_FONT_STANDARD, clockBuff, 0, 0, 0, 0, RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_BOTTOM,
+    m_fontManager->renderLine(RG_FONT_STANDARD, m_voltageText, 0, 0, 0, 0, RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_TOP,
                               bottomTextMargin, bottomTextMargin);
+    m_fontManager->renderLine(RG_FONT_STANDARD, m_clockSpeedText, 0, 0, 0, 0,
+                              RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_BOTTOM, bottomTextMargin, bottomTextMargin);
+}
+
+void CPUStatsWidget::updateStatsText() {
+    m_voltageText.format("{:.3f}v", m_cpuMeasure->getVoltage());
+    m_clockSpeedText.format("{:.0f}MHz", m_cpuMeasure->getClockSpeed());
+
+    const auto numCores{ m_cpuMeasure->getNumCores() };
+    m_coreTempTexts.resize(numCores);
+    float maxTemp{ 0.0f };
+    for (int i{ 0 }; i < numCores; ++i) {
+        const auto temp{ m_cpuMeasure->getTemp(i) };
+        m_coreTempTexts[i].format("{:.0f}C", temp);
+        maxTemp = std::max(maxTemp, temp);
+    }
+
+    // There's no room for every core's temperature next to the heatmap, so it only shows the hottest
+    m_maxTempText.format("Max {:.0f}C", maxTemp);
 }
 
 void CPUStatsWidget::drawCoreGraphs() const {
-    setGLViewport(m_coreGraphViewport);
+    if (m_coreHeatmap) {
+        drawCoreHeatmap();
+        return;
+    }
+
+    const auto numGraphs{ static_cast<int>(m_coreGraphs->size()) };
 
-    // Draw x rows of core graphs, with 2 graphs per row until all graphs
-    // are drawn
-    const auto numGraphs{ static_cast<int>(m_coreGraphs.size()) };
+    // Draw the border and grid of each graph in its own viewport. Batched graphs don't draw their points here
+    for (int i = 0; i < numGraphs; ++i) {
+        setGLViewport(getCoreGraphViewport(i));
+        (*m_coreGraphs)[i].draw();
+    }
 
-    for (int i = 0U; i < numGraphs; ++i) {
-        // Set the viewport for the current graph. Draws top to bottom
-        const auto yOffset{ (numGraphs - 1) * m_coreGraphViewport.height / numGraphs -
-                            i * m_coreGraphViewport.height / numGraphs };
-        glViewport(m_coreGraphViewport.x, m_coreGraphViewport.y + yOffset, 3 * m_coreGraphViewport.width / 4,
-                   m_coreGraphViewport.height / numGraphs);
+    // Draw the points of every graph in one go
+    setGLViewport({ m_coreGraphViewport.x, m_coreGraphViewport.y, 3 * m_coreGraphViewport.width / 4,
+                    m_coreGraphViewport.height });
+    m_coreGraphs->draw();
 
-        m_coreGraphs[i].draw();
+    for (int i = 0; i < numGraphs; ++i) {
+        const auto graphViewport{ getCoreGraphViewport(i) };
+        setGLViewport(graphViewport);
 
         // Draw a label for the core graph
-        glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
-        char str[7];
-        snprintf(str, sizeof(str), "Core %d", i);
-        m_fontManager->renderLine(RG_FONT_SMALL, str, 0, 0, 0, 0, RG_ALIGN_TOP | RG_ALIGN_LEFT, 10, 10);
+        m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
+        m_fontManager->renderLine(RG_FONT_SMALL, m_coreLabels[i], 0, 0, 0, 0, RG_ALIGN_TOP | RG_ALIGN_LEFT, 10, 10);
 
         // Draw the temperature next to the graph
-        glViewport(m_coreGraphViewport.x + 3 * m_coreGraphViewport.width / 4, m_coreGraphViewport.y + yOffset,
-                   m_coreGraphViewport.width / 4, m_coreGraphViewport.height / static_cast<GLsizei>(numGraphs));
-        char tempBuff[6];
-        snprintf(tempBuff, sizeof(tempBuff), "%.0fC", m_cpuMeasure->getTemp(i));
-        m_fontManager->renderLine(RG_FONT_SMALL, tempBuff, 0, 0, 0, 0,
+        setGLViewport({ graphViewport.x + graphViewport.width, graphViewport.y, m_coreGraphViewport.width / 4,
+                        graphViewport.height });
+        m_fontManager->renderLine(RG_FONT_SMALL, m_coreTempTexts[i], 0, 0, 0, 0,
                                   RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL, 0, 0);
     }
 }
 
+void CPUStatsWidget::drawCoreHeatmap() const {
+    const Viewport heatmapViewport{ m_coreGraphViewport.x, m_coreGraphViewport.y, 3 * m_coreGraphViewport.width / 4,
+                                    m_coreGraphViewport.height };
+    setGLViewport(heatmapViewport);
+    m_coreHeatmap->draw();
+
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
+    m_fontManager->renderLine(RG_FONT_SMALL, m_coreLabels[0], 0, 0, 0, 0, RG_ALIGN_TOP | RG_ALIGN_LEFT, 10, 10);
+
+    setGLViewport({ heatmapViewport.x + heatmapViewport.width, heatmapViewport.y, m_coreGraphViewport.width / 4,
+                    heatmapViewport.height });
+    m_fontManager->renderLine(RG_FONT_SMALL, m_maxTempText, 0, 0, 0, 0,
+                              RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL, 0, 0);
+}
+
 CPUCoreUsageEvent::Handle CPUStatsWidget::RegisterOnCPUCoreUsageCallback() {
     return m_cpuMeasure->onCPUCoreUsage.attach([this](int coreIdx, float coreUsage) {
-        RGASSERT(coreIdx < m_coreGraphs.size(), "CPU core index out of range");
+        RGASSERT(coreIdx < getNumCoreGraphs(), "CPU core index out of range");
 
-        if (m_coreGraphs.size() != m_cpuMeasure->getNumCores()) {
+        if (getNumCoreGraphs() != m_cpuMeasure->getNumCores()) {
             RGERROR("How did the CPU core count change?");
-            m_coreGraphs = createCoreGraphs(*m_cpuMeasure);
+            createCoreGraphs();
+            updateStatsText();
+        }
+
+        // Cores are updated in order, so the stats are refreshed once per update after the last core
+        const bool isLastCore{ coreIdx == getNumCoreGraphs() - 1 };
+        if (isLastCore)
+            updateStatsText();
+
+        if (m_coreHeatmap) {
+            // The sample is complete once the last core has been updated
+            m_coreHeatmap->setValue(coreIdx, coreUsage);
+            if (isLastCore) {
+                m_coreHeatmap->pushSample(m_cpuMeasure->getSampleSpan());
+                invalidate();
+            }
+            return;
         }
 
-        m_coreGraphs[coreIdx].addPoint(coreUsage);
+        (*m_coreGraphs)[coreIdx].addPoint(coreUsage, m_cpuMeasure->getSampleSpan());
         invalidate();
     });
 }
@@ -108,11 +214,13 @@ CPUCoreUsageEvent::Handle CPUStatsWidget::RegisterOnCPUCoreUsageCallback() {
 ConfigRefreshedEvent::Handle CPUStatsWidget::RegisterConfigRefreshedCallback() {
     return UserSettings::inst().configRefreshed.attach([this]() {
         const int newGraphSampleSize{ UserSettings::inst().getVal<int>("Widgets-CPUStats.NumUsageSamples") };
-        if (m_coreGraphSampleSize != newGraphSampleSize) {
+        const int newHeatmapCoreThreshold{ UserSettings::inst().getVal<int>("Widgets-CPUStats.HeatmapCoreThreshold") };
+        if (m_coreGraphSampleSize != newGraphSampleSize || m_heatmapCoreThreshold != newHeatmapCoreThreshold) {
             m_coreGraphSampleSize = newGraphSampleSize;
-            for (auto& coreGraph : m_coreGraphs) {
-                coreGraph.resetPoints(m_coreGraphSampleSize);
-            }
+            m_heatmapCoreThreshold = newHeatmapCoreThreshold;
+
+            // The batch's slots are sized for the old sample count, so the graphs are recreated
+            createCoreGraphs();
             invalidate();
         }
     });
@@ -21,10 +21,17 @@ public:
     void setViewport(const Viewport& vp) override;
 
 private:
-    auto createCoreGraphs(const CPUMeasure& cpuMeasure);
+    void createCoreGraphs();
+    int getNumCoreGraphs() const;
+    Viewport getCoreGraphViewport(int coreIdx) const;
+    void updateCoreGraphModelViews();
 
     void drawCoreGraphs() const;
+    void drawCoreHeatmap() const;
     void drawStats() const;
+
+    /* Formats the CPU stats into the text runs */
+    void updateStatsText();
     CPUCoreUsageEvent::Handle RegisterOnCPUCoreUsageCallback();
     ConfigRefreshedEvent::Handle RegisterConfigRefreshedCallback();
 
@@ -34,7 +41,18 @@ private:
     std::shared_ptr<const CPUMeasure> m_cpuMeasure{ nullptr };
 
     int m_coreGraphSampleSize;
-    std::vector<SmoothLineGraph> m_coreGraphs;
+    int m_heatmapCoreThreshold;
+
+    // Core usage is either drawn as a line graph per core, all drawn in one batch, or as a single heatmap when there
+    // are more cores than m_heatmapCoreThreshold. Only one of these exists at a time.
+    std::unique_ptr<LineGraphBatch> m_coreGraphs;
+    std::unique_ptr<HeatmapGraph> m_coreHeatmap;
+
+    TextRun m_voltageText;
+    TextRun m_clockSpeedText;
+    std::vector<TextRun> m_coreLabels;
+    std::vector<TextRun> m_coreTempTexts;
+    TextRun m_maxTempText; // Only shown with the heatmap
 
     CPUCoreUsageEvent::Handle m_onCPUCoreUsageHandle;
     ConfigRefreshedEvent::Handle m_configRefreshedHandle;
@@ -2,19 +2,47 @@ module RG.Widgets:FPSWidget;
 
 import Colors;
 
+import RG.Core;
+
 namespace rg {
 
+namespace {
+
+float toMilliseconds(std::chrono::microseconds time) {
+    return static_cast<float>(time.count()) / 1000.0f;
+}
+
+} // namespace
+
 void FPSWidget::draw() const {
+    const ProfileZone zone{ "FPSWidget::draw" };
+
+    // Shows the measured rate next to the rate the limiter is aiming for, which drops while nothing is animating
     const auto fps{ m_fpsCounter->getFPS() };
+    const auto targetFPS{ m_fpsLimiter->getTargetFPS() };
     if (fps < 1000.0f) {
-        char fpsStr[5];
-        snprintf(fpsStr, sizeof(fpsStr), "%.1f", fps);
-        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, fpsStr, 0, 0, 0, 0,
-                                  RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL);
+        m_fpsText.format("{:.1f} / {:.0f}", fps, targetFPS);
     } else {
-        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, std::to_string(static_cast<int>(fps)).c_str(), 0, 0, 0, 0,
-                                  RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_CENTERED_VERTICAL);
+        m_fpsText.format("{} / {:.0f}", static_cast<int>(fps), targetFPS);
     }
+
+    // The widget is small, so the median is left to the frame rate and the phases are shortened to their initials
+    const auto& frameTimes{ m_fpsCounter->getFrameTimeHistogram() };
+    m_frameTimeTexts[0].format("p95 {:.1f} p99 {:.1f} max {:.1f}", toMilliseconds(frameTimes.getPercentile(0.95)),
+                               toMilliseconds(frameTimes.getPercentile(0.99)), toMilliseconds(frameTimes.getMax()));
+    m_frameTimeTexts[1].format("U {:.1f} D {:.1f} P {:.1f}",
+                               toMilliseconds(m_fpsCounter->getMeanPhaseTime(FramePhase::Update)),
+                               toMilliseconds(m_fpsCounter->getMeanPhaseTime(FramePhase::Draw)),
+                               toMilliseconds(m_fpsCounter->getMeanPhaseTime(FramePhase::Present)));
+
+    // How late the limiter wakes up for a frame is the frame pacing jitter
+    const auto& wakeLateness{ m_fpsLimiter->getWakeLateness() };
+    m_frameTimeTexts[2].format("wake p99 {:.2f}", toMilliseconds(wakeLateness.getPercentile(0.99)));
+
+    m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_fpsText, 0, 0, 0, 0,
+                              RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_TOP);
+    m_fontManager->renderLines(RG_FONT_SMALL, m_frameTimeTexts, 0, 0, 0, 0,
+                               RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_BOTTOM);
 }
 
 } // namespace rg
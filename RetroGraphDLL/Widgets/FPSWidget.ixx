@@ -3,6 +3,7 @@ export module RG.Widgets:FPSWidget;
 import :Widget;
 
 import FPSCounter;
+import FPSLimiter;
 
 import RG.Rendering;
 
@@ -10,9 +11,10 @@ namespace rg {
 
 export class FPSWidget : public Widget {
 public:
-    FPSWidget(const FontManager* fontManager, const FPSCounter& fpsLimiter)
+    FPSWidget(const FontManager* fontManager, const FPSCounter& fpsCounter, const FPSLimiter& fpsLimiter)
         : Widget{ fontManager }
-        , m_fpsCounter{ &fpsLimiter } {}
+        , m_fpsCounter{ &fpsCounter }
+        , m_fpsLimiter{ &fpsLimiter } {}
     ~FPSWidget() noexcept = default;
 
     void draw() const override;
@@ -21,6 +23,14 @@ public:
 
 private:
     const FPSCounter* m_fpsCounter;
+    const FPSLimiter* m_fpsLimiter;
+
+    // There's no event for the FPS changing, so the text is set when drawing. It's only laid out again when the
+    // formatted value changes
+    mutable TextRun m_fpsText;
+
+    // Frame time percentiles, the time spent in each phase of the frame and how late the limiter woke up for frames
+    mutable std::array<TextRun, 3> m_frameTimeTexts;
 };
 
 } // namespace rg
@@ -1,6 +1,9 @@
 export module RG.Widgets.Graph;
 
 export import :GraphPointBuffer;
+export import :HeatmapBuffer;
+export import :HeatmapGraph;
 export import :LineGraph;
+export import :LineGraphBatch;
 export import :SmoothLineGraph;
 export import :SmoothMirrorLineGraph;
@@ -8,37 +8,75 @@ import "GLHeaderUnit.h";
 
 namespace rg {
 
-// A rolling buffer for graph points. It takes up twice the space in memory as a naive buffer but has
-// the advantage of only requiring points to be copied/replaced in memory once every numPoints() updates.
-// Points are stored in the GL viewport space.
+// Vertex format used when uploading graph points to the GPU
+export enum class GraphPointFormat {
+    Float, // 32 bit float y values
+    UNorm16, // y values normalized to 16 bits. Half the bandwidth of Float at ~3e-5 viewport units of precision
+};
+
+// Maps a y value in the GL viewport space to a normalized 16 bit value for the compact point format.
+// lineGraph.vert maps it back to the viewport with yScale = viewportWidth and yBias = viewportMin.
+export constexpr inline uint16_t packPointUNorm16(float y) {
+    const auto normalized{ (std::clamp(y, viewportMin, viewportMax) - viewportMin) / viewportWidth };
+    return static_cast<uint16_t>(normalized * std::numeric_limits<uint16_t>::max() + 0.5f);
+}
+
+export constexpr inline float unpackPointUNorm16(uint16_t value) {
+    return (static_cast<float>(value) / std::numeric_limits<uint16_t>::max()) * viewportWidth + viewportMin;
+}
+
+// A range of vertices to pass to a draw call
+export struct GraphDrawRange {
+    GLint first;
+    GLsizei count;
+};
+
+// A ring buffer for graph points. Pushing a point overwrites the oldest one in place, so no points ever have to be
+// copied or re-uploaded as the graph scrolls. The points are drawn in two ranges, from the tail to the end of the
+// buffer, then from the start of the buffer to the head.
+// Only the y values are stored, in the GL viewport space. The x value of a point only depends on its distance from
+// the tail, so it is derived in the vertex shader instead (see getPointX()).
 export class GraphPointBuffer {
 public:
     explicit GraphPointBuffer(size_t numPoints_);
 
     void setPoints(std::span<const float> values);
 
-    // Returns true if the underlying buffer was moved.
-    // Returns false if the point was pushed in place
-    bool pushPoint(float value);
+    // Overwrites the oldest point with value, which becomes the newest point
+    void pushPoint(float value);
 
-    glm::vec2& operator[](size_t index) { return m_rollingBuffer[tail() + index]; }
-    const glm::vec2& operator[](size_t index) const { return m_rollingBuffer[tail() + index]; }
+    // Indexes the points from the oldest (0) to the newest (numPoints() - 1)
+    float& operator[](size_t index) { return m_ringBuffer[bufferIndex(index)]; }
+    const float& operator[](size_t index) const { return m_ringBuffer[bufferIndex(index)]; }
 
-    const glm::vec2* data() const { return m_rollingBuffer.data(); }
-    const glm::vec2* back() const { return &m_rollingBuffer[m_head]; }
-    const glm::vec2* front() const { return &m_rollingBuffer[m_tail]; }
-    GLsizei head() const { return static_cast<GLsizei>(m_head); }
+    // Position in the underlying buffer of the point at index
+    size_t bufferIndex(size_t index) const { return (m_tail + index) % m_ringBuffer.size(); }
+
+    const float* data() const { return m_ringBuffer.data(); }
+    const float* back() const { return &m_ringBuffer[head()]; }
+    const float* front() const { return &m_ringBuffer[tail()]; }
+    GLsizei head() const { return numPoints() == 0 ? 0 : static_cast<GLsizei>(bufferIndex(numPoints() - 1)); }
     GLsizei tail() const { return static_cast<GLsizei>(m_tail); }
 
-    int bufferSize() const { return static_cast<GLsizei>(m_rollingBuffer.size()); }
-    int numPoints() const { return bufferSize() / 2; }
+    int bufferSize() const { return static_cast<GLsizei>(m_ringBuffer.size()); }
+    int numPoints() const { return bufferSize(); }
     float getHorizontalPointInterval() const { return viewportWidth / (numPoints() - 1); }
 
-private:
-    void initPoints();
+    // The x value of the point at index, before being offset into the viewport
+    float getPointX(size_t index) const { return index * getHorizontalPointInterval(); }
+
+    // The ranges to draw the points with, in a vertex buffer holding the ring buffer followed by a copy of its first
+    // point. The copy joins the end of the first range to the start of the second. The second range is empty when
+    // the points don't wrap around the end of the buffer.
+    std::array<GraphDrawRange, 2> drawRanges() const {
+        if (tail() == 0)
+            return { GraphDrawRange{ 0, numPoints() }, GraphDrawRange{ 0, 0 } };
 
-    std::vector<glm::vec2> m_rollingBuffer;
-    size_t m_head;
+        return { GraphDrawRange{ tail(), numPoints() - tail() + 1 }, GraphDrawRange{ 0, head() + 1 } };
+    }
+
+private:
+    std::vector<float> m_ringBuffer;
     size_t m_tail;
 };
 
@@ -0,0 +1,47 @@
+export module RG.Widgets.Graph:HeatmapBuffer;
+
+import std.core;
+
+namespace rg {
+
+// Maps a value from 0 to 1 to a heatmap texel
+export constexpr inline uint8_t packHeatmapValue(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * std::numeric_limits<uint8_t>::max() + 0.5f);
+}
+
+// CPU side state of a scrolling heatmap, where each column is one sample of a value for every row.
+// Like GraphPointBuffer, columns are kept in a ring so only the newest column has to be uploaded as the heatmap
+// scrolls. Only the column being filled in is stored, older columns only exist in the texture.
+export class HeatmapBuffer {
+public:
+    HeatmapBuffer(size_t numColumns, size_t numRows)
+        : m_column(numRows, packHeatmapValue(0.0f))
+        , m_numColumns{ std::max(numColumns, size_t{ 1U }) }
+        , m_newestColumn{ m_numColumns - 1 } {}
+
+    // Sets the value of a row in the column being filled in
+    void setValue(size_t row, float value) { m_column[row] = packHeatmapValue(value); }
+
+    // Makes the filled in column the newest column, overwriting the oldest one. Returns its index in the ring
+    size_t pushColumn() {
+        m_newestColumn = (m_newestColumn + 1) % m_numColumns;
+        return m_newestColumn;
+    }
+
+    std::span<const uint8_t> column() const { return m_column; }
+
+    size_t numColumns() const { return m_numColumns; }
+    size_t numRows() const { return m_column.size(); }
+    size_t newestColumn() const { return m_newestColumn; }
+    size_t oldestColumn() const { return (m_newestColumn + 1) % m_numColumns; }
+
+    // Texture coordinate of the oldest column, which is drawn at the left edge of the heatmap
+    float scrollOffset() const { return static_cast<float>(oldestColumn()) / m_numColumns; }
+
+private:
+    std::vector<uint8_t> m_column;
+    size_t m_numColumns;
+    size_t m_newestColumn;
+};
+
+} // namespace rg
@@ -0,0 +1,81 @@
+module RG.Widgets.Graph:HeatmapGraph;
+
+import Colors;
+
+import RG.Rendering;
+import RG.Widgets;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+HeatmapGraph::HeatmapGraph(size_t numSamples, size_t numRows)
+    : m_buffer{ numSamples, numRows }
+    , m_textureID{ invalidGLID }
+    , m_vao{} {
+    initTexture();
+}
+
+HeatmapGraph::~HeatmapGraph() {
+    if (m_textureID != invalidGLID) {
+        glDeleteTextures(1, &m_textureID);
+    }
+}
+
+void HeatmapGraph::initTexture() {
+    glGenTextures(1, &m_textureID);
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+    // Nearest filtering keeps each cell a solid block and stops the newest and oldest columns blending together where
+    // the ring wraps around
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    const std::vector<uint8_t> emptyTexels(m_buffer.numRows() * m_buffer.numColumns(), packHeatmapValue(0.0f));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, static_cast<GLsizei>(m_buffer.numRows()),
+                 static_cast<GLsizei>(m_buffer.numColumns()), 0, GL_RED, GL_UNSIGNED_BYTE, emptyTexels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void HeatmapGraph::pushSample() {
+    const auto column{ m_buffer.pushColumn() };
+
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, static_cast<GLint>(column), static_cast<GLsizei>(m_buffer.numRows()), 1,
+                    GL_RED, GL_UNSIGNED_BYTE, m_buffer.column().data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void HeatmapGraph::pushSample(int count) {
+    for (int i{ 0 }; i < count; ++i)
+        pushSample();
+}
+
+void HeatmapGraph::draw() const {
+    GLListContainer::inst().drawBorder();
+
+    const auto& shader{ WidgetShaderController::inst().getHeatmapShader() };
+    auto shaderScope{ shader.bind() };
+
+    glUniform1f(shader.getUniformLocation("scrollOffset"), m_buffer.scrollOffset());
+    glUniform4f(shader.getUniformLocation("color"), GRAPHLINE_R, GRAPHLINE_G, GRAPHLINE_B, GRAPHLINE_A);
+    glUniform1i(shader.getUniformLocation("heatmap"), 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    {
+        // The quad's vertices are generated in the vertex shader
+        auto vaoScope{ m_vao.bind() };
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+} // namespace rg
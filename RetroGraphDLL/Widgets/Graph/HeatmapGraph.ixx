@@ -0,0 +1,49 @@
+export module RG.Widgets.Graph:HeatmapGraph;
+
+import :HeatmapBuffer;
+
+import RG.Rendering;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+
+namespace rg {
+
+/* Scrolling heatmap of many values over time, e.g. the usage of every CPU core. Each row is one value and each
+ * column is one sample. It scales to any number of rows, since the whole heatmap is a single textured quad and each
+ * new sample only uploads one column of the texture.
+ * The texture is stored transposed (one texture row per column of the heatmap) so each column upload is contiguous.
+ */
+export class HeatmapGraph {
+public:
+    HeatmapGraph(size_t numSamples, size_t numRows);
+    ~HeatmapGraph();
+
+    HeatmapGraph(const HeatmapGraph&) = delete;
+    HeatmapGraph& operator=(const HeatmapGraph&) = delete;
+    HeatmapGraph(HeatmapGraph&&) = delete;
+    HeatmapGraph& operator=(HeatmapGraph&&) = delete;
+
+    // Sets the value (from 0 to 1) of a row in the next sample
+    void setValue(size_t row, float value) { m_buffer.setValue(row, value); }
+
+    // Adds the values set since the last call as the newest sample
+    void pushSample();
+
+    /* Adds the same sample count times, for a sample that covers several of the graph's sample intervals */
+    void pushSample(int count);
+
+    void draw() const;
+
+    size_t numRows() const { return m_buffer.numRows(); }
+
+private:
+    void initTexture();
+
+    HeatmapBuffer m_buffer;
+    GLuint m_textureID;
+    VAO m_vao;
+};
+
+} // namespace rg
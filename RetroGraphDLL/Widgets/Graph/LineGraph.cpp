@@ -5,6 +5,7 @@ import :GraphGrid;
 import Colors;
 
 import RG.Rendering;
+import RG.UserSettings;
 import RG.Widgets;
 
 import "GLHeaderUnit.h";
@@ -12,10 +13,48 @@ import "RGAssert.h";
 
 namespace rg {
 
-LineGraph::LineGraph(size_t numPoints)
+GraphPointFormat getGraphPointFormatSetting() {
+    const auto format{ UserSettings::inst().getVal<std::string>("Graphs.PointFormat") };
+    if (format == "uint16")
+        return GraphPointFormat::UNorm16;
+
+    RGASSERT(format == "float", std::format("Unknown graph point format {}", format).c_str());
+    return GraphPointFormat::Float;
+}
+
+size_t getGraphPointSizeBytes(GraphPointFormat format) {
+    return format == GraphPointFormat::UNorm16 ? sizeof(uint16_t) : sizeof(float);
+}
+
+void setGraphPointVertexFormat(GraphPointFormat format) {
+    constexpr GLuint vertexLocationIndex{ 0 };
+
+    // Only the y value of each point is stored. The shader derives x from gl_VertexID
+    glEnableVertexAttribArray(vertexLocationIndex);
+    if (format == GraphPointFormat::UNorm16) {
+        glVertexAttribPointer(vertexLocationIndex, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(uint16_t), nullptr);
+    } else {
+        glVertexAttribPointer(vertexLocationIndex, 1, GL_FLOAT, GL_FALSE, sizeof(float), nullptr);
+    }
+}
+
+void setGraphPointFormatUniforms(const Shader& shader, GraphPointFormat format) {
+    if (format == GraphPointFormat::UNorm16) {
+        glUniform1f(shader.getUniformLocation("yScale"), viewportWidth);
+        glUniform1f(shader.getUniformLocation("yBias"), viewportMin);
+    } else {
+        glUniform1f(shader.getUniformLocation("yScale"), 1.0f);
+        glUniform1f(shader.getUniformLocation("yBias"), 0.0f);
+    }
+}
+
+LineGraph::LineGraph(size_t numPoints, std::optional<SharedGraphVertices> sharedVertices)
     : m_graphVAO{}
-    , m_graphVerticesVBO{ GL_ARRAY_BUFFER, GL_STREAM_DRAW }
+    , m_graphVerticesVBO{ sharedVertices ? VBO{} : VBO{ GL_ARRAY_BUFFER, GL_STREAM_DRAW } }
     , m_pointBuffer{ numPoints }
+    , m_sharedVertices{ sharedVertices }
+    , m_pointFormat{ getGraphPointFormatSetting() }
+    , m_packedPoints{}
     , m_drawDecorations{ true }
     , m_modelView{} {
     initPointsVBO();
@@ -27,30 +66,25 @@ void LineGraph::draw() const {
         GraphGrid::inst().draw();
     }
 
-    drawPoints();
+    // Batched graphs are drawn together by their LineGraphBatch
+    if (!isBatched())
+        drawPoints();
 }
 
 void LineGraph::addPoint(float valueY) {
-    auto vboScope{ m_graphVerticesVBO.bind() };
-
-    // Value vectors can change size (infrequently).
-    // In this case we need to reallocate buffer data instead of just writing to it
-    if (m_pointBuffer.pushPoint(percentageToVP(valueY))) {
-        // All of the points have changed in this case so update the whole range of points in the VBO
-        m_graphVerticesVBO.bufferSubData(m_pointBuffer.tail() * sizeof(glm::vec2),
-                                         m_pointBuffer.numPoints() * sizeof(glm::vec2), m_pointBuffer.front());
-    } else {
-        // Only one point has changed here
-        m_graphVerticesVBO.bufferSubData(m_pointBuffer.head() * sizeof(glm::vec2), sizeof(glm::vec2),
-                                         m_pointBuffer.back());
-    }
+    // Only the new point has changed, the rest of the ring buffer stays in place
+    m_pointBuffer.pushPoint(percentageToVP(valueY));
+    uploadPoints(m_pointBuffer.numPoints() - 1, 1);
+}
+
+void LineGraph::addPoint(float valueY, int count) {
+    for (int i{ 0 }; i < count; ++i)
+        addPoint(valueY);
 }
 
 void LineGraph::resetPoints(size_t numPoints) {
     m_pointBuffer = GraphPointBuffer{ numPoints };
-
-    auto vboScope{ m_graphVerticesVBO.bind() };
-    m_graphVerticesVBO.bufferData(m_pointBuffer.bufferSize() * sizeof(glm::vec2), m_pointBuffer.data());
+    uploadAllPoints();
 }
 
 void LineGraph::setPoints(const std::vector<float>& values) {
@@ -61,34 +95,82 @@ void LineGraph::setPoints(const std::vector<float>& values) {
         value = percentageToVP(value);
 
     m_pointBuffer.setPoints(normalizedValues);
+    uploadAllPoints();
+}
+
+void LineGraph::uploadPoints(size_t index, size_t count) {
+    // The range may wrap around the end of the ring buffer, in which case it's uploaded as two parts
+    const auto bufferIndex{ m_pointBuffer.bufferIndex(index) };
+    const auto firstCount{ std::min(count, m_pointBuffer.bufferSize() - bufferIndex) };
 
-    auto vboScope{ m_graphVerticesVBO.bind() };
-    m_graphVerticesVBO.bufferData(m_pointBuffer.bufferSize() * sizeof(glm::vec2), m_pointBuffer.data());
+    uploadBufferRange(bufferIndex, firstCount);
+    if (firstCount < count)
+        uploadBufferRange(0, count - firstCount);
 }
 
-void LineGraph::initPointsVBO() {
-    constexpr GLuint vertexLocationIndex{ 0 };
+void LineGraph::uploadAllPoints() {
+    // The VBO has one extra point at the end which mirrors the first point. It joins the two draw ranges together.
+    const auto numPoints{ static_cast<size_t>(m_pointBuffer.bufferSize()) };
+    if (m_pointFormat == GraphPointFormat::UNorm16)
+        m_packedPoints.resize(numPoints);
 
-    auto vaoScope{ m_graphVAO.bind() };
-    auto vboScope{ m_graphVerticesVBO.bind() };
+    if (isBatched()) {
+        RGASSERT(numPoints + 1 <= m_sharedVertices->maxVertices, "Graph has too many points for its shared vertices");
+    } else {
+        auto vboScope{ m_graphVerticesVBO.bind() };
+        m_graphVerticesVBO.bufferData((numPoints + 1) * pointSizeBytes(), nullptr);
+    }
 
-    glEnableVertexAttribArray(vertexLocationIndex);
-    glVertexAttribPointer(vertexLocationIndex, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+    if (numPoints != 0)
+        uploadBufferRange(0, numPoints);
+}
 
-    m_graphVerticesVBO.bufferData(m_pointBuffer.bufferSize() * sizeof(glm::vec2), m_pointBuffer.data());
+void LineGraph::uploadBufferRange(size_t bufferIndex, size_t count) {
+    const auto& vbo{ verticesVBO() };
+    auto vboScope{ vbo.bind() };
+    const auto firstVertex{ isBatched() ? m_sharedVertices->firstVertex : 0 };
+
+    const void* points{ m_pointBuffer.data() + bufferIndex };
+    if (m_pointFormat == GraphPointFormat::UNorm16) {
+        std::transform(m_pointBuffer.data() + bufferIndex, m_pointBuffer.data() + bufferIndex + count,
+                       m_packedPoints.begin() + bufferIndex, packPointUNorm16);
+        points = &m_packedPoints[bufferIndex];
+    }
+    vbo.bufferSubData((firstVertex + bufferIndex) * pointSizeBytes(), count * pointSizeBytes(), points);
+
+    // Keep the mirror of the first point up to date
+    if (bufferIndex == 0 && count > 0)
+        vbo.bufferSubData((firstVertex + m_pointBuffer.bufferSize()) * pointSizeBytes(), pointSizeBytes(), points);
+}
+
+void LineGraph::initPointsVBO() {
+    // The vertex format of batched graphs is set up by the batch
+    if (!isBatched()) {
+        auto vaoScope{ m_graphVAO.bind() };
+        auto vboScope{ m_graphVerticesVBO.bind() };
+        setGraphPointVertexFormat(m_pointFormat);
+    }
+
+    uploadAllPoints();
 }
 
 void LineGraph::drawPoints() const {
     const auto& shader{ WidgetShaderController::inst().getLineGraphShader() };
     auto shaderScope{ shader.bind() };
-    const float xOffset{ (m_pointBuffer.tail() * -m_pointBuffer.getHorizontalPointInterval()) - 1.0f };
 
-    glUniform1f(shader.getUniformLocation("xOffset"), xOffset);
+    glUniform1i(shader.getUniformLocation("tail"), m_pointBuffer.tail());
+    glUniform1i(shader.getUniformLocation("numPoints"), m_pointBuffer.numPoints());
+    glUniform1f(shader.getUniformLocation("xOffset"), viewportMin);
+    glUniform1f(shader.getUniformLocation("xInterval"), m_pointBuffer.getHorizontalPointInterval());
+    setGraphPointFormatUniforms(shader, m_pointFormat);
     glUniform4f(shader.getUniformLocation("color"), GRAPHLINE_R, GRAPHLINE_G, GRAPHLINE_B, GRAPHLINE_A);
     glUniformMatrix4fv(shader.getUniformLocation("model"), 1, false, glm::value_ptr(m_modelView));
 
     auto vaoScope{ m_graphVAO.bind() };
-    glDrawArrays(GL_LINE_STRIP, static_cast<GLint>(m_pointBuffer.tail()), m_pointBuffer.numPoints());
+    for (const auto& range : m_pointBuffer.drawRanges()) {
+        if (range.count > 0)
+            glDrawArrays(GL_LINE_STRIP, range.first, range.count);
+    }
 }
 
 } // namespace rg
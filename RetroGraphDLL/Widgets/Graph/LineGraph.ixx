@@ -10,11 +10,36 @@ import "GLHeaderUnit.h";
 
 namespace rg {
 
+// A fixed size range of a vertex buffer that is shared by several graphs. See LineGraphBatch
+export struct SharedGraphVertices {
+    const VBO* vbo;
+    size_t firstVertex;
+    size_t maxVertices;
+};
+
+// Vertex format of graph points, read from the Graphs.PointFormat setting
+export GraphPointFormat getGraphPointFormatSetting();
+
+// Size in bytes of a single point in the given format
+export size_t getGraphPointSizeBytes(GraphPointFormat format);
+
+// Sets up vertex attribute 0 for points in the given format, on the bound VAO and VBO
+export void setGraphPointVertexFormat(GraphPointFormat format);
+
+// Sets the yScale and yBias uniforms that map points in the given format back to the viewport
+export void setGraphPointFormatUniforms(const Shader& shader, GraphPointFormat format);
+
 export class LineGraph {
 public:
-    explicit LineGraph(size_t numPoints);
+    // If sharedVertices is given, the graph's points are stored in that range instead of in a vertex buffer of its
+    // own, and the points are drawn by whatever owns the shared buffer rather than by draw().
+    explicit LineGraph(size_t numPoints, std::optional<SharedGraphVertices> sharedVertices = std::nullopt);
 
     virtual void addPoint(float valueY);
+
+    /* Adds the same point count times, for a sample that covers several of the graph's sample intervals */
+    void addPoint(float valueY, int count);
+
     virtual void resetPoints(size_t numPoints);
     virtual void setPoints(const std::vector<float>& values);
     void draw() const;
@@ -22,9 +47,19 @@ public:
     void setModelView(const glm::mat4& modelView) { m_modelView = modelView; }
     void setDrawDecorations(bool drawDecorations) { m_drawDecorations = drawDecorations; }
 
+    const glm::mat4& getModelView() const { return m_modelView; }
+    const GraphPointBuffer& getPointBuffer() const { return m_pointBuffer; }
+    bool isBatched() const { return m_sharedVertices.has_value(); }
+
 protected:
     virtual void drawPoints() const;
 
+    /* Uploads count points from the point buffer to the VBO, starting at point index (oldest first) */
+    void uploadPoints(size_t index, size_t count);
+
+    /* Reallocates the VBO and uploads the whole point buffer */
+    void uploadAllPoints();
+
     VAO m_graphVAO;
     VBO m_graphVerticesVBO;
 
@@ -32,6 +67,13 @@ protected:
 
 private:
     void initPointsVBO();
+    void uploadBufferRange(size_t bufferIndex, size_t count);
+    size_t pointSizeBytes() const { return getGraphPointSizeBytes(m_pointFormat); }
+    const VBO& verticesVBO() const { return isBatched() ? *m_sharedVertices->vbo : m_graphVerticesVBO; }
+
+    std::optional<SharedGraphVertices> m_sharedVertices;
+    GraphPointFormat m_pointFormat;
+    std::vector<uint16_t> m_packedPoints;
 
     bool m_drawDecorations;
     glm::mat4 m_modelView;
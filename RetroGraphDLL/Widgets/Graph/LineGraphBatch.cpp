@@ -0,0 +1,85 @@
+module RG.Widgets.Graph:LineGraphBatch;
+
+import Colors;
+
+import RG.Rendering;
+import RG.Widgets;
+
+import "GLHeaderUnit.h";
+import "RGAssert.h";
+
+namespace rg {
+
+constexpr GLuint graphParamsBinding{ 0 };
+
+LineGraphBatch::LineGraphBatch(size_t maxGraphs, size_t maxPointsPerGraph)
+    : m_maxGraphs{ maxGraphs }
+    , m_vertexStride{ maxPointsPerGraph + 1 } // Room for the mirror of the first point
+    , m_pointFormat{ getGraphPointFormatSetting() }
+    , m_vao{}
+    , m_verticesVBO{ GL_ARRAY_BUFFER, GL_STREAM_DRAW }
+    , m_graphParamsSSBO{ GL_SHADER_STORAGE_BUFFER, GL_STREAM_DRAW }
+    , m_graphs{}
+    , m_graphParams{}
+    , m_drawFirsts{}
+    , m_drawCounts{} {
+    m_graphs.reserve(m_maxGraphs);
+    m_graphParams.reserve(m_maxGraphs);
+    m_drawFirsts.reserve(2 * m_maxGraphs);
+    m_drawCounts.reserve(2 * m_maxGraphs);
+
+    initVAO();
+}
+
+void LineGraphBatch::initVAO() {
+    auto vaoScope{ m_vao.bind() };
+    auto vboScope{ m_verticesVBO.bind() };
+
+    m_verticesVBO.bufferData(m_maxGraphs * m_vertexStride * getGraphPointSizeBytes(m_pointFormat), nullptr);
+    setGraphPointVertexFormat(m_pointFormat);
+}
+
+void LineGraphBatch::draw() const {
+    if (m_graphs.empty())
+        return;
+
+    m_graphParams.clear();
+    m_drawFirsts.clear();
+    m_drawCounts.clear();
+    for (size_t i{ 0 }; i < m_graphs.size(); ++i) {
+        const auto& points{ m_graphs[i]->getPointBuffer() };
+        m_graphParams.push_back(LineGraphParams{ m_graphs[i]->getModelView(), points.tail(), points.numPoints(),
+                                                 points.getHorizontalPointInterval(), 0.0f });
+
+        const auto slotFirstVertex{ static_cast<GLint>(i * m_vertexStride) };
+        for (const auto& range : points.drawRanges()) {
+            if (range.count > 0) {
+                m_drawFirsts.push_back(slotFirstVertex + range.first);
+                m_drawCounts.push_back(range.count);
+            }
+        }
+    }
+
+    {
+        auto ssboScope{ m_graphParamsSSBO.bind() };
+        m_graphParamsSSBO.bufferData(m_graphParams.size() * sizeof(LineGraphParams), m_graphParams.data());
+    }
+
+    const auto& shader{ WidgetShaderController::inst().getLineGraphBatchShader() };
+    auto shaderScope{ shader.bind() };
+
+    glUniform1i(shader.getUniformLocation("vertexStride"), static_cast<GLint>(m_vertexStride));
+    glUniform1f(shader.getUniformLocation("xOffset"), viewportMin);
+    setGraphPointFormatUniforms(shader, m_pointFormat);
+    glUniform4f(shader.getUniformLocation("color"), GRAPHLINE_R, GRAPHLINE_G, GRAPHLINE_B, GRAPHLINE_A);
+
+    m_graphParamsSSBO.bindBase(graphParamsBinding);
+    {
+        auto vaoScope{ m_vao.bind() };
+        glMultiDrawArrays(GL_LINE_STRIP, m_drawFirsts.data(), m_drawCounts.data(),
+                          static_cast<GLsizei>(m_drawFirsts.size()));
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, graphParamsBinding, 0);
+}
+
+} // namespace rg
@@ -0,0 +1,81 @@
+export module RG.Widgets.Graph:LineGraphBatch;
+
+import :GraphPointBuffer;
+import :LineGraph;
+
+import RG.Rendering;
+
+import std.core;
+
+import "GLHeaderUnit.h";
+import "RGAssert.h";
+
+namespace rg {
+
+// Per graph parameters, laid out to match GraphParams in lineGraphBatch.vert (std430)
+struct LineGraphParams {
+    glm::mat4 model;
+    GLint tail;
+    GLint numPoints;
+    GLfloat xInterval;
+    GLfloat padding;
+};
+
+/* Draws a set of line graphs with a single draw call.
+ * The points of every graph are stored in one shared vertex buffer, where each graph has a fixed size slot. The
+ * parameters that LineGraph passes as uniforms (tail, point spacing, model view) are stored per graph in a shader
+ * storage buffer instead, and the shader finds a vertex's graph from its index. This lets every graph be drawn
+ * with one glMultiDrawArrays call rather than a shader bind, set of uniforms and draw call per graph.
+ * Graphs are positioned within the viewport by their model view.
+ */
+export class LineGraphBatch {
+public:
+    // Allocates room for maxGraphs graphs with up to maxPointsPerGraph points each
+    LineGraphBatch(size_t maxGraphs, size_t maxPointsPerGraph);
+
+    LineGraphBatch(const LineGraphBatch&) = delete;
+    LineGraphBatch& operator=(const LineGraphBatch&) = delete;
+    LineGraphBatch(LineGraphBatch&&) = delete;
+    LineGraphBatch& operator=(LineGraphBatch&&) = delete;
+
+    // Constructs a graph that stores its points in the batch. GraphT is constructed from args followed by the
+    // graph's SharedGraphVertices
+    template<std::derived_from<LineGraph> GraphT, typename... Args>
+    GraphT& addGraph(Args&&... args) {
+        RGASSERT(m_graphs.size() < m_maxGraphs, "Too many graphs in batch");
+
+        const SharedGraphVertices sharedVertices{ &m_verticesVBO, m_graphs.size() * m_vertexStride, m_vertexStride };
+        auto graph{ std::make_unique<GraphT>(std::forward<Args>(args)..., sharedVertices) };
+        auto& graphRef{ *graph };
+        m_graphs.push_back(std::move(graph));
+
+        return graphRef;
+    }
+
+    LineGraph& operator[](size_t index) { return *m_graphs[index]; }
+    const LineGraph& operator[](size_t index) const { return *m_graphs[index]; }
+    size_t size() const { return m_graphs.size(); }
+
+    // Draws the points of every graph. Each graph's borders and grid are still drawn by its own draw()
+    void draw() const;
+
+private:
+    void initVAO();
+
+    size_t m_maxGraphs;
+    size_t m_vertexStride;
+    GraphPointFormat m_pointFormat;
+
+    VAO m_vao;
+    VBO m_verticesVBO;
+    VBO m_graphParamsSSBO;
+
+    std::vector<std::unique_ptr<LineGraph>> m_graphs;
+
+    // Rebuilt every draw. Kept around so drawing doesn't allocate
+    mutable std::vector<LineGraphParams> m_graphParams;
+    mutable std::vector<GLint> m_drawFirsts;
+    mutable std::vector<GLsizei> m_drawCounts;
+};
+
+} // namespace rg
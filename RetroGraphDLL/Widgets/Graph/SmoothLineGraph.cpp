@@ -12,8 +12,8 @@ size_t getNumberOfCurvePoints(size_t numGraphSamples) {
     return (defaultPrecisionPoints - 1) * (numGraphSamples - 1) + 1;
 }
 
-SmoothLineGraph::SmoothLineGraph(size_t numGraphSamples)
-    : LineGraph{ getNumberOfCurvePoints(numGraphSamples) }
+SmoothLineGraph::SmoothLineGraph(size_t numGraphSamples, std::optional<SharedGraphVertices> sharedVertices)
+    : LineGraph{ getNumberOfCurvePoints(numGraphSamples), sharedVertices }
     , m_numSamples{ numGraphSamples }
     , m_precisionPoints{ defaultPrecisionPoints }
     , m_spline{} {
@@ -38,15 +38,13 @@ void SmoothLineGraph::addPoint(float valueY) {
     float segmentStep{ segmentWidth / (m_precisionPoints - 1) };
     float newSegmentStart{ viewportMax - segmentWidth };
     float oldSegmentStart{ viewportMax - (2 * segmentWidth) };
-    bool didBufferReallocate{ false };
 
     // Add the new points in the spline
     // Start at 1, since 0 would be the last point of the previous segment we already calculated.
     for (int i = 1; i < m_precisionPoints; ++i) {
         float splineX{ newSegmentStart + (i * segmentStep) };
         const float splineY{ clampToViewport(m_spline(splineX)) };
-        if (m_pointBuffer.pushPoint(splineY))
-            didBufferReallocate = true;
+        m_pointBuffer.pushPoint(splineY);
     }
 
     // Overwrite the existing points in the spline's previous segment
@@ -55,20 +53,11 @@ void SmoothLineGraph::addPoint(float valueY) {
     for (int i = 0; i < m_precisionPoints; ++i) {
         const float splineX{ oldSegmentStart + (i * segmentStep) };
         const float splineY{ clampToViewport(m_spline(splineX)) };
-        m_pointBuffer[oldSegmentStartIndex + i].y = splineY;
+        m_pointBuffer[oldSegmentStartIndex + i] = splineY;
     }
 
-    auto vboScope{ m_graphVerticesVBO.bind() };
-    if (didBufferReallocate) {
-        // All of the points have changed in this case so update the whole range of points in the VBO
-        m_graphVerticesVBO.bufferSubData(m_pointBuffer.tail() * sizeof(glm::vec2),
-                                         m_pointBuffer.numPoints() * sizeof(glm::vec2), m_pointBuffer.front());
-    } else {
-        // update only the final two segments which may have changed
-        m_graphVerticesVBO.bufferSubData((m_pointBuffer.tail() + oldSegmentStartIndex) * sizeof(glm::vec2),
-                                         (m_precisionPoints * 2) * sizeof(glm::vec2),
-                                         &m_pointBuffer[oldSegmentStartIndex]);
-    }
+    // update only the final two segments which may have changed
+    uploadPoints(oldSegmentStartIndex, m_pointBuffer.numPoints() - oldSegmentStartIndex);
 }
 
 void SmoothLineGraph::resetPoints(size_t numPoints) {
@@ -88,8 +77,7 @@ void SmoothLineGraph::resetPoints(size_t numPoints) {
 
     m_pointBuffer = GraphPointBuffer{ getNumberOfCurvePoints(m_numSamples) };
 
-    auto vboScope{ m_graphVerticesVBO.bind() };
-    m_graphVerticesVBO.bufferData(m_pointBuffer.bufferSize() * sizeof(glm::vec2), m_pointBuffer.data());
+    uploadAllPoints();
 }
 
 void SmoothLineGraph::setPoints(const std::vector<float>& values) {
@@ -112,8 +100,7 @@ void SmoothLineGraph::setPoints(const std::vector<float>& values) {
         m_pointBuffer.pushPoint(splineY);
     }
 
-    auto vboScope{ m_graphVerticesVBO.bind() };
-    m_graphVerticesVBO.bufferData(m_pointBuffer.bufferSize() * sizeof(glm::vec2), m_pointBuffer.data());
+    uploadAllPoints();
 
     // Cut down the spline to the last few points. Future updates will just add a single point to the end and we
     // only need a few points in the spine to update the curves
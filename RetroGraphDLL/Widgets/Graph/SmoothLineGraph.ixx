@@ -9,10 +9,15 @@ namespace rg {
 
 constexpr auto defaultPrecisionPoints = size_t{ 5 };
 
+// Number of points in the curve of a smooth graph with numGraphSamples samples
+export size_t getNumberOfCurvePoints(size_t numGraphSamples);
+
 export class SmoothLineGraph : public LineGraph {
 public:
-    explicit SmoothLineGraph(size_t numGraphSamples);
+    explicit SmoothLineGraph(size_t numGraphSamples,
+                             std::optional<SharedGraphVertices> sharedVertices = std::nullopt);
 
+    using LineGraph::addPoint;
     void addPoint(float valueY) override;
     void resetPoints(size_t numPoints) override;
     void setPoints(const std::vector<float>& values) override;
@@ -42,11 +42,11 @@ void SmoothMirrorLineGraph::draw() const {
     auto viewport{ getGLViewport() };
 
     // Draw the top graph in the top half of the viewport
-    glViewport(viewport.x, viewport.y + (viewport.height / 2), viewport.width, viewport.height / 2);
+    setGLViewport({ viewport.x, viewport.y + (viewport.height / 2), viewport.width, viewport.height / 2 });
     m_topGraph.draw();
 
     // Draw the bottom graph mirrored in the bottom half of the viewport
-    glViewport(viewport.x, viewport.y, viewport.width, viewport.height / 2);
+    setGLViewport({ viewport.x, viewport.y, viewport.width, viewport.height / 2 });
     m_bottomGraph.draw();
 }
 
@@ -12,28 +12,31 @@ namespace rg {
 HDDWidget::HDDWidget(const FontManager* fontManager, std::shared_ptr<const DriveMeasure> driveMeasure)
     : Widget{ fontManager }
     , m_driveMeasure{ driveMeasure }
-    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {}
+    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {
+    updateText();
+}
 
 HDDWidget::~HDDWidget() {
     m_driveMeasure->postUpdate.detach(m_postUpdateHandle);
 }
 
 void HDDWidget::draw() const {
+    const ProfileZone zone{ "HDDWidget::draw" };
+
     // Draw each drive status section
     const auto& drives{ m_driveMeasure->getDrives() };
     const auto numDrives{ static_cast<GLsizei>(drives.size()) };
     for (int i = 0; i < numDrives; ++i) {
-        glViewport(m_viewport.x + i * (m_viewport.width / numDrives), m_viewport.y, m_viewport.width / numDrives,
-                   m_viewport.height);
+        setGLViewport({ m_viewport.x + i * (m_viewport.width / numDrives), m_viewport.y, m_viewport.width / numDrives,
+                        m_viewport.height });
 
         // Draw the drive label on the bottom
-        glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
-        const char label[3]{ drives[i].driveLetter, ':', '\0' };
-        m_fontManager->renderLine(RG_FONT_STANDARD, label, 0, 0, 0, 0, RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_BOTTOM,
-                                  0, 10);
+        m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
+        m_fontManager->renderLine(RG_FONT_STANDARD, m_driveLabels[i], 0, 0, 0, 0,
+                                  RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_BOTTOM, 0, 10);
 
         // Draw the capacity up top
-        m_fontManager->renderLine(RG_FONT_STANDARD, getCapacityStr(drives[i].totalBytes).c_str(), 0, 0, 0, 0,
+        m_fontManager->renderLine(RG_FONT_STANDARD, m_capacityTexts[i], 0, 0, 0, 0,
                                   RG_ALIGN_CENTERED_HORIZONTAL | RG_ALIGN_TOP, 0, 10);
 
         drawVerticalProgressBar(0.3f, -0.5f, 0.5f, static_cast<float>(drives[i].totalBytes - drives[i].totalFreeBytes),
@@ -41,17 +44,27 @@ void HDDWidget::draw() const {
     }
 }
 
-std::string HDDWidget::getCapacityStr(uint64_t capacityBytes) const {
-    const auto capacityGB{ bToGB(capacityBytes) };
-    if (capacityGB < 1000) {
-        return std::format("{}GB", capacityGB);
-    } else {
-        return std::format("{:.1f}TB", capacityGB / 1024.0f);
+void HDDWidget::updateText() {
+    const auto& drives{ m_driveMeasure->getDrives() };
+    m_driveLabels.resize(drives.size());
+    m_capacityTexts.resize(drives.size());
+    for (auto i = size_t{ 0U }; i < drives.size(); ++i) {
+        m_driveLabels[i].format("{}:", drives[i].driveLetter);
+
+        const auto capacityGB{ bToGB(drives[i].totalBytes) };
+        if (capacityGB < 1000) {
+            m_capacityTexts[i].format("{}GB", capacityGB);
+        } else {
+            m_capacityTexts[i].format("{:.1f}TB", capacityGB / 1024.0f);
+        }
     }
 }
 
 PostUpdateEvent::Handle HDDWidget::RegisterPostUpdateCallback() {
-    return m_driveMeasure->postUpdate.attach([this]() { invalidate(); });
+    return m_driveMeasure->postUpdate.attach([this]() {
+        updateText();
+        invalidate();
+    });
 }
 
 } // namespace rg
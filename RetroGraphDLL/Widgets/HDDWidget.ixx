@@ -17,11 +17,14 @@ public:
     void draw() const override;
 
 private:
-    std::string getCapacityStr(uint64_t capacityBytes) const;
+    /* Formats the label and capacity of each drive into the text runs */
+    void updateText();
     PostUpdateEvent::Handle RegisterPostUpdateCallback();
 
     std::shared_ptr<const DriveMeasure> m_driveMeasure;
     PostUpdateEvent::Handle m_postUpdateHandle;
+    std::vector<TextRun> m_driveLabels;
+    std::vector<TextRun> m_capacityTexts;
 };
 
 } // namespace rg
@@ -4,26 +4,42 @@ import :WidgetShaderController;
 
 import Colors;
 
+import RG.Core;
 import RG.Rendering;
 
 import "GLHeaderUnit.h";
 
 namespace rg {
 
-MainWidget::MainWidget(const FontManager* fontManager, std::shared_ptr<const AnimationState> animationState)
+namespace {
+
+// Room for numElements with half as many again spare, so a rising count doesn't replace the buffer every update
+GLsizeiptr getStreamingBufferBytes(size_t numElements, size_t elementBytes) {
+    const auto numWithSpare{ std::max(numElements + numElements / 2, size_t{ 1U }) };
+    return static_cast<GLsizeiptr>(numWithSpare * elementBytes);
+}
+
+} // namespace
+
+MainWidget::MainWidget(const FontManager* fontManager, std::shared_ptr<AnimationState> animationState)
     : Widget{ fontManager }
     , m_animationState{ animationState }
     , m_postUpdateHandle{ RegisterPostUpdateCallback() }
     , m_particleLinesVAO{}
-    , m_particleLinesVBO{ GL_ARRAY_BUFFER, GL_STREAM_DRAW }
+    , m_particleLinesVBO{ getStreamingBufferBytes(m_animationState->getExpectedNumLines(), sizeof(ParticleLine)) }
+    , m_numLines{ 0 }
+    , m_linesMapped{ false }
     , m_particleVAO{}
-    , m_particleVBO{ static_cast<GLsizei>(m_animationState->getParticles().size()), GL_ARRAY_BUFFER, GL_STREAM_DRAW }
+    , m_particleVBO{ getStreamingBufferBytes(m_animationState->getParticles().count(), sizeof(ParticleVertex)) }
+    , m_numParticles{ 0 }
+    , m_unmappedOutput{}
     , m_onParticleShaderRefreshHandle{ WidgetShaderController::inst().getParticleShader().onRefresh.attach(
           [this]() { updateShaderModelMatrix(WidgetShaderController::inst().getParticleShader()); }) }
     , m_onParticleLineShaderRefreshHandle{ WidgetShaderController::inst().getParticleLineShader().onRefresh.attach(
           [this]() { updateShaderModelMatrix(WidgetShaderController::inst().getParticleLineShader()); }) } {
-    createParticleLinesVAO(maxLines);
+    createParticleLinesVAO();
     createParticleVAO();
+    m_animationState->setOutput(this);
 
     updateShaderModelMatrix(WidgetShaderController::inst().getParticleShader());
     updateShaderModelMatrix(WidgetShaderController::inst().getParticleLineShader());
@@ -33,9 +49,12 @@ MainWidget::~MainWidget() {
     WidgetShaderController::inst().getParticleLineShader().onRefresh.detach(m_onParticleLineShaderRefreshHandle);
     WidgetShaderController::inst().getParticleShader().onRefresh.detach(m_onParticleShaderRefreshHandle);
     m_animationState->postUpdate.detach(m_postUpdateHandle);
+    m_animationState->setOutput(nullptr);
 }
 
 void MainWidget::draw() const {
+    const ProfileZone zone{ "MainWidget::draw" };
+
     drawParticleLines();
     drawParticles();
 }
@@ -46,74 +65,94 @@ void MainWidget::drawParticles() const {
 
     glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
 
-    glDrawArrays(GL_POINTS, 0, m_particleVBO.size());
+    glDrawArrays(GL_POINTS, m_particleVBO.firstVertex(sizeof(ParticleVertex)), static_cast<GLsizei>(m_numParticles));
+    m_particleVBO.fenceDraw();
 }
 
 void MainWidget::drawParticleLines() const {
     auto shaderScope{ WidgetShaderController::inst().getParticleLineShader().bind() };
     auto vaoScope{ m_particleLinesVAO.bind() };
 
-    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(m_animationState->getNumLines() * 2));
+    // Each ParticleLine holds two vertices
+    glDrawArrays(GL_LINES, m_particleLinesVBO.firstVertex(sizeof(ParticleLine) / 2),
+                 static_cast<GLsizei>(m_numLines * 2));
+    m_particleLinesVBO.fenceDraw();
 }
 
 void MainWidget::createParticleVAO() {
     constexpr GLuint vertexLocationIndex{ 0 };
     constexpr GLuint scaleLocationIndex{ 1 };
 
-    auto& verts{ m_particleVBO.data() };
-    for (int i{ 0 }; i < m_animationState->getParticles().size(); ++i) {
-        verts[i] = m_animationState->getParticles()[i];
-    }
+    {
+        auto vaoScope{ m_particleVAO.bind() };
+        auto vboScope{ m_particleVBO.bind() };
 
-    auto vaoScope{ m_particleVAO.bind() };
-    auto vboScope{ m_particleVBO.bind() };
-
-    glEnableVertexAttribArray(vertexLocationIndex);
-    glVertexAttribPointer(vertexLocationIndex, 2, GL_FLOAT, GL_FALSE, m_particleVBO.elemBytes(), nullptr);
-
-    glEnableVertexAttribArray(scaleLocationIndex);
-    glVertexAttribPointer(scaleLocationIndex, 1, GL_FLOAT, GL_FALSE, m_particleVBO.elemBytes(),
-                          reinterpret_cast<GLvoid*>(sizeof(glm::vec2)));
+        glEnableVertexAttribArray(vertexLocationIndex);
+        glVertexAttribPointer(vertexLocationIndex, 2, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), nullptr);
 
-    m_particleVBO.bufferData();
+        glEnableVertexAttribArray(scaleLocationIndex);
+        glVertexAttribPointer(scaleLocationIndex, 1, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex),
+                              reinterpret_cast<GLvoid*>(sizeof(glm::vec2)));
+    }
 }
 
-void MainWidget::createParticleLinesVAO(size_t numLines) {
+void MainWidget::createParticleLinesVAO() {
     constexpr GLuint vertexLocationIndex{ 0 };
     constexpr GLuint lineLengthLocationIndex{ 1 };
 
-    auto vaoScope{ m_particleLinesVAO.bind() };
-    auto vboScope{ m_particleLinesVBO.bind() };
-
-    glEnableVertexAttribArray(vertexLocationIndex);
-    glVertexAttribPointer(vertexLocationIndex, 2, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
+    {
+        auto vaoScope{ m_particleLinesVAO.bind() };
+        auto vboScope{ m_particleLinesVBO.bind() };
 
-    glEnableVertexAttribArray(lineLengthLocationIndex);
-    glVertexAttribPointer(lineLengthLocationIndex, 1, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat),
-                          reinterpret_cast<GLvoid*>(sizeof(glm::vec2)));
+        glEnableVertexAttribArray(vertexLocationIndex);
+        glVertexAttribPointer(vertexLocationIndex, 2, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
 
-    m_particleLinesVBO.bufferData(numLines * sizeof(ParticleLine), m_animationState->getLines().data());
+        glEnableVertexAttribArray(lineLengthLocationIndex);
+        glVertexAttribPointer(lineLengthLocationIndex, 1, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat),
+                              reinterpret_cast<GLvoid*>(sizeof(glm::vec2)));
+    }
 }
 
-void MainWidget::updateParticleVAO() {
-    auto& verts{ m_particleVBO.data() };
-    for (int i{ 0 }; i < m_animationState->getParticles().size(); ++i) {
-        const auto& particle{ m_animationState->getParticles()[i] };
-        verts[i].position = { particle.x, particle.y };
+std::span<ParticleVertex> MainWidget::beginParticles(size_t numParticles) {
+    // The particle count can change while running
+    if (static_cast<GLsizeiptr>(numParticles * sizeof(ParticleVertex)) > m_particleVBO.getRegionBytes()) {
+        m_particleVBO.resize(getStreamingBufferBytes(numParticles, sizeof(ParticleVertex)));
+        createParticleVAO();
     }
 
-    auto vaoScope{ m_particleVAO.bind() };
-    auto vboScope{ m_particleVBO.bind() };
+    auto* const vertices{ static_cast<ParticleVertex*>(m_particleVBO.beginWrite()) };
+    if (!vertices) {
+        m_numParticles = 0;
+        return m_unmappedOutput.beginParticles(numParticles);
+    }
 
-    m_particleVBO.bufferSubData(0, m_particleVBO.sizeBytes());
+    m_numParticles = numParticles;
+    return { vertices, numParticles };
 }
 
-void MainWidget::updateParticleLinesVAO() {
-    auto vaoScope{ m_particleLinesVAO.bind() };
-    auto vboScope{ m_particleLinesVBO.bind() };
+void MainWidget::endParticles() {
+    m_particleVBO.endWrite();
+}
+
+std::span<ParticleLine> MainWidget::beginLines(size_t numLines) {
+    if (static_cast<GLsizeiptr>(numLines * sizeof(ParticleLine)) > m_particleLinesVBO.getRegionBytes()) {
+        m_particleLinesVBO.resize(getStreamingBufferBytes(numLines, sizeof(ParticleLine)));
+        createParticleLinesVAO();
+    }
+
+    // The whole region can be used, so lines only need searching again when there are more than it holds
+    const auto regionLines{ static_cast<size_t>(m_particleLinesVBO.getRegionBytes()) / sizeof(ParticleLine) };
+    auto* const lines{ static_cast<ParticleLine*>(m_particleLinesVBO.beginWrite()) };
+    m_linesMapped = lines != nullptr;
+    if (!m_linesMapped)
+        return m_unmappedOutput.beginLines(numLines);
+
+    return { lines, regionLines };
+}
 
-    m_particleLinesVBO.bufferSubData(0, m_animationState->getNumLines() * sizeof(ParticleLine),
-                                     m_animationState->getLines().data());
+void MainWidget::endLines(size_t numWritten) {
+    m_particleLinesVBO.endWrite();
+    m_numLines = m_linesMapped ? numWritten : 0;
 }
 
 void MainWidget::updateShaderModelMatrix(const Shader& shader) const {
@@ -127,11 +166,7 @@ void MainWidget::updateShaderModelMatrix(const Shader& shader) const {
 }
 
 PostUpdateEvent::Handle MainWidget::RegisterPostUpdateCallback() {
-    return m_animationState->postUpdate.attach([this]() {
-        updateParticleVAO();
-        updateParticleLinesVAO();
-        invalidate();
-    });
+    return m_animationState->postUpdate.attach([this]() { invalidate(); });
 }
 
 } // namespace rg
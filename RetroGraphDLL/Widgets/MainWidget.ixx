@@ -11,48 +11,47 @@ import "GLHeaderUnit.h";
 
 namespace rg {
 
-#pragma pack(push)
-#pragma pack(1)
-struct ParticleRenderData {
-    ParticleRenderData() = default;
-    ParticleRenderData(const Particle& particle)
-        : position{ particle.x, particle.y }
-        , scale{ particle.size } {}
-
-    glm::vec2 position;
-    float scale;
-};
-#pragma pack(pop)
-
-export class MainWidget : public Widget {
+/* Draws the particle animation. The animation writes its particles and lines straight into this widget's mapped
+ * vertex buffers as it updates, so nothing is copied on the way to the GPU
+ */
+export class MainWidget : public Widget, private ParticleOutput {
 public:
-    MainWidget(const FontManager* fontManager, std::shared_ptr<const AnimationState> animationState);
+    MainWidget(const FontManager* fontManager, std::shared_ptr<AnimationState> animationState);
     ~MainWidget() noexcept;
 
     void draw() const override;
 
 private:
+    std::span<ParticleVertex> beginParticles(size_t numParticles) override;
+    void endParticles() override;
+    std::span<ParticleLine> beginLines(size_t numLines) override;
+    void endLines(size_t numWritten) override;
+
     void drawParticles() const;
     void drawParticleLines() const;
 
     void createParticleVAO();
-    void createParticleLinesVAO(size_t numLines);
-
-    void updateParticleVAO();
-    void updateParticleLinesVAO();
+    void createParticleLinesVAO();
 
     void updateShaderModelMatrix(const Shader& shader) const;
 
     PostUpdateEvent::Handle RegisterPostUpdateCallback();
 
-    std::shared_ptr<const AnimationState> m_animationState;
+    std::shared_ptr<AnimationState> m_animationState;
     PostUpdateEvent::Handle m_postUpdateHandle;
 
+    // What was last written to the buffers, which can differ from the animation's current counts
     VAO m_particleLinesVAO;
-    VBO m_particleLinesVBO;
+    StreamingVBO m_particleLinesVBO;
+    size_t m_numLines;
+    bool m_linesMapped;
 
     VAO m_particleVAO;
-    OwningVBO<ParticleRenderData> m_particleVBO;
+    StreamingVBO m_particleVBO;
+    size_t m_numParticles;
+
+    // Takes the animation's output when a buffer can't be mapped. Nothing is drawn for that update
+    ParticleVectorOutput m_unmappedOutput;
 
     ShaderRefreshEvent::Handle m_onParticleShaderRefreshHandle;
     ShaderRefreshEvent::Handle m_onParticleLineShaderRefreshHandle;
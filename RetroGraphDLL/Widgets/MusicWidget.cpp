@@ -2,6 +2,7 @@ module RG.Widgets:MusicWidget;
 
 import Colors;
 
+import RG.Core;
 import RG.Rendering;
 
 import "GLHeaderUnit.h";
@@ -13,48 +14,68 @@ void createFormattedTimeStr(char* buffer, size_t buffSize, int seconds);
 MusicWidget::MusicWidget(const FontManager* fontManager, std::shared_ptr<const MusicMeasure> musicMeasure)
     : Widget{ fontManager }
     , m_musicMeasure{ musicMeasure }
-    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {}
+    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {
+    updateText();
+}
 
 MusicWidget::~MusicWidget() {
     m_musicMeasure->postUpdate.detach(m_postUpdateHandle);
 }
 
 void MusicWidget::draw() const {
+    const ProfileZone zone{ "MusicWidget::draw" };
+
     if (m_musicMeasure->isPlayerRunning()) {
-        glViewport(m_viewport.x, m_viewport.y + m_viewport.height / 4, m_viewport.width, 3 * m_viewport.height / 4);
-        glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+        setGLViewport({ m_viewport.x, m_viewport.y + m_viewport.height / 4, m_viewport.width,
+                        3 * m_viewport.height / 4 });
+        m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
 
-        m_fontManager->renderLine(RG_FONT_MUSIC_LARGE, m_musicMeasure->getTrackName(), 0, 0, 0, 0,
+        m_fontManager->renderLine(RG_FONT_MUSIC_LARGE, m_trackNameText, 0, 0, 0, 0,
                                   RG_ALIGN_TOP | RG_ALIGN_CENTERED_HORIZONTAL, 10, 30);
 
-        m_fontManager->renderLine(RG_FONT_STANDARD, m_musicMeasure->getArtist(), 0, 0, 0, 0,
+        m_fontManager->renderLine(RG_FONT_STANDARD, m_artistText, 0, 0, 0, 0,
                                   RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_CENTERED_HORIZONTAL);
 
-        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_musicMeasure->getAlbum(), 0, 0, 0, 0,
+        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_albumText, 0, 0, 0, 0,
                                   RG_ALIGN_BOTTOM | RG_ALIGN_CENTERED_HORIZONTAL, 10, 30);
 
         const auto elapsed{ m_musicMeasure->getElapsedTime() };
         const auto total{ m_musicMeasure->getTotalTime() };
 
-        char elapsedBuff[21];
-        char totalBuff[10];
-        createFormattedTimeStr(elapsedBuff, sizeof(elapsedBuff), static_cast<int>(elapsed.count()));
-        createFormattedTimeStr(totalBuff, sizeof(totalBuff), static_cast<int>(total.count()));
-        strcat_s(elapsedBuff, sizeof(elapsedBuff), "/");
-        strcat_s(elapsedBuff, sizeof(elapsedBuff), totalBuff);
-
-        glViewport(m_viewport.x, m_viewport.y, m_viewport.width, m_viewport.height / 4);
-        m_fontManager->renderLine(-0.9f, 0.5f, RG_FONT_STANDARD, elapsedBuff, static_cast<int>(strlen(elapsedBuff)));
+        setGLViewport({ m_viewport.x, m_viewport.y, m_viewport.width, m_viewport.height / 4 });
+        const auto& progressStr{ m_progressText.getText() };
+        m_fontManager->renderLine(-0.9f, 0.5f, RG_FONT_STANDARD, progressStr.c_str(),
+                                  static_cast<int>(progressStr.size()));
         drawHorizontalProgressBar(0.3f, -0.9f, 0.9f, static_cast<float>(elapsed.count()),
                                   static_cast<float>(total.count()));
     } else {
-        m_fontManager->renderLine(RG_FONT_TIME, "No Media", 0, 0, 0, 0,
+        m_fontManager->renderLine(RG_FONT_TIME, m_noMediaLabel, 0, 0, 0, 0,
                                   RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_CENTERED_HORIZONTAL, 10, 10);
     }
 }
 
+void MusicWidget::updateText() {
+    m_trackNameText.setText(m_musicMeasure->getTrackName());
+    m_artistText.setText(m_musicMeasure->getArtist());
+    m_albumText.setText(m_musicMeasure->getAlbum());
+
+    const auto elapsed{ m_musicMeasure->getElapsedTime() };
+    const auto total{ m_musicMeasure->getTotalTime() };
+
+    char elapsedBuff[21];
+    char totalBuff[10];
+    createFormattedTimeStr(elapsedBuff, sizeof(elapsedBuff), static_cast<int>(elapsed.count()));
+    createFormattedTimeStr(totalBuff, sizeof(totalBuff), static_cast<int>(total.count()));
+    strcat_s(elapsedBuff, sizeof(elapsedBuff), "/");
+    strcat_s(elapsedBuff, sizeof(elapsedBuff), totalBuff);
+    m_progressText.setText(elapsedBuff);
+}
+
 PostUpdateEvent::Handle MusicWidget::RegisterPostUpdateCallback() {
-    return m_musicMeasure->postUpdate.attach([this]() { invalidate(); });
+    return m_musicMeasure->postUpdate.attach([this]() {
+        updateText();
+        invalidate();
+    });
 }
 
 void createFormattedTimeStr(char* buffer, size_t buffSize, int seconds) {
@@ -5,7 +5,7 @@ import :Widget;
 import RG.Measures;
 import RG.Rendering;
 
-import std.memory;
+import std.core;
 
 namespace rg {
 
@@ -17,10 +17,18 @@ public:
     void draw() const override;
 
 private:
+    /* Copies the track info and formats the track progress into the text runs */
+    void updateText();
     PostUpdateEvent::Handle RegisterPostUpdateCallback();
 
     std::shared_ptr<const MusicMeasure> m_musicMeasure;
     PostUpdateEvent::Handle m_postUpdateHandle;
+
+    TextRun m_trackNameText;
+    TextRun m_artistText;
+    TextRun m_albumText;
+    TextRun m_progressText;
+    TextRun m_noMediaLabel{ "No Media" };
 };
 
 } // namespace rg
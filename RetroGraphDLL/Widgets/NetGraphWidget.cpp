@@ -6,6 +6,18 @@ import RG.Core;
 
 namespace rg {
 
+namespace {
+
+int64_t getLowerBoundSetting(std::string_view settingName) {
+    return KB * UserSettings::inst().getVal<int, int64_t>(settingName);
+}
+
+float getHysteresisSetting() {
+    return UserSettings::inst().getVal<double, float>("Widgets-NetGraph.ScaleHysteresis");
+}
+
+} // namespace
+
 NetGraphWidget::NetGraphWidget(const FontManager* fontManager, std::shared_ptr<const NetMeasure> netMeasure)
     : Widget{ fontManager }
     , m_netMeasure{ netMeasure }
@@ -14,13 +26,12 @@ NetGraphWidget::NetGraphWidget(const FontManager* fontManager, std::shared_ptr<c
     , m_configRefreshedHandle{ RegisterConfigRefreshedCallback() }
     , m_graphSampleSize{ UserSettings::inst().getVal<int>("Widgets-NetGraph.NumUsageSamples") }
     , m_netGraph{ static_cast<size_t>(m_graphSampleSize) }
-    , m_downLowerBound{ KB *
-                        UserSettings::inst().getVal<int, int64_t>("Widgets-NetGraph.DownloadDataScaleLowerBoundKB") }
-    , m_upLowerBound{ KB * UserSettings::inst().getVal<int, int64_t>("Widgets-NetGraph.UploadDataScaleLowerBoundKB") }
-    , m_maxDownValue{ m_downLowerBound }
-    , m_maxUpValue{ m_upLowerBound }
-    , m_downBytes(static_cast<size_t>(m_graphSampleSize), 0)
-    , m_upBytes(static_cast<size_t>(m_graphSampleSize), 0) {}
+    , m_downBytes{ static_cast<size_t>(m_graphSampleSize),
+                   getLowerBoundSetting("Widgets-NetGraph.DownloadDataScaleLowerBoundKB"), getHysteresisSetting() }
+    , m_upBytes{ static_cast<size_t>(m_graphSampleSize),
+                 getLowerBoundSetting("Widgets-NetGraph.UploadDataScaleLowerBoundKB"), getHysteresisSetting() } {
+    updateScaleLabels();
+}
 
 NetGraphWidget::~NetGraphWidget() {
     UserSettings::inst().configRefreshed.detach(m_configRefreshedHandle);
@@ -29,113 +40,102 @@ NetGraphWidget::~NetGraphWidget() {
 }
 
 void NetGraphWidget::draw() const {
+    const ProfileZone zone{ "NetGraphWidget::draw" };
+
     { // Draw the line graphs
-        glViewport(m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height);
+        setGLViewport({ m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height });
         m_netGraph.draw();
     }
 
     { // Text
-        glViewport(m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5, m_viewport.height);
-        glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+        setGLViewport({ m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5,
+                        m_viewport.height });
+        m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
 
-        m_fontManager->renderLine(RG_FONT_SMALL, getScaleLabel(m_maxDownValue), 0, 0, m_viewport.width / 5,
-                                  m_viewport.height, RG_ALIGN_TOP | RG_ALIGN_LEFT);
+        m_fontManager->renderLine(RG_FONT_SMALL, m_downScaleLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
+                                  RG_ALIGN_TOP | RG_ALIGN_LEFT);
 
-        m_fontManager->renderLine(RG_FONT_SMALL, "Down / Up", 0, 0, m_viewport.width / 5, m_viewport.height,
+        m_fontManager->renderLine(RG_FONT_SMALL, m_titleLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                                   RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_LEFT);
-        m_fontManager->renderLine(RG_FONT_SMALL, getScaleLabel(m_maxUpValue), 0, 0, m_viewport.width / 5,
-                                  m_viewport.height, RG_ALIGN_BOTTOM | RG_ALIGN_LEFT);
+        m_fontManager->renderLine(RG_FONT_SMALL, m_upScaleLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
+                                  RG_ALIGN_BOTTOM | RG_ALIGN_LEFT);
     }
 }
 
-std::string NetGraphWidget::getScaleLabel(int64_t bytesTransferred) const {
-    const std::string_view suffix = [bytesTransferred]() {
-        if (bytesTransferred > 1000 * 1000)
-            return "MB";
-        else if (bytesTransferred > 1000)
-            return "KB";
-        else
-            return "B";
-    }(); // Call immediately
-
-    if (suffix == "MB") {
-        char buff[8];
-        snprintf(buff, sizeof(buff), "%5.1fMB", bytesTransferred / static_cast<float>(MB));
-        return buff;
-    } else if (suffix == "KB") {
-        char buff[8];
-        snprintf(buff, sizeof(buff), "%5.1fKB", bytesTransferred / static_cast<float>(KB));
-        return buff;
+void NetGraphWidget::setScaleLabel(TextRun& label, int64_t bytesTransferred) const {
+    if (bytesTransferred > 1000 * 1000) {
+        label.format("{:5.1f}MB", bytesTransferred / static_cast<float>(MB));
+    } else if (bytesTransferred > 1000) {
+        label.format("{:5.1f}KB", bytesTransferred / static_cast<float>(KB));
     } else {
-        char buff[5];
-        snprintf(buff, sizeof(buff), "%3lluB", bytesTransferred);
-        return buff;
+        label.format("{:3}B", bytesTransferred);
     }
 }
 
-void NetGraphWidget::addUsageValue(NetBytesQueue& usageQueue, LineGraph& graph, int64_t& currentMaxValue,
-                                   int64_t lowerBound, int64_t usageValue) {
-    // Remove old data and add the new to ensure queue maintains fixed size
-    usageQueue.pop_front();
-    usageQueue.push_back(usageValue);
-
-    // Calculate the maximum value in the dataset to determine the scale to use.
-    int64_t upValue{ *std::max_element(usageQueue.cbegin(), usageQueue.cend()) };
-
-    // Make sure the scale never goes lower than the lower bound set by the user.
-    upValue = std::max(upValue, lowerBound);
-
-    bool scaleChanged{ false };
-    if (currentMaxValue != upValue) {
-        currentMaxValue = upValue;
-        scaleChanged = true;
-    }
+void NetGraphWidget::updateScaleLabels() {
+    setScaleLabel(m_downScaleLabel, m_downBytes.scale());
+    setScaleLabel(m_upScaleLabel, m_upBytes.scale());
+}
 
-    const auto maxValueMB{ currentMaxValue / static_cast<float>(MB) };
-    if (scaleChanged) {
-        std::vector<float> normalizedData;
-        normalizedData.reserve(usageQueue.size());
-        for (const auto up : usageQueue) {
-            normalizedData.push_back((up / static_cast<float>(MB)) / maxValueMB);
-        }
+void NetGraphWidget::addUsageValue(AutoScaleWindow<int64_t>& usageWindow, LineGraph& graph, int64_t usageValue) {
+    // The window tracks its own maximum, so finding the scale doesn't require a pass over every sample
+    if (usageWindow.push(usageValue)) {
         // If the scale of our data changed then we need to set all of the points again in the graph
         // so can recalculate the whole curve
-        graph.setPoints(normalizedData);
+        setGraphPoints(usageWindow, graph);
     } else {
-        float normalizedUpMB{ (usageQueue.back() / static_cast<float>(MB)) / maxValueMB };
-        graph.addPoint(normalizedUpMB);
+        graph.addPoint(usageValue / static_cast<float>(usageWindow.scale()));
     }
 
+    updateScaleLabels();
     invalidate();
 }
 
+void NetGraphWidget::setGraphPoints(const AutoScaleWindow<int64_t>& usageWindow, LineGraph& graph) {
+    const auto& window{ usageWindow.window() };
+    const auto scale{ static_cast<float>(usageWindow.scale()) };
+
+    std::vector<float> normalizedData;
+    normalizedData.reserve(window.size());
+    for (auto i = size_t{ 0U }; i < window.size(); ++i) {
+        normalizedData.push_back(window[i] / scale);
+    }
+    graph.setPoints(normalizedData);
+}
+
 NetUsageEvent::Handle NetGraphWidget::RegisterNetDownBytesCallback() {
     return m_netMeasure->onDownBytes.attach([this](int64_t downBytes) {
-        addUsageValue(m_downBytes, m_netGraph.topGraph(), m_maxDownValue, m_downLowerBound, downBytes);
+        addUsageValue(m_downBytes, m_netGraph.topGraph(), downBytes);
     });
 }
 
 NetUsageEvent::Handle NetGraphWidget::RegisterNetUpBytesCallback() {
     return m_netMeasure->onUpBytes.attach([this](int64_t upBytes) {
-        addUsageValue(m_upBytes, m_netGraph.bottomGraph(), m_maxUpValue, m_upLowerBound, upBytes);
+        addUsageValue(m_upBytes, m_netGraph.bottomGraph(), upBytes);
     });
 }
 
 ConfigRefreshedEvent::Handle NetGraphWidget::RegisterConfigRefreshedCallback() {
     return UserSettings::inst().configRefreshed.attach([this]() {
-        m_downLowerBound =
-            KB * UserSettings::inst().getVal<int, int64_t>("Widgets-NetGraph.DownloadDataScaleLowerBoundKB");
-        m_upLowerBound = KB * UserSettings::inst().getVal<int, int64_t>("Widgets-NetGraph.UploadDataScaleLowerBoundKB");
+        const auto hysteresis{ getHysteresisSetting() };
+        const bool downScaleChanged{ m_downBytes.setBounds(
+            getLowerBoundSetting("Widgets-NetGraph.DownloadDataScaleLowerBoundKB"), hysteresis) };
+        const bool upScaleChanged{ m_upBytes.setBounds(
+            getLowerBoundSetting("Widgets-NetGraph.UploadDataScaleLowerBoundKB"), hysteresis) };
 
         const int newGraphSampleSize{ UserSettings::inst().getVal<int>("Widgets-NetGraph.NumUsageSamples") };
         if (m_graphSampleSize != newGraphSampleSize) {
             m_graphSampleSize = newGraphSampleSize;
             m_netGraph.resetPoints(m_graphSampleSize);
-            m_maxDownValue = m_downLowerBound;
-            m_maxUpValue = m_upLowerBound;
-            m_downBytes = NetBytesQueue(static_cast<size_t>(m_graphSampleSize), 0);
-            m_upBytes = NetBytesQueue(static_cast<size_t>(m_graphSampleSize), 0);
+            m_downBytes.reset(static_cast<size_t>(m_graphSampleSize));
+            m_upBytes.reset(static_cast<size_t>(m_graphSampleSize));
+        } else {
+            if (downScaleChanged)
+                setGraphPoints(m_downBytes, m_netGraph.topGraph());
+            if (upScaleChanged)
+                setGraphPoints(m_upBytes, m_netGraph.bottomGraph());
         }
+        updateScaleLabels();
         invalidate();
     });
 }
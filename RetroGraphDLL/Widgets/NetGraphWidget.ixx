@@ -2,6 +2,7 @@ export module RG.Widgets:NetGraphWidget;
 
 import :Widget;
 
+import RG.Core;
 import RG.Measures;
 import RG.Rendering;
 import RG.UserSettings;
@@ -11,8 +12,6 @@ import std.core;
 
 namespace rg {
 
-using NetBytesQueue = std::deque<int64_t>;
-
 export class NetGraphWidget : public Widget {
 public:
     NetGraphWidget(const FontManager* fontManager, std::shared_ptr<const NetMeasure> netMeasure);
@@ -21,9 +20,11 @@ public:
     void draw() const override;
 
 private:
-    std::string getScaleLabel(int64_t bytesTransferred) const;
-    void addUsageValue(NetBytesQueue& usageQueue, LineGraph& graph, int64_t& currentMaxValue, int64_t lowerBound,
-                       int64_t usageValue);
+    /* Formats the graph's scale into a label */
+    void setScaleLabel(TextRun& label, int64_t bytesTransferred) const;
+    void updateScaleLabels();
+    void addUsageValue(AutoScaleWindow<int64_t>& usageWindow, LineGraph& graph, int64_t usageValue);
+    void setGraphPoints(const AutoScaleWindow<int64_t>& usageWindow, LineGraph& graph);
 
     NetUsageEvent::Handle RegisterNetDownBytesCallback();
     NetUsageEvent::Handle RegisterNetUpBytesCallback();
@@ -37,12 +38,12 @@ private:
     int m_graphSampleSize;
     SmoothMirrorLineGraph m_netGraph;
 
-    int64_t m_downLowerBound;
-    int64_t m_upLowerBound;
-    int64_t m_maxDownValue;
-    int64_t m_maxUpValue;
-    NetBytesQueue m_downBytes;
-    NetBytesQueue m_upBytes;
+    AutoScaleWindow<int64_t> m_downBytes;
+    AutoScaleWindow<int64_t> m_upBytes;
+
+    TextRun m_downScaleLabel;
+    TextRun m_titleLabel{ "Down / Up" };
+    TextRun m_upScaleLabel;
 };
 
 } // namespace rg
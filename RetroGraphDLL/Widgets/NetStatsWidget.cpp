@@ -2,6 +2,8 @@ module RG.Widgets:NetStatsWidget;
 
 import Colors;
 
+import RG.Core;
+
 import "GLHeaderUnit.h";
 
 namespace rg {
@@ -24,7 +26,9 @@ NetStatsWidget::~NetStatsWidget() {
 }
 
 void NetStatsWidget::draw() const {
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+    const ProfileZone zone{ "NetStatsWidget::draw" };
+
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
     m_fontManager->renderLines(RG_FONT_STANDARD, m_statsStrings, 0, 0, m_viewport.width, m_viewport.height,
                                RG_ALIGN_LEFT | RG_ALIGN_CENTERED_VERTICAL, 15, 10);
 }
@@ -2,42 +2,48 @@ module RG.Widgets:ProcessCPUWidget;
 
 import Colors;
 
+import RG.Core;
+
 namespace rg {
 
 ProcessCPUWidget::ProcessCPUWidget(const FontManager* fontManager, std::shared_ptr<const ProcessMeasure> processMeasure)
     : Widget{ fontManager }
     , m_procMeasure{ processMeasure }
-    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {}
+    , m_postUpdateHandle{ RegisterPostUpdateCallback() } {
+    updateText();
+}
 
 ProcessCPUWidget::~ProcessCPUWidget() {
     m_procMeasure->postUpdate.detach(m_postUpdateHandle);
 }
 
 void ProcessCPUWidget::draw() const {
+    const ProfileZone zone{ "ProcessCPUWidget::draw" };
+
     // Draw the list itself
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
-
-    auto procNames = std::vector<std::string>{};
-    auto procPercentages = std::vector<std::string>{};
-    procNames.reserve(m_procMeasure->getProcCPUData().size());
-    procPercentages.reserve(m_procMeasure->getProcCPUData().size());
-    for (const auto& pair : m_procMeasure->getProcCPUData()) {
-        procNames.emplace_back(pair.first);
-
-        // Convert percentage to string format
-        char buff[6];
-        snprintf(buff, sizeof(buff), "%4.1f%%", pair.second);
-        procPercentages.emplace_back(buff);
-    }
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
 
-    m_fontManager->renderLines(RG_FONT_STANDARD, procNames, 0, 0, 0, 0, RG_ALIGN_LEFT | RG_ALIGN_CENTERED_VERTICAL, 15,
-                               5);
-    m_fontManager->renderLines(RG_FONT_STANDARD, procPercentages, 0, 0, 0, 0,
+    m_fontManager->renderLines(RG_FONT_STANDARD, m_procNames, 0, 0, 0, 0, RG_ALIGN_LEFT | RG_ALIGN_CENTERED_VERTICAL,
+                               15, 5);
+    m_fontManager->renderLines(RG_FONT_STANDARD, m_procPercentages, 0, 0, 0, 0,
                                RG_ALIGN_RIGHT | RG_ALIGN_CENTERED_VERTICAL, 15, 5);
 }
 
+void ProcessCPUWidget::updateText() {
+    const auto& procCPUData{ m_procMeasure->getProcCPUData() };
+    m_procNames.resize(procCPUData.size());
+    m_procPercentages.resize(procCPUData.size());
+    for (auto i = size_t{ 0U }; i < procCPUData.size(); ++i) {
+        m_procNames[i].setText(procCPUData[i].first);
+        m_procPercentages[i].format("{:4.1f}%", procCPUData[i].second);
+    }
+}
+
 PostUpdateEvent::Handle ProcessCPUWidget::RegisterPostUpdateCallback() {
-    return m_procMeasure->postUpdate.attach([this]() { invalidate(); });
+    return m_procMeasure->postUpdate.attach([this]() {
+        updateText();
+        invalidate();
+    });
 }
 
 } // namespace rg
@@ -5,7 +5,7 @@ import :Widget;
 import RG.Measures;
 import RG.Rendering;
 
-import std.memory;
+import std.core;
 
 namespace rg {
 
@@ -17,10 +17,14 @@ public:
     void draw() const override;
 
 private:
+    /* Formats the process list into the text runs */
+    void updateText();
     PostUpdateEvent::Handle RegisterPostUpdateCallback();
 
     std::shared_ptr<const ProcessMeasure> m_procMeasure{ nullptr };
     PostUpdateEvent::Handle m_postUpdateHandle;
+    std::vector<TextRun> m_procNames;
+    std::vector<TextRun> m_procPercentages;
 };
 
 } // namespace rg
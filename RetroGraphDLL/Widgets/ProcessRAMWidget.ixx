@@ -5,25 +5,26 @@ import :Widget;
 import RG.Measures;
 import RG.Rendering;
 
-import std.memory;
+import std.core;
 
 namespace rg {
 
 export class ProcessRAMWidget : public Widget {
 public:
-    ProcessRAMWidget(const FontManager* fontManager, std::shared_ptr<const ProcessMeasure> processMeasure)
-        : Widget{ fontManager }
-        , m_procMeasure{ processMeasure } {}
-
+    ProcessRAMWidget(const FontManager* fontManager, std::shared_ptr<const ProcessMeasure> processMeasure);
     ~ProcessRAMWidget();
 
     void draw() const override;
 
 private:
+    /* Formats the process list into the text runs */
+    void updateText();
     PostUpdateEvent::Handle RegisterPostUpdateCallback();
 
     std::shared_ptr<const ProcessMeasure> m_procMeasure{ nullptr };
     PostUpdateEvent::Handle m_postUpdateHandle;
+    std::vector<TextRun> m_procNames;
+    std::vector<TextRun> m_procRAMUsages;
 };
 
 } // namespace rg
@@ -2,6 +2,8 @@ module RG.Widgets:RAMGraphWidget;
 
 import Colors;
 
+import RG.Core;
+
 namespace rg {
 
 RAMGraphWidget::RAMGraphWidget(const FontManager* fontManager, std::shared_ptr<const RAMMeasure> ramMeasure)
@@ -18,25 +20,27 @@ RAMGraphWidget::~RAMGraphWidget() {
 }
 
 void RAMGraphWidget::draw() const {
+    const ProfileZone zone{ "RAMGraphWidget::draw" };
+
     // Set the viewport for the graph itself to be left section
-    glViewport(m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height);
+    setGLViewport({ m_viewport.x, m_viewport.y, (m_viewport.width * 4) / 5, m_viewport.height });
     m_graph.draw();
 
     // Set viewport for text drawing
-    glViewport(m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5, m_viewport.height);
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+    setGLViewport({ m_viewport.x + (4 * m_viewport.width) / 5, m_viewport.y, m_viewport.width / 5, m_viewport.height });
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
 
-    m_fontManager->renderLine(RG_FONT_SMALL, "0%", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->renderLine(RG_FONT_SMALL, m_minLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_BOTTOM | RG_ALIGN_LEFT, 10);
-    m_fontManager->renderLine(RG_FONT_SMALL, "RAM Load", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->renderLine(RG_FONT_SMALL, m_titleLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_LEFT, 10);
-    m_fontManager->renderLine(RG_FONT_SMALL, "100%", 0, 0, m_viewport.width / 5, m_viewport.height,
+    m_fontManager->renderLine(RG_FONT_SMALL, m_maxLabel, 0, 0, m_viewport.width / 5, m_viewport.height,
                               RG_ALIGN_TOP | RG_ALIGN_LEFT, 10);
 }
 
 RAMUsageEvent::Handle RAMGraphWidget::RegisterRAMUsageCallback() {
     return m_ramMeasure->onRAMUsage.attach([this](float usage) {
-        m_graph.addPoint(usage);
+        m_graph.addPoint(usage, m_ramMeasure->getSampleSpan());
         invalidate();
     });
 }
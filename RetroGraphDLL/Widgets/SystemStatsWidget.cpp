@@ -44,7 +44,9 @@ SystemStatsWidget::SystemStatsWidget(const FontManager* fontManager, std::shared
 }
 
 void SystemStatsWidget::draw() const {
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
+    const ProfileZone zone{ "SystemStatsWidget::draw" };
+
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
     m_fontManager->renderLines(RG_FONT_STANDARD, m_statsStrings, 0, 0, m_viewport.width, m_viewport.height,
                                RG_ALIGN_LEFT | RG_ALIGN_CENTERED_VERTICAL, 15, 10);
 }
@@ -2,6 +2,7 @@ module RG.Widgets:TimeWidget;
 
 import Colors;
 
+import RG.Core;
 import RG.Rendering;
 
 import "GLHeaderUnit.h";
@@ -15,7 +16,10 @@ TimeWidget::TimeWidget(const FontManager* fontManager, std::shared_ptr<const Tim
     , m_timeMeasure{ timeMeasure }
     , m_netMeasure{ netMeasure }
     , m_timePostUpdateHandle{ RegisterTimePostUpdateCallback() }
-    , m_netConnectionStatusChangedHandle{ RegisterNetConnectionStatusChangedCallback() } {}
+    , m_netConnectionStatusChangedHandle{ RegisterNetConnectionStatusChangedCallback() } {
+    updateTimeText();
+    updateNetStatusText();
+}
 
 TimeWidget::~TimeWidget() {
     m_netMeasure->onConnectionStatusChanged.detach(m_netConnectionStatusChangedHandle);
@@ -23,6 +27,8 @@ TimeWidget::~TimeWidget() {
 }
 
 void TimeWidget::draw() const {
+    const ProfileZone zone{ "TimeWidget::draw" };
+
     constexpr float leftDivX{ -0.33f };
     constexpr float rightDivX{ 0.33f };
     constexpr float midDivY{ -0.3f };
@@ -42,27 +48,22 @@ void TimeWidget::draw() const {
     }
     glEnd();
 
-    glColor4f(TEXT_R, TEXT_G, TEXT_B, TEXT_A);
-
-    const auto localTime{ m_timeMeasure->getLocalTime() };
+    m_fontManager->setTextColor({ TEXT_R, TEXT_G, TEXT_B, TEXT_A });
 
     // Draw the big system time and the date below
-    const std::string timeString{ std::format("{:%T}", localTime) };
-    m_fontManager->renderLine(RG_FONT_TIME, timeString, 0, midDivYPx, m_viewport.width, m_viewport.height - midDivYPx,
+    m_fontManager->renderLine(RG_FONT_TIME, m_timeText, 0, midDivYPx, m_viewport.width, m_viewport.height - midDivYPx,
                               RG_ALIGN_CENTERED_VERTICAL | RG_ALIGN_CENTERED_HORIZONTAL);
 
     // Draw the uptime in bottom-left
-    m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, "Uptime", 0, 0, m_viewport.width / 3, midDivYPx,
+    m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_uptimeLabel, 0, 0, m_viewport.width / 3, midDivYPx,
                               RG_ALIGN_RIGHT | RG_ALIGN_TOP, 10, 15);
-    m_fontManager->renderLine(RG_FONT_STANDARD, getUptimeStr(), 0, 0, m_viewport.width / 3, midDivYPx,
+    m_fontManager->renderLine(RG_FONT_STANDARD, m_uptimeText, 0, 0, m_viewport.width / 3, midDivYPx,
                               RG_ALIGN_RIGHT | RG_ALIGN_BOTTOM, 10, 15);
 
     // Draw the year and month and day in bottom-middle
-    const std::string dateString{ std::format("{:%d %B}", localTime) };
-    const std::string dayString{ std::format("{:%A}", localTime) };
-    m_fontManager->renderLine(RG_FONT_STANDARD, dateString, vpCoordsToPixels(leftDivX, m_viewport.width), 0,
+    m_fontManager->renderLine(RG_FONT_STANDARD, m_dateText, vpCoordsToPixels(leftDivX, m_viewport.width), 0,
                               m_viewport.width / 3, midDivYPx, RG_ALIGN_BOTTOM | RG_ALIGN_CENTERED_HORIZONTAL, 10, 15);
-    m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, dayString, vpCoordsToPixels(leftDivX, m_viewport.width), 0,
+    m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_dayText, vpCoordsToPixels(leftDivX, m_viewport.width), 0,
                               m_viewport.width / 3, midDivYPx, RG_ALIGN_TOP | RG_ALIGN_CENTERED_HORIZONTAL, 10, 15);
 
     // Draw network connection status in bottom-right
@@ -73,32 +74,44 @@ void TimeWidget::draw() const {
         const auto renderWidth{ m_viewport.width - renderX };
         const auto renderHeight{ vpCoordsToPixels(midDivY, m_viewport.height) };
 
-        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, "Network", renderX, renderY, renderWidth, renderHeight,
+        m_fontManager->renderLine(RG_FONT_STANDARD_BOLD, m_netLabel, renderX, renderY, renderWidth, renderHeight,
                                   RG_ALIGN_LEFT | RG_ALIGN_TOP, 10, 15);
-
-        const std::string netStatusString{ m_netMeasure->isConnected() ? "UP" : "DOWN" };
-        m_fontManager->renderLine(RG_FONT_STANDARD, netStatusString, renderX, renderY, renderWidth, renderHeight,
+        m_fontManager->renderLine(RG_FONT_STANDARD, m_netStatusText, renderX, renderY, renderWidth, renderHeight,
                                   RG_ALIGN_LEFT | RG_ALIGN_BOTTOM, 10, 15);
     }
 };
 
-std::string TimeWidget::getUptimeStr() const {
+void TimeWidget::updateTimeText() {
+    const auto localTime{ m_timeMeasure->getLocalTime() };
+    m_timeText.format("{:%T}", localTime);
+    m_dateText.format("{:%d %B}", localTime);
+    m_dayText.format("{:%A}", localTime);
+
     const std::chrono::seconds uptime{ m_timeMeasure->getUptime() };
     const auto uptimeS{ uptime % 60 };
     const auto uptimeM{ (uptime / 60) % 60 };
     const auto uptimeH{ (uptime / (60 * 60)) % 24 };
     const auto uptimeD{ (uptime / (60 * 60 * 24)) };
+    m_uptimeText.format("{:0>2}:{:0>2}:{:0>2}:{:0>2}", uptimeD.count(), uptimeH.count(), uptimeM.count(),
+                        uptimeS.count());
+}
 
-    return std::format("{:0>2}:{:0>2}:{:0>2}:{:0>2}", uptimeD.count(), uptimeH.count(), uptimeM.count(),
-                       uptimeS.count());
+void TimeWidget::updateNetStatusText() {
+    m_netStatusText.setText(m_netMeasure->isConnected() ? "UP" : "DOWN");
 }
 
 PostUpdateEvent::Handle TimeWidget::RegisterTimePostUpdateCallback() {
-    return m_timeMeasure->postUpdate.attach([this]() { invalidate(); });
+    return m_timeMeasure->postUpdate.attach([this]() {
+        updateTimeText();
+        invalidate();
+    });
 }
 
 ConnectionStatusChangedEvent::Handle TimeWidget::RegisterNetConnectionStatusChangedCallback() {
-    return m_netMeasure->onConnectionStatusChanged.attach([this](bool /*connectionStatus*/) { invalidate(); });
+    return m_netMeasure->onConnectionStatusChanged.attach([this](bool /*connectionStatus*/) {
+        updateNetStatusText();
+        invalidate();
+    });
 }
 
 } // namespace rg
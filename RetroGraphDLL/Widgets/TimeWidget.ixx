@@ -19,7 +19,9 @@ public:
     void draw() const override;
 
 private:
-    std::string getUptimeStr() const;
+    /* Formats the time, date and uptime into the text runs */
+    void updateTimeText();
+    void updateNetStatusText();
 
     PostUpdateEvent::Handle RegisterTimePostUpdateCallback();
     ConnectionStatusChangedEvent::Handle RegisterNetConnectionStatusChangedCallback();
@@ -29,6 +31,14 @@ private:
 
     PostUpdateEvent::Handle m_timePostUpdateHandle;
     ConnectionStatusChangedEvent::Handle m_netConnectionStatusChangedHandle;
+
+    TextRun m_timeText;
+    TextRun m_dateText;
+    TextRun m_dayText;
+    TextRun m_uptimeLabel{ "Uptime" };
+    TextRun m_uptimeText;
+    TextRun m_netLabel{ "Network" };
+    TextRun m_netStatusText;
 };
 
 } // namespace rg
@@ -2,6 +2,8 @@ module RG.Widgets:Widget;
 
 import RG.Rendering;
 
+import "GLHeaderUnit.h";
+
 namespace rg {
 
 Widget::~Widget() {
@@ -15,4 +17,36 @@ void Widget::clear() const {
     }
 }
 
+bool Widget::updateRenderCache(bool drawBackground) {
+    // A recreated cache has undefined contents, so it's drawn whether or not the widget changed
+    const bool cacheRecreated{ m_renderCache.setArea(m_viewport) };
+    if (m_renderCache.isEmpty() || !(cacheRecreated || needsRedraw()))
+        return false;
+
+    renderToCache(drawBackground);
+    return true;
+}
+
+void Widget::presentRenderCache() const {
+    if (!m_renderCache.isEmpty())
+        m_renderCache.blitToWindow();
+}
+
+void Widget::renderToCache(bool drawBackground) {
+    auto frameBufferScope{ m_renderCache.bind() };
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    setGLViewport(m_viewport);
+    if (drawBackground)
+        drawWidgetBackground();
+
+    GLListContainer::inst().drawTopAndBottomSerifs();
+
+    draw();
+
+    // The widget's text is drawn into the cache with the rest of the widget
+    m_fontManager->drawText();
+    validate();
+}
+
 } // namespace rg
@@ -29,6 +29,14 @@ public:
     /* Clears the widget's entire viewport */
     virtual void clear() const;
 
+    /* Draws the widget into its render cache if it needs redrawing. Returns whether the cache was drawn, in which
+     * case the widget's viewport is damaged and has to be presented again.
+     * Widgets that haven't changed keep their cache, so slow widgets don't hold up ones that redraw every frame */
+    bool updateRenderCache(bool drawBackground);
+
+    /* Copies the render cache into the window */
+    void presentRenderCache() const;
+
     /* Sets the viewport for the entire widget. Should be overriden
        for widgets with sub-viewports */
     virtual void setViewport(const Viewport& vp) { m_viewport = vp; }
@@ -44,7 +52,10 @@ protected:
     const FontManager* m_fontManager;
 
 private:
+    void renderToCache(bool drawBackground);
+
     bool m_needsRedraw;
+    FrameBuffer m_renderCache;
 };
 
 } // namespace rg
@@ -79,23 +79,17 @@ void WidgetContainer::removeChild(Widget* child) {
     invalidate();
 }
 
-void WidgetContainer::draw() {
-    if (isVisible()) {
-        for (auto* widget : m_children) {
-            if (widget->needsRedraw()) {
-                widget->clear();
-
-                setGLViewport(widget->getViewport());
-
-                if (m_drawBackground)
-                    rg::drawWidgetBackground();
-
-                GLListContainer::inst().drawTopAndBottomSerifs();
+void WidgetContainer::draw(DamageRegion& damage) {
+    for (auto* widget : m_children) {
+        if (widget->updateRenderCache(m_drawBackground))
+            damage.add(widget->getViewport());
+    }
+}
 
-                widget->draw();
-                widget->validate();
-            }
-        }
+void WidgetContainer::present(const DamageRegion& damage) const {
+    for (const auto* widget : m_children) {
+        if (damage.intersects(widget->getViewport()))
+            widget->presentRenderCache();
     }
 }
 
@@ -26,7 +26,12 @@ public:
     explicit WidgetContainer(WidgetPosition p, bool drawBackground);
     ~WidgetContainer();
 
-    void draw();
+    /* Draws every widget that changed into its render cache, and adds the changed widgets' viewports to damage */
+    void draw(DamageRegion& damage);
+
+    /* Copies every widget touched by damage into the window */
+    void present(const DamageRegion& damage) const;
+
     bool isVisible() const;
 
     void setViewport(int windowWidth, int windowHeight, WidgetPosition pos);
@@ -35,7 +40,10 @@ public:
     void clearChildren() { m_children.clear(); }
     void setType(ContainerType t) { m_type = t; }
     void resetType() { m_type = getFillTypeFromPosition(m_pos); }
-    void setDrawBackground(bool drawBackground) { m_drawBackground = drawBackground; }
+    void setDrawBackground(bool drawBackground) {
+        m_drawBackground = drawBackground;
+        invalidate();
+    }
 
 private:
     void invalidate();
@@ -14,6 +14,8 @@ public:
     const Shader& getParticleLineShader() const { return m_particleLineShader; }
     const Shader& getParticleShader() const { return m_particleShader; }
     const Shader& getLineGraphShader() const { return m_lineGraphShader; }
+    const Shader& getLineGraphBatchShader() const { return m_lineGraphBatchShader; }
+    const Shader& getHeatmapShader() const { return m_heatmapShader; }
 
 private:
     WidgetShaderController() = default;
@@ -21,6 +23,8 @@ private:
     Shader m_particleLineShader{ "particleLine" };
     Shader m_particleShader{ "particle" };
     Shader m_lineGraphShader{ "lineGraph" };
+    Shader m_lineGraphBatchShader{ "lineGraphBatch.vert", "lineGraph.frag" };
+    Shader m_heatmapShader{ "heatmap" };
 };
 
 } // namespace rg
@@ -18,6 +18,7 @@
 #include <tchar.h>
 #include <TlHelp32.h>
 #include <winternl.h>
+#include <wtsapi32.h>
 #include <pathcch.h>
 #include <profileapi.h>
 #include <sys/types.h>
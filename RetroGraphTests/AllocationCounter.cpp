@@ -0,0 +1,28 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::size_t> numAllocations{ 0 };
+
+std::size_t getNumAllocations() {
+    return numAllocations.load();
+}
+
+// Array and nothrow forms of new call these by default, so they are counted too
+void* operator new(std::size_t size) {
+    ++numAllocations;
+    if (void* ptr{ std::malloc(size == 0 ? 1 : size) })
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+/* Gets the number of calls to the global operator new so far. Counted by the replacement operator new in
+ * AllocationCounter.cpp, for tests that check code doesn't allocate */
+std::size_t getNumAllocations();
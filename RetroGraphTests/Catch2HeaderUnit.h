@@ -1,3 +1,4 @@
 #pragma once
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch2.hpp>
@@ -0,0 +1,176 @@
+export module UnitTests.Test_AdaptiveInterval;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+namespace {
+
+// Traces are recorded at one value per minimum interval
+constexpr milliseconds tick{ 250 };
+
+rg::AdaptiveIntervalSettings makeSettings() {
+    return { .minInterval = tick, .maxInterval = tick * 8, .changeThreshold = 0.05f, .stableSamplesToWiden = 3 };
+}
+
+// Usage of a mostly idle machine, with a little noise
+std::vector<float> makeIdleTrace(size_t numTicks) {
+    rg::Pcg32 random{ 1234U };
+    std::vector<float> trace(numTicks);
+    for (auto& value : trace)
+        value = random.nextFloat(0.01f, 0.04f);
+    return trace;
+}
+
+// The idle trace with a short burst of high usage every burstPeriod ticks
+std::vector<float> makeBurstyTrace(size_t numTicks, size_t burstPeriod, size_t burstLength) {
+    auto trace{ makeIdleTrace(numTicks) };
+    for (auto start = burstPeriod / 2; start + burstLength <= numTicks; start += burstPeriod)
+        std::fill_n(trace.begin() + start, burstLength, 0.9f);
+    return trace;
+}
+
+struct ReplayedSample {
+    size_t endTick; // The tick the sample was taken at, covering the ticks before it
+    float value;
+    int span;
+    milliseconds nextInterval;
+};
+
+/* Samples a trace the way a measure would. Each sample is the trace averaged over the interval since the previous
+ * one, like the CPU usage reported for an interval. The samples are also laid out on a graph with one point per tick,
+ * each repeated by the span it covered
+ */
+struct Replay {
+    std::vector<ReplayedSample> samples;
+    std::vector<float> graph;
+
+    Replay(const std::vector<float>& trace, rg::AdaptiveInterval& interval) {
+        size_t lastTick{ 0U };
+        while (true) {
+            const auto span{ interval.getSampleSpan() };
+            const auto endTick{ lastTick + static_cast<size_t>(span) };
+            if (endTick > trace.size())
+                break;
+
+            const auto sum{ std::accumulate(trace.begin() + lastTick, trace.begin() + endTick, 0.0f) };
+            const auto value{ sum / span };
+            const auto nextInterval{ interval.addSample(value) };
+
+            samples.push_back({ endTick, value, span, nextInterval });
+            graph.insert(graph.end(), static_cast<size_t>(span), value);
+            lastTick = endTick;
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("Core::AdaptiveInterval. Widening and tightening", "[adaptive_interval]") {
+    rg::AdaptiveInterval interval{ makeSettings() };
+    REQUIRE(interval.getInterval() == tick);
+    REQUIRE(interval.getSampleSpan() == 1);
+
+    SECTION("First sample keeps the minimum interval") {
+        REQUIRE(interval.addSample(0.5f) == tick);
+    }
+
+    SECTION("Stable samples double the interval up to the maximum") {
+        interval.addSample(0.5f);
+        const std::vector<milliseconds> expected{ tick,     tick,     tick * 2, tick * 2, tick * 2, tick * 4,
+                                                  tick * 4, tick * 4, tick * 8, tick * 8, tick * 8, tick * 8 };
+        for (const auto& expectedInterval : expected)
+            REQUIRE(interval.addSample(0.52f) == expectedInterval);
+        REQUIRE(interval.getSampleSpan() == 8);
+    }
+
+    SECTION("A change drops straight back to the minimum") {
+        for (int i{ 0 }; i < 12; ++i)
+            interval.addSample(0.5f);
+        REQUIRE(interval.getInterval() == tick * 8);
+
+        REQUIRE(interval.addSample(0.6f) == tick);
+        REQUIRE(interval.getSampleSpan() == 1);
+    }
+
+    SECTION("Slow drift counts as a change once it's past the threshold") {
+        interval.addSample(0.5f);
+        for (int i{ 1 }; i <= 4; ++i)
+            interval.addSample(0.5f + 0.01f * i);
+        REQUIRE(interval.getInterval() == tick * 2);
+
+        REQUIRE(interval.addSample(0.56f) == tick);
+    }
+
+    SECTION("Invalid settings are clamped") {
+        interval.setSettings({ .minInterval = 0ms, .maxInterval = -1ms, .stableSamplesToWiden = 0 });
+        REQUIRE(interval.getSettings().minInterval == 1ms);
+        REQUIRE(interval.getSettings().maxInterval == 1ms);
+        REQUIRE(interval.getSettings().stableSamplesToWiden == 1);
+    }
+}
+
+TEST_CASE("Core::AdaptiveInterval. Replayed traces", "[adaptive_interval]") {
+    rg::AdaptiveInterval interval{ makeSettings() };
+    constexpr size_t numTicks{ 4 * 60 * 60 }; // An hour
+
+    SECTION("An idle machine is sampled much less often") {
+        const Replay replay{ makeIdleTrace(numTicks), interval };
+
+        // Sampling at a fixed rate would take numTicks samples
+        REQUIRE(replay.samples.size() < numTicks / 6);
+        REQUIRE(replay.samples.back().nextInterval == tick * 8);
+    }
+
+    SECTION("A steady load reaches the maximum interval") {
+        const std::vector<float> trace(numTicks, 0.5f);
+        const Replay replay{ trace, interval };
+
+        const auto firstMax{ std::find_if(replay.samples.begin(), replay.samples.end(),
+                                          [](const auto& sample) { return sample.nextInterval == tick * 8; }) };
+        REQUIRE(firstMax != replay.samples.end());
+        REQUIRE(std::all_of(firstMax, replay.samples.end(),
+                            [](const auto& sample) { return sample.nextInterval == tick * 8; }));
+    }
+
+    SECTION("Every short burst is caught and followed at the minimum interval") {
+        constexpr size_t burstPeriod{ 400U };
+        constexpr size_t burstLength{ 4U };
+        const auto trace{ makeBurstyTrace(numTicks, burstPeriod, burstLength) };
+        const Replay replay{ trace, interval };
+
+        REQUIRE(replay.samples.size() < numTicks / 4);
+
+        for (auto start = burstPeriod / 2; start + burstLength <= numTicks; start += burstPeriod) {
+            // The first sample to cover any of the burst shows it, even averaged over the longest interval
+            const auto covering{ std::find_if(replay.samples.begin(), replay.samples.end(),
+                                              [start](const auto& sample) { return sample.endTick > start; }) };
+            REQUIRE(covering != replay.samples.end());
+            REQUIRE(covering->value > 0.1f);
+            REQUIRE(covering->nextInterval == tick);
+
+            // Sampling stays at the minimum interval until the burst is over
+            for (auto it = covering; it != replay.samples.end() && it->endTick <= start + burstLength; ++it)
+                REQUIRE(it->nextInterval == tick);
+        }
+    }
+
+    SECTION("Samples land on the graph where they were taken") {
+        const auto trace{ makeBurstyTrace(numTicks, 400U, 4U) };
+        const Replay replay{ trace, interval };
+
+        REQUIRE(replay.graph.size() == replay.samples.back().endTick);
+
+        size_t lastTick{ 0U };
+        for (const auto& sample : replay.samples) {
+            REQUIRE(sample.endTick - lastTick == static_cast<size_t>(sample.span));
+            for (auto i = lastTick; i < sample.endTick; ++i)
+                REQUIRE(replay.graph[i] == sample.value);
+            lastTick = sample.endTick;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+export module UnitTests.Test_DurationHistogram;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+TEST_CASE("Core::DurationHistogram. Buckets", "[duration_histogram]") {
+    rg::DurationHistogram histogram;
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getPercentile(0.5) == 0us);
+    REQUIRE(histogram.getMean() == 0us);
+
+    // Durations under 8us have a bucket each
+    histogram.record(0us);
+    histogram.record(1us);
+    histogram.record(3us);
+    histogram.record(4us);
+    histogram.record(7us);
+    REQUIRE(histogram.getBucketCount(0) == 1);
+    REQUIRE(histogram.getBucketCount(1) == 1);
+    REQUIRE(histogram.getBucketCount(3) == 1);
+    REQUIRE(histogram.getBucketCount(4) == 1);
+    REQUIRE(histogram.getBucketCount(7) == 1);
+    REQUIRE(histogram.getCount() == 5);
+    REQUIRE(histogram.getMax() == 7us);
+    REQUIRE(histogram.getMean() == 3us);
+
+    SECTION("Negative durations count as zero") {
+        histogram.record(-5us);
+        REQUIRE(histogram.getBucketCount(0) == 2);
+    }
+
+    SECTION("Larger durations are split into 8 buckets per power of two") {
+        // 100us is in [96, 104)
+        histogram.record(100us);
+        REQUIRE(histogram.getBucketCount(36) == 1);
+        REQUIRE(rg::DurationHistogram::getBucketUpperBound(35) == 96us);
+        REQUIRE(rg::DurationHistogram::getBucketUpperBound(36) == 104us);
+    }
+
+    SECTION("Huge durations go in the last bucket") {
+        histogram.record(hours{ 24 * 365 });
+        REQUIRE(histogram.getBucketCount(rg::DurationHistogram::numBuckets - 1) == 1);
+    }
+
+    SECTION("Clearing") {
+        histogram.clear();
+        REQUIRE(histogram.getCount() == 0);
+        REQUIRE(histogram.getBucketCount(7) == 0);
+        REQUIRE(histogram.getMax() == 0us);
+    }
+}
+
+TEST_CASE("Core::DurationHistogram. Percentiles", "[duration_histogram]") {
+    rg::DurationHistogram histogram;
+
+    // 98 frames woke up within 100us, one 1.5ms late and one 20ms late
+    for (int i{ 0 }; i < 98; ++i)
+        histogram.record(microseconds{ 50 + i % 50 });
+    histogram.record(1500us);
+    histogram.record(20000us);
+
+    // Percentiles are the upper bound of their bucket, so within 12.5% of the exact value. The median is 74us
+    REQUIRE(histogram.getPercentile(0.5) == 80us);
+    REQUIRE(histogram.getPercentile(0.98) == 104us);
+    REQUIRE(histogram.getPercentile(0.99) == 1536us);
+    REQUIRE(histogram.getPercentile(0.0) == 52us);
+
+    // but never more than the largest duration
+    REQUIRE(histogram.getPercentile(1.0) == 20000us);
+}
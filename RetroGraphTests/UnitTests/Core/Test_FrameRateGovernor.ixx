@@ -0,0 +1,127 @@
+export module UnitTests.Test_FrameRateGovernor;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+namespace {
+
+// Simulated clock starting from the clock's epoch, so tests don't depend on real time
+const steady_clock::time_point start{};
+
+rg::FrameRateLimits makeLimits() {
+    return { .minFPS = 1, .maxFPS = 30, .interactionHoldTime = 2s };
+}
+
+// A measure that updates on the first frame after it's due, the same way Measure::update does
+struct SimulatedMeasure {
+    milliseconds interval;
+    steady_clock::time_point lastUpdate{ start };
+
+    void update(steady_clock::time_point now) {
+        if (now - lastUpdate >= interval)
+            lastUpdate = now;
+    }
+
+    steady_clock::time_point getNextUpdateTime() const { return lastUpdate + interval; }
+};
+
+} // namespace
+
+TEST_CASE("Core::FrameRateGovernor. Transitions", "[frame_rate_governor]") {
+    rg::FrameRateGovernor governor{ makeLimits() };
+    const auto maxFrameTime{ duration_cast<steady_clock::duration>(duration<double>{ 1.0 / 30.0 }) };
+
+    SECTION("Full rate while animating") {
+        const rg::FrameRateInputs inputs{ .animating = true, .nextMeasureUpdate = start + 1s };
+        REQUIRE(governor.getNextFrameTime(start, inputs) == start + maxFrameTime);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Full);
+        REQUIRE(governor.getTargetFPS() == Approx{ 30.0 }.epsilon(0.001));
+    }
+
+    SECTION("Idle frames are scheduled for the next measure update") {
+        const rg::FrameRateInputs inputs{ .nextMeasureUpdate = start + 500ms };
+        REQUIRE(governor.getNextFrameTime(start, inputs) == start + 500ms);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Idle);
+        REQUIRE(governor.getTargetFPS() == Approx{ 2.0 });
+    }
+
+    SECTION("Idle frames are no faster than the maximum rate") {
+        const rg::FrameRateInputs inputs{ .nextMeasureUpdate = start + 1ms };
+        REQUIRE(governor.getNextFrameTime(start, inputs) == start + maxFrameTime);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Idle);
+    }
+
+    SECTION("Idle frames are no slower than the minimum rate") {
+        const rg::FrameRateInputs inputs{ .nextMeasureUpdate = start + 30s };
+        REQUIRE(governor.getNextFrameTime(start, inputs) == start + 1s);
+        REQUIRE(governor.getTargetFPS() == Approx{ 1.0 });
+
+        REQUIRE(governor.getNextFrameTime(start, {}) == start + 1s);
+    }
+
+    SECTION("Full rate while interacting") {
+        const rg::FrameRateInputs inputs{ .nextMeasureUpdate = start + 1s };
+        governor.notifyUserInput(start);
+        REQUIRE(governor.getNextFrameTime(start + 1s, inputs) == start + 1s + maxFrameTime);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Full);
+
+        // Back to idle once the user has stopped for the hold time
+        REQUIRE(governor.getNextFrameTime(start + 2s, { .nextMeasureUpdate = start + 3s }) == start + 3s);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Idle);
+    }
+
+    SECTION("Suspended stops drawing and resumes afterwards") {
+        governor.notifyUserInput(start);
+        REQUIRE_FALSE(governor.getNextFrameTime(start, { .animating = true, .suspended = true }).has_value());
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Suspended);
+        REQUIRE(governor.getTargetFPS() == 0.0);
+
+        REQUIRE(governor.getNextFrameTime(start + 1s, { .animating = true }) == start + 1s + maxFrameTime);
+        REQUIRE(governor.getMode() == rg::FrameRateMode::Full);
+    }
+
+    SECTION("Minimum rate is clamped to the maximum rate") {
+        governor.setLimits({ .minFPS = 60, .maxFPS = 10 });
+        REQUIRE(governor.getLimits().minFPS == 10);
+        REQUIRE(governor.getNextFrameTime(start, {}) == start + 100ms);
+    }
+}
+
+TEST_CASE("Core::FrameRateGovernor. Idle run", "[frame_rate_governor]") {
+    // Ten minutes with the clock, CPU and RAM measures updating every second and the drive measure every 30 seconds,
+    // and nothing animating. The number of frames stands in for CPU time, as every frame updates and draws
+    constexpr auto runTime{ 10min };
+    std::array measures{ SimulatedMeasure{ 1000ms }, SimulatedMeasure{ 1000ms }, SimulatedMeasure{ 1000ms },
+                         SimulatedMeasure{ 30000ms } };
+
+    rg::FrameRateGovernor governor{ makeLimits() };
+    int numFrames{ 0 };
+    int numMeasureUpdates{ 0 };
+    for (auto now{ start }; now < start + runTime; ++numFrames) {
+        rg::FrameRateInputs inputs{};
+        for (auto& measure : measures) {
+            const auto lastUpdate{ measure.lastUpdate };
+            measure.update(now);
+            numMeasureUpdates += measure.lastUpdate != lastUpdate;
+
+            const auto nextUpdate{ measure.getNextUpdateTime() };
+            if (!inputs.nextMeasureUpdate || nextUpdate < *inputs.nextMeasureUpdate)
+                inputs.nextMeasureUpdate = nextUpdate;
+        }
+
+        now = *governor.getNextFrameTime(now, inputs);
+    }
+
+    // A fixed 30 FPS draws 18000 frames. The governor draws one frame per second when the measures are due
+    const auto fixedRateFrames{ duration_cast<seconds>(runTime).count() * 30 };
+    REQUIRE(numFrames <= duration_cast<seconds>(runTime).count() + 1);
+    REQUIRE(numFrames * 25 < fixedRateFrames);
+
+    // No measure update is delayed by the lower frame rate
+    REQUIRE(numMeasureUpdates >= 3 * 599 + 19);
+}
@@ -0,0 +1,82 @@
+export module UnitTests.Test_JobSystem;
+
+import RG.Core;
+
+import std.core;
+import std.threading;
+
+import "Catch2HeaderUnit.h";
+
+TEST_CASE("Core::JobSystem. Parallel for", "[job_system]") {
+    for (const size_t numThreads : { size_t{ 1U }, size_t{ 2U }, size_t{ 4U } }) {
+        rg::JobSystem jobs{ numThreads };
+        REQUIRE(jobs.getNumThreads() == numThreads);
+
+        for (const size_t numJobs : { size_t{ 0U }, size_t{ 1U }, size_t{ 3U }, size_t{ 1000U } }) {
+            std::vector<std::atomic<int>> timesRun(numJobs);
+            std::atomic<bool> validThreadIndices{ true };
+
+            jobs.parallelFor(numJobs, [&](size_t job, size_t threadIndex) {
+                ++timesRun[job];
+                if (threadIndex >= numThreads)
+                    validThreadIndices = false;
+            });
+
+            // Every job has finished by the time parallelFor returns
+            REQUIRE(std::all_of(timesRun.cbegin(), timesRun.cend(), [](const auto& n) { return n == 1; }));
+            REQUIRE(validThreadIndices);
+        }
+    }
+}
+
+TEST_CASE("Core::JobSystem. Per-thread data", "[job_system]") {
+    rg::JobSystem jobs{ 4 };
+
+    // Jobs on the same thread don't run at the same time, so plain per-thread totals need no locks
+    std::vector<uint64_t> threadTotals(jobs.getNumThreads(), 0);
+    jobs.parallelFor(10'000, [&](size_t job, size_t threadIndex) { threadTotals[threadIndex] += job; });
+
+    REQUIRE(std::accumulate(threadTotals.cbegin(), threadTotals.cend(), uint64_t{ 0U }) == 9999ULL * 10'000ULL / 2);
+}
+
+TEST_CASE("Core::JobSystem. Idle threads steal jobs", "[job_system]") {
+    rg::JobSystem jobs{ 4 };
+
+    // All the jobs are queued on the calling thread, so any run on another thread were stolen
+    std::vector<int> jobsPerThread(jobs.getNumThreads(), 0);
+    jobs.parallelFor(32, [&](size_t, size_t threadIndex) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        ++jobsPerThread[threadIndex];
+    });
+
+    REQUIRE(std::accumulate(jobsPerThread.cbegin(), jobsPerThread.cend(), 0) == 32);
+    REQUIRE(jobsPerThread[0] < 32);
+}
+
+TEST_CASE("Core::JobSystem. Fork and join", "[job_system]") {
+    rg::JobSystem jobs{ 4 };
+
+    SECTION("Groups") {
+        std::atomic<int> numRun{ 0 };
+        rg::JobSystem::Group group;
+        for (int i{ 0 }; i < 100; ++i)
+            jobs.fork(group, [&numRun](size_t) { ++numRun; });
+
+        jobs.join(group);
+        REQUIRE(numRun == 100);
+
+        // Joining a group with nothing left to do returns straight away
+        jobs.join(group);
+        REQUIRE(numRun == 100);
+    }
+
+    SECTION("Nested") {
+        // Jobs can fork and join jobs of their own, working on other jobs while they wait
+        std::vector<std::atomic<int>> timesRun(16 * 16);
+        jobs.parallelFor(16, [&](size_t outer, size_t) {
+            jobs.parallelFor(16, [&](size_t inner, size_t) { ++timesRun[outer * 16 + inner]; });
+        });
+
+        REQUIRE(std::all_of(timesRun.cbegin(), timesRun.cend(), [](const auto& n) { return n == 1; }));
+    }
+}
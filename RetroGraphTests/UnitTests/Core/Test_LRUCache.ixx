@@ -0,0 +1,56 @@
+export module UnitTests.Test_LRUCache;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+TEST_CASE("Core::LRUCache. Find and Insert", "[lru_cache]") {
+    rg::LRUCache<int, std::string> cache{ 2 };
+    REQUIRE(cache.capacity() == 2);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.find(1) == nullptr);
+
+    cache.insert(1, "one");
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.find(1) != nullptr);
+    REQUIRE(*cache.find(1) == "one");
+
+    SECTION("Hit rate") {
+        // One miss before inserting, then two hits
+        REQUIRE(cache.misses() == 1);
+        REQUIRE(cache.hits() == 2);
+        REQUIRE(cache.hitRate() == Approx{ 2.0 / 3.0 });
+
+        cache.resetStats();
+        REQUIRE(cache.hitRate() == Approx{ 0.0 });
+    }
+
+    SECTION("Clearing") {
+        cache.clear();
+        REQUIRE(cache.size() == 0);
+        REQUIRE(cache.find(1) == nullptr);
+    }
+}
+
+TEST_CASE("Core::LRUCache. Eviction", "[lru_cache]") {
+    rg::LRUCache<int, int> cache{ 2 };
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+
+    SECTION("Least recently inserted entry is evicted") {
+        cache.insert(3, 30);
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache.find(1) == nullptr);
+        REQUIRE(cache.find(2) != nullptr);
+        REQUIRE(cache.find(3) != nullptr);
+    }
+
+    SECTION("Finding an entry makes it most recently used") {
+        REQUIRE(cache.find(1) != nullptr);
+        cache.insert(3, 30);
+        REQUIRE(cache.find(1) != nullptr);
+        REQUIRE(cache.find(2) == nullptr);
+    }
+}
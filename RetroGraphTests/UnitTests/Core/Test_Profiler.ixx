@@ -0,0 +1,88 @@
+export module UnitTests.Test_Profiler;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+namespace {
+
+size_t countOccurrences(std::string_view str, std::string_view substr) {
+    size_t count{ 0 };
+    for (auto pos{ str.find(substr) }; pos != std::string_view::npos; pos = str.find(substr, pos + substr.size()))
+        ++count;
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Core::ProfileEventBuffer. Ring", "[profiler]") {
+    rg::ProfileEventBuffer buffer{ 0, "Main" };
+    std::vector<rg::ProfileEvent> events;
+
+    SECTION("Keeps every event until full") {
+        for (int64_t i{ 0 }; i < 10; ++i)
+            buffer.record({ "zone", i, i + 1 });
+
+        buffer.copyEvents(events);
+        REQUIRE(events.size() == 10);
+        REQUIRE(events.front().startNs == 0);
+        REQUIRE(events.back().startNs == 9);
+    }
+
+    SECTION("Overwrites the oldest events") {
+        constexpr auto numEvents{ static_cast<int64_t>(rg::ProfileEventBuffer::capacity) + 100 };
+        for (int64_t i{ 0 }; i < numEvents; ++i)
+            buffer.record({ "zone", i, i + 1 });
+
+        buffer.copyEvents(events);
+        REQUIRE(buffer.getNumRecorded() == numEvents);
+
+        // The oldest event left is dropped too, as its slot is the next to be written
+        REQUIRE(events.size() == rg::ProfileEventBuffer::capacity - 1);
+        REQUIRE(events.front().startNs == 101);
+        REQUIRE(events.back().startNs == numEvents - 1);
+    }
+}
+
+TEST_CASE("Core::Profiler. Threads", "[profiler]") {
+    rg::Profiler profiler;
+    constexpr int numThreads{ 4 };
+    constexpr int numEventsPerThread{ 1000 };
+
+    std::vector<std::thread> threads;
+    for (int t{ 0 }; t < numThreads; ++t) {
+        threads.emplace_back([&profiler, t]() {
+            profiler.setThreadName(std::format("Worker {}", t));
+            for (int i{ 0 }; i < numEventsPerThread; ++i) {
+                const auto start{ profiler.now() };
+                profiler.record({ "Worker::work", start, profiler.now() });
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto trace{ profiler.getChromeTrace() };
+    REQUIRE(countOccurrences(trace, "\"ph\":\"X\"") == numThreads * numEventsPerThread);
+    REQUIRE(countOccurrences(trace, "\"name\":\"Worker::work\"") == numThreads * numEventsPerThread);
+    REQUIRE(countOccurrences(trace, "\"name\":\"thread_name\"") == numThreads);
+    for (int t{ 0 }; t < numThreads; ++t)
+        REQUIRE(countOccurrences(trace, std::format("\"name\":\"Worker {}\"", t)) == 1);
+}
+
+TEST_CASE("Core::Profiler. Chrome trace", "[profiler]") {
+    rg::Profiler profiler;
+    profiler.setThreadName("Render \"GL\"");
+    profiler.record({ "RetroGraph::draw", 1500, 4000 });
+
+    const auto trace{ profiler.getChromeTrace() };
+    REQUIRE(trace.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    REQUIRE(trace.ends_with("]}\n"));
+
+    // Names are escaped and times are in microseconds
+    REQUIRE(trace.find(R"("args":{"name":"Render \"GL\""})") != std::string::npos);
+    REQUIRE(trace.find(R"({"name":"RetroGraph::draw","ph":"X","pid":1,"tid":0,"ts":1.500,"dur":2.500})") !=
+            std::string::npos);
+}
@@ -0,0 +1,55 @@
+export module UnitTests.Test_Random;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+static_assert(std::uniform_random_bit_generator<rg::Pcg32>);
+
+TEST_CASE("Core::Pcg32. Reference sequence", "[random]") {
+    // From the PCG reference implementation's demo
+    rg::Pcg32 rng{ 42U, 54U };
+    for (const uint32_t expected : { 0xa15c02b7U, 0x7b47f409U, 0xba1d3330U, 0x83d2f293U, 0xbfa4784bU, 0xcbed606eU })
+        REQUIRE(rng() == expected);
+}
+
+TEST_CASE("Core::Pcg32. Seeding", "[random]") {
+    const auto generate = [](rg::Pcg32 rng) {
+        std::vector<uint32_t> values(100);
+        std::generate(values.begin(), values.end(), std::ref(rng));
+        return values;
+    };
+
+    REQUIRE(generate(rg::Pcg32{ 1234U }) == generate(rg::Pcg32{ 1234U }));
+    REQUIRE(generate(rg::Pcg32{ 1234U }) != generate(rg::Pcg32{ 1235U }));
+    REQUIRE(generate(rg::Pcg32{ 1234U, 1U }) != generate(rg::Pcg32{ 1234U, 2U }));
+
+    rg::Pcg32 reseeded{ 1U };
+    reseeded();
+    reseeded.reseed(1234U);
+    REQUIRE(generate(reseeded) == generate(rg::Pcg32{ 1234U }));
+}
+
+TEST_CASE("Core::Pcg32. Floats", "[random]") {
+    rg::Pcg32 rng{ 1234U };
+
+    float min{ 1.0f };
+    float max{ 0.0f };
+    for (int i{ 0 }; i < 100'000; ++i) {
+        const auto value{ rng.nextFloat() };
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    REQUIRE(min >= 0.0f);
+    REQUIRE(min < 0.001f);
+    REQUIRE(max < 1.0f);
+    REQUIRE(max > 0.999f);
+
+    for (int i{ 0 }; i < 1000; ++i) {
+        const auto value{ rng.nextFloat(-2.0f, 3.0f) };
+        REQUIRE(value >= -2.0f);
+        REQUIRE(value < 3.0f);
+    }
+}
@@ -0,0 +1,130 @@
+export module UnitTests.Test_SlidingWindow;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+TEST_CASE("Core::SlidingWindow. Initial State", "[sliding_window]") {
+    rg::SlidingWindow<int> window{ 4, 7 };
+    REQUIRE(window.size() == 4);
+    REQUIRE(window.max() == 7);
+    REQUIRE(window.min() == 7);
+    REQUIRE(window.front() == 7);
+    REQUIRE(window.back() == 7);
+}
+
+TEST_CASE("Core::SlidingWindow. Min Max", "[sliding_window]") {
+    rg::SlidingWindow<int> window{ 3 };
+
+    SECTION("Peak slides out of the window") {
+        window.push(5);
+        REQUIRE(window.max() == 5);
+        window.push(1);
+        window.push(2);
+        REQUIRE(window.max() == 5);
+        window.push(3);
+        REQUIRE(window.max() == 3);
+        REQUIRE(window.min() == 1);
+        window.push(3);
+        REQUIRE(window.min() == 2);
+    }
+
+    SECTION("Ordering from oldest to newest") {
+        window.push(1);
+        window.push(2);
+        window.push(3);
+        window.push(4);
+        REQUIRE(window[0] == 2);
+        REQUIRE(window[1] == 3);
+        REQUIRE(window[2] == 4);
+        REQUIRE(window.front() == 2);
+        REQUIRE(window.back() == 4);
+    }
+
+    SECTION("Single element window") {
+        window.reset(1);
+        window.push(9);
+        REQUIRE(window.max() == 9);
+        window.push(-2);
+        REQUIRE(window.max() == -2);
+        REQUIRE(window.min() == -2);
+    }
+}
+
+TEST_CASE("Core::SlidingWindow. Matches Brute Force", "[sliding_window]") {
+    constexpr size_t windowSize{ 16 };
+    rg::SlidingWindow<int64_t> window{ windowSize };
+    std::deque<int64_t> reference(windowSize, 0);
+
+    std::mt19937 rng{ 1234 };
+    std::uniform_int_distribution<int64_t> dist{ -1000, 1000 };
+    for (int i = 0; i < 1000; ++i) {
+        const auto value{ dist(rng) };
+        window.push(value);
+        reference.pop_front();
+        reference.push_back(value);
+
+        REQUIRE(window.max() == *std::max_element(reference.cbegin(), reference.cend()));
+        REQUIRE(window.min() == *std::min_element(reference.cbegin(), reference.cend()));
+    }
+}
+
+TEST_CASE("Core::SlidingWindow. Auto Scale", "[sliding_window]") {
+    SECTION("Lower bound") {
+        rg::AutoScaleWindow<int64_t> scale{ 4, 100 };
+        REQUIRE(scale.scale() == 100);
+        REQUIRE(!scale.push(50));
+        REQUIRE(scale.scale() == 100);
+    }
+
+    SECTION("No hysteresis tracks the window maximum") {
+        rg::AutoScaleWindow<int64_t> scale{ 2, 100 };
+        REQUIRE(scale.push(400));
+        REQUIRE(scale.scale() == 400);
+        REQUIRE(!scale.push(300));
+        REQUIRE(scale.push(200));
+        REQUIRE(scale.scale() == 300);
+    }
+
+    SECTION("Hysteresis holds the scale until the peak drops far enough") {
+        rg::AutoScaleWindow<int64_t> scale{ 1, 100, 0.5f };
+        REQUIRE(scale.push(1000));
+        REQUIRE(scale.scale() == 1000);
+        REQUIRE(!scale.push(900));
+        REQUIRE(!scale.push(500));
+        REQUIRE(scale.scale() == 1000);
+        REQUIRE(scale.push(499));
+        REQUIRE(scale.scale() == 499);
+        REQUIRE(scale.push(10));
+        REQUIRE(scale.scale() == 100);
+    }
+
+    SECTION("Changing bounds") {
+        rg::AutoScaleWindow<int64_t> scale{ 4, 100 };
+        REQUIRE(scale.setBounds(200, 0.0f));
+        REQUIRE(scale.scale() == 200);
+        REQUIRE(!scale.setBounds(200, 0.5f));
+    }
+}
+
+TEST_CASE("Core::SlidingWindow. Benchmarks", "[sliding_window][!benchmark]") {
+    for (const size_t windowSize : { size_t{ 40U }, size_t{ 3600U }, size_t{ 86400U } }) {
+        std::mt19937 rng{ 1234 };
+        std::uniform_int_distribution<int64_t> dist{ 0, 1024 * 1024 };
+
+        rg::SlidingWindow<int64_t> window{ windowSize };
+        BENCHMARK("SlidingWindow push + max, " + std::to_string(windowSize) + " samples") {
+            window.push(dist(rng));
+            return window.max();
+        };
+
+        std::deque<int64_t> queue(windowSize, 0);
+        BENCHMARK("std::deque push + max_element, " + std::to_string(windowSize) + " samples") {
+            queue.pop_front();
+            queue.push_back(dist(rng));
+            return *std::max_element(queue.cbegin(), queue.cend());
+        };
+    }
+}
@@ -0,0 +1,62 @@
+export module UnitTests.Test_WaitTimer;
+
+import RG.Core;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+namespace {
+
+// Waits for a series of short deadlines, checking none are woken early, and returns how late they woke up
+rg::DurationHistogram measureLateness(rg::IWaitTimer& timer) {
+    rg::DurationHistogram lateness;
+    auto deadline{ steady_clock::now() };
+    for (int i{ 0 }; i < 20; ++i) {
+        deadline += 2ms;
+        REQUIRE(timer.waitUntil(deadline, false));
+
+        const auto now{ steady_clock::now() };
+        REQUIRE(now >= deadline);
+        lateness.record(duration_cast<microseconds>(now - deadline));
+    }
+
+    return lateness;
+}
+
+} // namespace
+
+TEST_CASE("Core::WaitTimer. Never wakes early", "[wait_timer]") {
+    SECTION("Win32 waitable timer") {
+        rg::Win32WaitTimer timer;
+        REQUIRE(timer.isValid());
+        measureLateness(timer);
+    }
+
+    SECTION("Sleep") {
+        rg::SleepWaitTimer timer;
+        measureLateness(timer);
+    }
+
+    SECTION("Deadlines in the past return at once") {
+        const auto timer{ rg::createWaitTimer() };
+        REQUIRE(timer->waitUntil(steady_clock::now() - 1s, true));
+    }
+}
+
+TEST_CASE("Core::WaitTimer. Lateness", "[!benchmark][wait_timer]") {
+    const auto printLateness = [](const char* name, const rg::DurationHistogram& lateness) {
+        printf("%s wake-up lateness: mean %lldus, p50 %lldus, p99 %lldus, max %lldus\n", name,
+               lateness.getMean().count(), lateness.getPercentile(0.5).count(), lateness.getPercentile(0.99).count(),
+               lateness.getMax().count());
+    };
+
+    rg::Win32WaitTimer win32Timer;
+    printLateness(win32Timer.isHighResolution() ? "High resolution waitable timer" : "Waitable timer",
+                  measureLateness(win32Timer));
+
+    rg::SleepWaitTimer sleepTimer;
+    printLateness("sleep_until", measureLateness(sleepTimer));
+}
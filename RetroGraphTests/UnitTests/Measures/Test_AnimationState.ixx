@@ -0,0 +1,94 @@
+export module UnitTests.Test_AnimationState;
+
+import RG.Measures;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+namespace {
+
+rg::AnimationSettings createSettings(uint64_t seed) {
+    rg::AnimationSettings settings;
+    settings.numParticles = 1000;
+    settings.numThreads = 2;
+    settings.seed = seed;
+    return settings;
+}
+
+// Advances in numFrames equal frames adding up to totalTime
+void advance(rg::AnimationState& animation, duration<float> totalTime, int numFrames) {
+    for (int frame{ 0 }; frame < numFrames; ++frame)
+        animation.advance(totalTime / numFrames);
+}
+
+} // namespace
+
+TEST_CASE("Measures::AnimationState. Seeding", "[animation_state]") {
+    const rg::AnimationState animation{ createSettings(1234) };
+    REQUIRE(animation.getParticles().count() == 1000);
+
+    // The same seed gives the same particles, and different seeds different ones
+    REQUIRE(rg::AnimationState{ createSettings(1234) }.getParticles().x == animation.getParticles().x);
+    REQUIRE(rg::AnimationState{ createSettings(1235) }.getParticles().x != animation.getParticles().x);
+
+    // Changing the seed starts the particles again
+    rg::AnimationState reseeded{ createSettings(1) };
+    reseeded.setSettings(createSettings(1234));
+    REQUIRE(reseeded.getParticles().x == animation.getParticles().x);
+    REQUIRE(reseeded.getParticles().dirX == animation.getParticles().dirX);
+}
+
+TEST_CASE("Measures::AnimationState. Fixed timestep", "[animation_state]") {
+    // Just over 60 steps, so frame times that don't divide a step evenly don't matter
+    constexpr duration<float> totalTime{ 1.005f };
+
+    rg::AnimationState slowFrames{ createSettings(1234) };
+    advance(slowFrames, totalTime, 67);
+
+    rg::AnimationState fastFrames{ createSettings(1234) };
+    advance(fastFrames, totalTime, 201);
+
+    // The same steps were taken whatever the frame rate
+    REQUIRE(fastFrames.getParticles().x == slowFrames.getParticles().x);
+    REQUIRE(fastFrames.getParticles().y == slowFrames.getParticles().y);
+
+    // A long pause doesn't take every step it missed
+    rg::AnimationState paused{ createSettings(1234) };
+    paused.advance(duration<float>{ 100.0f });
+    rg::AnimationState maxSteps{ createSettings(1234) };
+    advance(maxSteps, rg::AnimationState::maxTimePerUpdate + rg::AnimationState::fixedTimestep / 2.0f, 1);
+    REQUIRE(paused.getParticles().x == maxSteps.getParticles().x);
+}
+
+TEST_CASE("Measures::AnimationState. Output", "[animation_state]") {
+    rg::AnimationState first{ createSettings(1234) };
+    rg::AnimationState second{ createSettings(1234) };
+    rg::ParticleVectorOutput firstOutput;
+    rg::ParticleVectorOutput secondOutput;
+    first.setOutput(&firstOutput);
+    second.setOutput(&secondOutput);
+
+    // Setting the output writes the particles straight away
+    REQUIRE(firstOutput.getVertices().size() == 1000);
+
+    // Runs with the same seed draw exactly the same, including between steps
+    for (int frame{ 0 }; frame < 10; ++frame) {
+        first.advance(rg::AnimationState::fixedTimestep * 0.7f);
+        second.advance(rg::AnimationState::fixedTimestep * 0.7f);
+
+        REQUIRE(firstOutput.getVertices().size() == 1000);
+        REQUIRE(std::memcmp(firstOutput.getVertices().data(), secondOutput.getVertices().data(),
+                            1000 * sizeof(rg::ParticleVertex)) == 0);
+
+        // Few enough particles that lines are found on one thread, in the same order every time
+        REQUIRE(firstOutput.getLines().size() == secondOutput.getLines().size());
+        REQUIRE(std::memcmp(firstOutput.getLines().data(), secondOutput.getLines().data(),
+                            firstOutput.getLines().size() * sizeof(rg::ParticleLine)) == 0);
+    }
+
+    first.setOutput(nullptr);
+    second.setOutput(nullptr);
+}
@@ -14,11 +14,22 @@ constexpr milliseconds testMeasureUpdateInterval{ 10 };
 
 export class TestDriveDataSource : public rg::IDriveDataSource {
 public:
-    rg::DriveData getDriveData() const override { return m_driveData; }
+    // Picks up the data given to setDriveData(), as a real data source would when reading it again
+    void update() override {
+        if (m_nextDriveData != m_driveData) {
+            m_driveData = m_nextDriveData;
+            ++m_generation;
+        }
+    }
+
+    const rg::DriveData& getDriveData() const override { return m_driveData; }
+    uint64_t getGeneration() const override { return m_generation; }
 
-    void setDriveData(const rg::DriveData& driveData) { m_driveData = driveData; }
+    void setDriveData(const rg::DriveData& driveData) { m_nextDriveData = driveData; }
 
     rg::DriveData m_driveData{};
+    rg::DriveData m_nextDriveData{};
+    uint64_t m_generation{ 0U };
 };
 
 TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
@@ -36,12 +47,14 @@ TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
 
     SECTION("Instant update does not change data") {
         measure.update();
+        REQUIRE(measure.getGeneration() == 0);
         REQUIRE(measure.getNumDrives() == 0);
     }
 
     SECTION("Slow update changes data") {
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
+        REQUIRE(measure.getGeneration() == 1);
         REQUIRE(measure.getNumDrives() == 2);
         REQUIRE(measure.getDrives()[0].driveLetter == 'C');
         REQUIRE(measure.getDrives()[0].totalFreeBytes == 2 * rg::GB);
@@ -60,6 +73,7 @@ TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
 
         SECTION("Update when no change since last update") {
             measure.update();
+            REQUIRE(measure.getGeneration() == 1);
 
             REQUIRE(measure.getNumDrives() == 2);
             REQUIRE(measure.getDrives()[0].driveLetter == 'C');
@@ -76,6 +90,7 @@ TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
             testDriveData.drives[0].totalFreeBytes = 1 * rg::GB;
             driveDataSourceRaw->setDriveData(testDriveData);
             measure.update();
+            REQUIRE(measure.getGeneration() == 2);
 
             REQUIRE(measure.getNumDrives() == 2);
             REQUIRE(measure.getDrives()[0].driveLetter == 'C');
@@ -93,6 +108,7 @@ TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
 
             driveDataSourceRaw->setDriveData(testDriveData);
             measure.update();
+            REQUIRE(measure.getGeneration() == 2);
 
             REQUIRE(measure.getNumDrives() == 3);
             REQUIRE(measure.getDrives()[0].driveLetter == 'C');
@@ -113,6 +129,7 @@ TEST_CASE("Measures::DriveMeasure. Update", "[measure]") {
             testDriveData.drives.pop_back();
             driveDataSourceRaw->setDriveData(testDriveData);
             measure.update();
+            REQUIRE(measure.getGeneration() == 2);
 
             REQUIRE(measure.getNumDrives() == 1);
             REQUIRE(measure.getDrives()[0].driveLetter == 'C');
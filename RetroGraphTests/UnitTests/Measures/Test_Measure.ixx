@@ -1,6 +1,10 @@
 export module UnitTests.Test_Measure;
 
+import RG.Core;
 import RG.Measures;
+import RG.Measures.DataSources;
+
+import std.core;
 
 import "Catch2HeaderUnit.h";
 
@@ -26,6 +30,43 @@ protected:
     bool updateInternal() override { return false; }
 };
 
+// Reports the given values in turn as the samples its interval adapts to
+class AdaptiveTestMeasure : public rg::Measure {
+public:
+    AdaptiveTestMeasure(std::vector<float> values)
+        : Measure{ testMeasureUpdateInterval }
+        , m_values{ std::move(values) } {}
+
+protected:
+    bool updateInternal() override {
+        addAdaptiveSample(m_values[m_nextValue++ % m_values.size()]);
+        return true;
+    }
+
+private:
+    std::vector<float> m_values;
+    size_t m_nextValue{ 0U };
+};
+
+// Counts how often it's asked to read the time
+class CountingTimeDataSource : public rg::ITimeDataSource {
+public:
+    void update() override {
+        ++numUpdates;
+        m_timeData.uptime = seconds{ numUpdates };
+        ++m_generation;
+    }
+
+    const rg::TimeData& getTimeData() const override { return m_timeData; }
+    uint64_t getGeneration() const override { return m_generation; }
+
+    int numUpdates{ 0 };
+
+private:
+    rg::TimeData m_timeData{};
+    uint64_t m_generation{ 0U };
+};
+
 TEST_CASE("Measures::Measure. Update", "[measure]") {
     TestMeasure measure;
     bool updateEventTriggered{ false };
@@ -45,20 +86,24 @@ TEST_CASE("Measures::Measure. Update", "[measure]") {
     SECTION("Multiple update calls") {
         measure.update();
         REQUIRE(!updateEventTriggered);
+        REQUIRE(measure.getGeneration() == 0);
 
         updateEventTriggered = false;
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
         REQUIRE(updateEventTriggered);
+        REQUIRE(measure.getGeneration() == 1);
 
         updateEventTriggered = false;
         measure.update();
         REQUIRE(!updateEventTriggered);
+        REQUIRE(measure.getGeneration() == 1);
 
         updateEventTriggered = false;
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
         REQUIRE(updateEventTriggered);
+        REQUIRE(measure.getGeneration() == 2);
     }
 
     measure.postUpdate.detach(handle);
@@ -78,7 +123,101 @@ TEST_CASE("Measures::Measure. Static Measure Update", "[measure]") {
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
         REQUIRE(!updateEventTriggered);
+        REQUIRE(measure.getGeneration() == 0);
     }
 
     measure.postUpdate.detach(handle);
 }
+
+TEST_CASE("Measures::Measure. Suspension", "[measure]") {
+    auto dataSource{ std::make_unique<CountingTimeDataSource>() };
+    auto* dataSourceRaw{ dataSource.get() };
+    rg::TimeMeasure measure{ testMeasureUpdateInterval, std::move(dataSource) };
+    REQUIRE(dataSourceRaw->numUpdates == 1);
+
+    measure.setSuspended(true);
+    REQUIRE(measure.isSuspended());
+    REQUIRE(!measure.getNextUpdateTime());
+
+    SECTION("Suspended measure doesn't sample") {
+        for (int i{ 0 }; i < 5; ++i) {
+            std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
+            measure.update();
+        }
+
+        REQUIRE(dataSourceRaw->numUpdates == 1);
+        REQUIRE(measure.getGeneration() == 0);
+    }
+
+    SECTION("Resumed measure samples straight away") {
+        measure.update();
+        measure.setSuspended(false);
+        REQUIRE(!measure.isSuspended());
+        REQUIRE(*measure.getNextUpdateTime() <= steady_clock::now());
+
+        // Not due by its interval yet, but catches up on what it missed
+        measure.update();
+        REQUIRE(dataSourceRaw->numUpdates == 2);
+        REQUIRE(measure.getUptime() == 2s);
+        REQUIRE(measure.getGeneration() == 1);
+
+        // Then carries on at its usual rate
+        measure.update();
+        REQUIRE(dataSourceRaw->numUpdates == 2);
+
+        std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
+        measure.update();
+        REQUIRE(dataSourceRaw->numUpdates == 3);
+    }
+}
+
+TEST_CASE("Measures::Measure. Adaptive Interval", "[measure]") {
+    AdaptiveTestMeasure measure{ { 0.5f, 0.5f, 0.5f, 0.9f } };
+    measure.setAdaptiveInterval(rg::AdaptiveIntervalSettings{ .minInterval = testMeasureUpdateInterval,
+                                                              .maxInterval = testMeasureUpdateInterval * 4,
+                                                              .changeThreshold = 0.05f,
+                                                              .stableSamplesToWiden = 1 });
+    REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval);
+
+    const auto sampleWhenDue{ [&measure]() {
+        std::this_thread::sleep_for(*measure.getUpdateInterval());
+        const auto generation{ measure.getGeneration() };
+        measure.update();
+        REQUIRE(measure.getGeneration() == generation + 1);
+    } };
+
+    // Widens while the value is stable, and each sample spans the interval it was taken after
+    sampleWhenDue();
+    REQUIRE(measure.getSampleSpan() == 1);
+    REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval);
+
+    sampleWhenDue();
+    REQUIRE(measure.getSampleSpan() == 1);
+    REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval * 2);
+
+    sampleWhenDue();
+    REQUIRE(measure.getSampleSpan() == 2);
+    REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval * 4);
+
+    // Not due until the widened interval has passed
+    std::this_thread::sleep_for(testMeasureUpdateInterval);
+    measure.update();
+    REQUIRE(measure.getGeneration() == 3);
+
+    // Tightens on a change
+    sampleWhenDue();
+    REQUIRE(measure.getSampleSpan() == 4);
+    REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval);
+
+    sampleWhenDue();
+    REQUIRE(measure.getSampleSpan() == 1);
+
+    SECTION("Turning adaptation off goes back to the fixed interval") {
+        sampleWhenDue();
+        REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval * 2);
+
+        measure.setAdaptiveInterval(std::nullopt);
+        REQUIRE(measure.getUpdateInterval() == testMeasureUpdateInterval);
+        REQUIRE(measure.getSampleSpan() == 1);
+    }
+}
@@ -13,11 +13,22 @@ constexpr milliseconds testMeasureUpdateInterval{ 10 };
 
 export class TestMusicDataSource : public rg::IMusicDataSource {
 public:
-    rg::MusicData getMusicData() const override { return m_musicData; }
+    // Picks up the data given to setMusicData(), as a real data source would when reading it again
+    void update() override {
+        if (m_nextMusicData != m_musicData) {
+            m_musicData = m_nextMusicData;
+            ++m_generation;
+        }
+    }
+
+    const rg::MusicData& getMusicData() const override { return m_musicData; }
+    uint64_t getGeneration() const override { return m_generation; }
 
-    void setMusicData(const rg::MusicData& musicData) { m_musicData = musicData; }
+    void setMusicData(const rg::MusicData& musicData) { m_nextMusicData = musicData; }
 
     rg::MusicData m_musicData{};
+    rg::MusicData m_nextMusicData{};
+    uint64_t m_generation{ 0U };
 };
 
 TEST_CASE("Measures::MusicMeasure. Update", "[measure]") {
@@ -41,6 +52,7 @@ TEST_CASE("Measures::MusicMeasure. Update", "[measure]") {
 
     SECTION("Instant update does not change data") {
         measure.update();
+        REQUIRE(measure.getGeneration() == 0);
         REQUIRE(measure.isMusicPlaying() == defaultMusicData.isMusicPlaying);
         REQUIRE(measure.getTrackName() == defaultMusicData.trackName);
         REQUIRE(measure.getArtist() == defaultMusicData.artist);
@@ -52,6 +64,7 @@ TEST_CASE("Measures::MusicMeasure. Update", "[measure]") {
     SECTION("Slow update changes data") {
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
+        REQUIRE(measure.getGeneration() == 1);
         REQUIRE(measure.isMusicPlaying() == true);
         REQUIRE(measure.getTrackName() == "My favorite song");
         REQUIRE(measure.getArtist() == "My favorite artist");
@@ -67,6 +80,7 @@ TEST_CASE("Measures::MusicMeasure. Update", "[measure]") {
         SECTION("Update when no change since last update") {
             std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
             measure.update();
+            REQUIRE(measure.getGeneration() == 1);
             REQUIRE(measure.isMusicPlaying() == true);
             REQUIRE(measure.getTrackName() == "My favorite song");
             REQUIRE(measure.getArtist() == "My favorite artist");
@@ -82,6 +96,7 @@ TEST_CASE("Measures::MusicMeasure. Update", "[measure]") {
             testMusicData.artist = "my least favorite artist";
             musicDataSourceRaw->setMusicData(testMusicData);
             measure.update();
+            REQUIRE(measure.getGeneration() == 2);
             REQUIRE(measure.getElapsedTime() == seconds{ initialElapsedTime + 1s });
             REQUIRE(measure.getArtist() == "my least favorite artist");
         }
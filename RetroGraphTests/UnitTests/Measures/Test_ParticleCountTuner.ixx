@@ -0,0 +1,81 @@
+export module UnitTests.Test_ParticleCountTuner;
+
+import RG.Measures;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr microseconds budget{ 2000 };
+
+// Simulated update cost: linear movement plus the close pairs, which grow with the square of the count
+microseconds simulatedUpdateTime(size_t count, double slowdown) {
+    const auto n{ static_cast<double>(count) };
+    return microseconds{ static_cast<int64_t>(slowdown * (0.05 * n + 0.00002 * n * n)) };
+}
+
+// The largest count whose simulated update fits in the budget
+size_t largestFittingCount(double slowdown) {
+    size_t count{ 1 };
+    while (simulatedUpdateTime(count + 1, slowdown) <= budget)
+        ++count;
+    return count;
+}
+
+void runTuner(rg::ParticleCountTuner& tuner, double slowdown, int numUpdates) {
+    for (int i{ 0 }; i < numUpdates; ++i)
+        tuner.addUpdateTime(simulatedUpdateTime(tuner.getCount(), slowdown));
+}
+
+} // namespace
+
+TEST_CASE("Measures::ParticleCountTuner. Finds the largest count in budget", "[particle_count_tuner]") {
+    const auto expected{ largestFittingCount(1.0) };
+
+    rg::ParticleCountTuner tuner{ budget, 100, 10, 100'000 };
+    runTuner(tuner, 1.0, 100 * rg::ParticleCountTuner::updatesPerDecision);
+
+    REQUIRE(tuner.isSettled());
+    REQUIRE(tuner.getCount() <= expected);
+    REQUIRE(tuner.getCount() >= static_cast<size_t>(expected * 0.9));
+}
+
+TEST_CASE("Measures::ParticleCountTuner. Stays within limits", "[particle_count_tuner]") {
+    SECTION("Maximum") {
+        rg::ParticleCountTuner tuner{ budget, 100, 10, 1000 };
+        runTuner(tuner, 1.0, 100 * rg::ParticleCountTuner::updatesPerDecision);
+        REQUIRE(tuner.isSettled());
+        REQUIRE(tuner.getCount() == 1000);
+    }
+
+    SECTION("Minimum") {
+        rg::ParticleCountTuner tuner{ budget, 100, 10, 1000 };
+        runTuner(tuner, 10000.0, 100 * rg::ParticleCountTuner::updatesPerDecision);
+        REQUIRE(tuner.isSettled());
+        REQUIRE(tuner.getCount() == 10);
+    }
+}
+
+TEST_CASE("Measures::ParticleCountTuner. Adapts to changing update times", "[particle_count_tuner]") {
+    rg::ParticleCountTuner tuner{ budget, 100, 10, 100'000 };
+    runTuner(tuner, 1.0, 100 * rg::ParticleCountTuner::updatesPerDecision);
+    const auto initialCount{ tuner.getCount() };
+
+    // Updates get slower, so fewer particles fit
+    runTuner(tuner, 2.0, 100 * rg::ParticleCountTuner::updatesPerDecision);
+    REQUIRE(tuner.isSettled());
+    REQUIRE(tuner.getCount() < initialCount);
+    REQUIRE(tuner.getCount() <= largestFittingCount(2.0));
+    REQUIRE(tuner.getCount() >= static_cast<size_t>(largestFittingCount(2.0) * 0.9));
+
+    // Updates get much faster, so more particles fit
+    runTuner(tuner, 0.25, 100 * rg::ParticleCountTuner::updatesPerDecision);
+    REQUIRE(tuner.isSettled());
+    REQUIRE(tuner.getCount() > initialCount);
+    REQUIRE(tuner.getCount() <= largestFittingCount(0.25));
+    REQUIRE(tuner.getCount() >= static_cast<size_t>(largestFittingCount(0.25) * 0.9));
+}
@@ -0,0 +1,226 @@
+export module UnitTests.Test_ParticleGrid;
+
+import RG.Core;
+import RG.Measures;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+namespace {
+
+rg::Particles createParticles(size_t count) {
+    std::mt19937 rng{ 1234 };
+    std::uniform_real_distribution<float> pos{ rg::particleMinPos, rg::particleMaxPos };
+
+    rg::Particles particles;
+    for (size_t i{ 0 }; i < count; ++i) {
+        particles.x.push_back(pos(rng));
+        particles.y.push_back(pos(rng));
+        particles.dirX.push_back(pos(rng));
+        particles.dirY.push_back(pos(rng));
+        particles.speed.push_back(rg::particleMinSpeed);
+        particles.size.push_back(rg::particleMinSize);
+        particles.prevX.push_back(particles.x.back());
+        particles.prevY.push_back(particles.y.back());
+    }
+    return particles;
+}
+
+size_t countClosePairsBruteForce(const rg::Particles& particles, float connectionDistance) {
+    const auto radiusSq{ connectionDistance * connectionDistance };
+
+    size_t numPairs{ 0 };
+    for (size_t i{ 0 }; i < particles.count(); ++i) {
+        for (size_t j{ i + 1 }; j < particles.count(); ++j) {
+            const auto dx{ particles.x[i] - particles.x[j] };
+            const auto dy{ particles.y[i] - particles.y[j] };
+            if (dx * dx + dy * dy < radiusSq)
+                ++numPairs;
+        }
+    }
+    return numPairs;
+}
+
+} // namespace
+
+TEST_CASE("Measures::ParticleGrid. Cells", "[particle_grid]") {
+    const auto particles{ createParticles(1000) };
+    rg::ParticleGrid grid;
+    grid.build(particles);
+
+    // Every particle is in exactly one cell, and it's the cell its position is in
+    std::vector<int> timesSeen(particles.count(), 0);
+    for (int cellX{ 0 }; cellX < grid.getCellsPerSide(); ++cellX) {
+        for (int cellY{ 0 }; cellY < grid.getCellsPerSide(); ++cellY) {
+            for (const auto i : grid.getCellParticles(cellX, cellY)) {
+                REQUIRE(grid.getCell(particles.x[i]) == cellX);
+                REQUIRE(grid.getCell(particles.y[i]) == cellY);
+                ++timesSeen[i];
+            }
+        }
+    }
+    REQUIRE(std::ranges::all_of(timesSeen, [](int n) { return n == 1; }));
+
+    SECTION("Rebuilding with fewer particles") {
+        grid.build(createParticles(10));
+
+        size_t numInCells{ 0 };
+        for (int cellX{ 0 }; cellX < grid.getCellsPerSide(); ++cellX) {
+            for (int cellY{ 0 }; cellY < grid.getCellsPerSide(); ++cellY)
+                numInCells += grid.getCellParticles(cellX, cellY).size();
+        }
+        REQUIRE(numInCells == 10);
+    }
+}
+
+TEST_CASE("Measures::ParticleGrid. Configuration", "[particle_grid]") {
+    const rg::ParticleGrid grid;
+    REQUIRE(grid.getConnectionDistance() == rg::ParticleGrid::defaultConnectionDistance);
+    REQUIRE(grid.getCellsPerSide() == rg::ParticleGrid::defaultCellsPerSide);
+    REQUIRE(grid.getCell(-1.0f) == 0);
+    REQUIRE(grid.getCell(0.0f) == 5);
+    REQUIRE(grid.getCell(1.0f) == 9);
+
+    // Cells can't be smaller than the connection distance
+    REQUIRE(rg::ParticleGrid{ 0.2f, 50 }.getCellsPerSide() == 10);
+    REQUIRE(rg::ParticleGrid{ 0.5f, 10 }.getCellsPerSide() == 4);
+    REQUIRE(rg::ParticleGrid{ 0.05f, 20 }.getCellsPerSide() == 20);
+
+    // At least 3 cells per side
+    REQUIRE(rg::ParticleGrid{ 0.2f, 1 }.getCellsPerSide() == 3);
+    REQUIRE(rg::ParticleGrid{ 5.0f, 10 }.getConnectionDistance() == rg::ParticleGrid::maxConnectionDistance);
+    REQUIRE(rg::ParticleGrid{ 5.0f, 10 }.getCellsPerSide() == 3);
+}
+
+TEST_CASE("Measures::ParticleGrid. Close pairs", "[particle_grid]") {
+    for (const auto& [connectionDistance, cellsPerSide] : { std::pair{ 0.2f, 10 }, std::pair{ 0.2f, 4 },
+                                                           std::pair{ 0.05f, 40 }, std::pair{ 0.6f, 3 } }) {
+        for (const size_t numParticles : { size_t{ 0U }, size_t{ 1U }, size_t{ 100U }, size_t{ 1000U } }) {
+            const auto particles{ createParticles(numParticles) };
+            rg::ParticleGrid grid{ connectionDistance, cellsPerSide };
+            grid.build(particles);
+
+            size_t numPairs{ 0 };
+            grid.forEachClosePair([&](float x1, float y1, float x2, float y2) {
+                const auto dx{ x1 - x2 };
+                const auto dy{ y1 - y2 };
+                REQUIRE(dx * dx + dy * dy < connectionDistance * connectionDistance);
+                ++numPairs;
+            });
+
+            // The grid finds the same pairs as testing every pair
+            REQUIRE(numPairs == countClosePairsBruteForce(particles, connectionDistance));
+        }
+    }
+}
+
+TEST_CASE("Measures::ParticleGrid. Parallel close pairs", "[particle_grid]") {
+    for (const size_t numThreads : { size_t{ 1U }, size_t{ 4U } }) {
+        rg::JobSystem jobs{ numThreads };
+
+        // Below and above the count where the search is split into strips
+        for (const size_t numParticles : { size_t{ 100U }, size_t{ 20'000U } }) {
+            const auto particles{ createParticles(numParticles) };
+            rg::ParticleGrid grid;
+            grid.build(particles);
+
+            std::vector<std::tuple<float, float, float, float>> expected;
+            grid.forEachClosePair([&expected](float x1, float y1, float x2, float y2) {
+                expected.emplace_back(x1, y1, x2, y2);
+            });
+
+            // Less room than needed is asked for at first, and lines from a previous search are replaced
+            rg::ParticleVectorOutput output;
+            output.beginLines(5);
+            output.endLines(5);
+            REQUIRE(grid.findClosePairs(jobs, output, expected.size() / 2) == expected.size());
+
+            // Lines are in whatever order the threads found them
+            std::vector<std::tuple<float, float, float, float>> found;
+            for (const auto& line : output.getLines())
+                found.emplace_back(line.v1.x, line.v1.y, line.v2.x, line.v2.y);
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(found.begin(), found.end());
+            REQUIRE(found == expected);
+        }
+    }
+}
+
+TEST_CASE("Measures::ParticleGrid. Benchmarks", "[particle_grid][!benchmark]") {
+    for (const size_t numParticles : { size_t{ 1000U }, size_t{ 20'000U } }) {
+        const auto particles{ createParticles(numParticles) };
+        rg::ParticleGrid grid;
+        std::vector<rg::ParticleLine> lines;
+
+        BENCHMARK("Particle line generation, " + std::to_string(numParticles) + " particles") {
+            grid.build(particles);
+
+            lines.clear();
+            grid.forEachClosePair([&lines](float x1, float y1, float x2, float y2) {
+                lines.emplace_back(x1, y1, x2, y2);
+            });
+            return lines.size();
+        };
+    }
+}
+
+TEST_CASE("Measures::ParticleGrid. Line output benchmarks", "[particle_grid][!benchmark]") {
+    // Around 390,000 lines, or 9.4MB per update
+    constexpr size_t numParticles{ 5'000U };
+    const auto particles{ createParticles(numParticles) };
+    rg::ParticleGrid grid;
+    grid.build(particles);
+
+    rg::JobSystem jobs{ 1 };
+    rg::ParticleVectorOutput output;
+    std::vector<rg::ParticleLine> lines;
+
+    BENCHMARK("Lines copied to the output, " + std::to_string(numParticles) + " particles") {
+        lines.clear();
+        grid.forEachClosePair([&lines](float x1, float y1, float x2, float y2) {
+            lines.emplace_back(x1, y1, x2, y2);
+        });
+
+        const auto outputLines{ output.beginLines(lines.size()) };
+        std::memcpy(outputLines.data(), lines.data(), lines.size() * sizeof(rg::ParticleLine));
+        output.endLines(lines.size());
+        return lines.size();
+    };
+
+    BENCHMARK("Lines written to the output, " + std::to_string(numParticles) + " particles") {
+        return grid.findClosePairs(jobs, output, output.getLines().size());
+    };
+}
+
+TEST_CASE("Measures::ParticleGrid. Parallel update scaling", "[particle_grid][!benchmark]") {
+    // A shorter connection distance than the default keeps the number of lines reasonable for this many particles
+    constexpr size_t numParticles{ 50'000U };
+    constexpr float connectionDistance{ 0.02f };
+    const auto simd{ rg::getSupportedSimdLevel() };
+
+    // Powers of two up to one thread per core
+    const auto maxThreads{ rg::JobSystem::getDefaultNumThreads() };
+    std::vector<size_t> threadCounts;
+    for (size_t numThreads{ 1U }; numThreads < maxThreads; numThreads *= 2)
+        threadCounts.push_back(numThreads);
+    threadCounts.push_back(maxThreads);
+
+    for (const auto numThreads : threadCounts) {
+        rg::JobSystem jobs{ numThreads };
+        auto particles{ createParticles(numParticles) };
+        rg::ParticleGrid grid{ connectionDistance, static_cast<int>(2.0f / connectionDistance) };
+        rg::ParticlePositions positions;
+        rg::ParticleVectorOutput output;
+
+        BENCHMARK("Particle and line update, " + std::to_string(numParticles) + " particles, " +
+                  std::to_string(numThreads) + " threads") {
+            particles.update(0.016f, simd, jobs);
+            particles.interpolate(0.5f, positions, jobs, output.beginParticles(particles.count()));
+            output.endParticles();
+            grid.build(positions.x, positions.y);
+            return grid.findClosePairs(jobs, output, output.getLines().size());
+        };
+    }
+}
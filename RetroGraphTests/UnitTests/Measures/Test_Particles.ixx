@@ -0,0 +1,202 @@
+export module UnitTests.Test_Particles;
+
+import RG.Core;
+import RG.Measures;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+namespace {
+
+rg::Particles createParticles(size_t count, float maxSpeed) {
+    std::mt19937 rng{ 1234 };
+    std::uniform_real_distribution<float> pos{ rg::particleMinPos, rg::particleMaxPos };
+    std::uniform_real_distribution<float> speed{ rg::particleMinSpeed, maxSpeed };
+
+    rg::Particles particles;
+    for (size_t i{ 0 }; i < count; ++i) {
+        particles.x.push_back(pos(rng));
+        particles.y.push_back(pos(rng));
+        particles.dirX.push_back(pos(rng));
+        particles.dirY.push_back(pos(rng));
+        particles.speed.push_back(speed(rng));
+        particles.size.push_back(rg::particleMinSize);
+        particles.prevX.push_back(particles.x.back());
+        particles.prevY.push_back(particles.y.back());
+    }
+    return particles;
+}
+
+std::vector<rg::SimdLevel> getSupportedSimdLevels() {
+    std::vector<rg::SimdLevel> levels{ rg::SimdLevel::Scalar, rg::SimdLevel::SSE2 };
+    if (rg::getSupportedSimdLevel() == rg::SimdLevel::AVX2)
+        levels.push_back(rg::SimdLevel::AVX2);
+    return levels;
+}
+
+} // namespace
+
+TEST_CASE("Measures::Particles. Wrapping", "[particles]") {
+    rg::Particles particles;
+    const auto addParticle = [&particles](float x, float y, float dirX, float dirY) {
+        particles.x.push_back(x);
+        particles.y.push_back(y);
+        particles.dirX.push_back(dirX);
+        particles.dirY.push_back(dirY);
+        particles.speed.push_back(1.0f);
+        particles.size.push_back(rg::particleMinSize);
+        particles.prevX.push_back(particles.x.back());
+        particles.prevY.push_back(particles.y.back());
+    };
+
+    addParticle(-0.99f, 0.5f, -1.0f, 0.0f); // Leaves through the left
+    addParticle(0.5f, 0.99f, 0.0f, 1.0f);   // Leaves through the top
+    addParticle(0.99f, -0.99f, 1.0f, -1.0f); // Leaves through the bottom right corner
+    addParticle(0.0f, 0.0f, 1.0f, 1.0f);    // Stays inside
+
+    for (const auto simd : getSupportedSimdLevels()) {
+        auto updated{ particles };
+        updated.update(0.1f, simd);
+
+        REQUIRE(updated.x[0] == rg::particleMaxPos);
+        REQUIRE(updated.y[0] == -0.5f);
+
+        REQUIRE(updated.x[1] == -0.5f);
+        REQUIRE(updated.y[1] == rg::particleMinPos);
+
+        // Corners only wrap in x
+        REQUIRE(updated.x[2] == rg::particleMinPos);
+        REQUIRE(updated.y[2] == rg::particleMaxPos);
+
+        REQUIRE(updated.x[3] == 0.1f);
+        REQUIRE(updated.y[3] == 0.1f);
+    }
+}
+
+TEST_CASE("Measures::Particles. SIMD matches scalar", "[particles]") {
+    // Not a multiple of 8, so the leftover particles are covered too. Fast particles wrap many times
+    constexpr size_t numParticles{ 1003 };
+    const auto initial{ createParticles(numParticles, 2.0f) };
+
+    auto scalar{ initial };
+    for (int step{ 0 }; step < 1000; ++step)
+        scalar.update(0.016f, rg::SimdLevel::Scalar);
+
+    for (const auto simd : getSupportedSimdLevels()) {
+        auto particles{ initial };
+        for (int step{ 0 }; step < 1000; ++step)
+            particles.update(0.016f, simd);
+
+        REQUIRE(particles.x == scalar.x);
+        REQUIRE(particles.y == scalar.y);
+    }
+}
+
+TEST_CASE("Measures::Particles. Parallel update matches serial", "[particles]") {
+    rg::JobSystem jobs{ 4 };
+
+    // Enough particles to be split into several jobs, and not a multiple of 8
+    for (const size_t numParticles : { size_t{ 100U }, size_t{ 50'003U } }) {
+        const auto initial{ createParticles(numParticles, 2.0f) };
+
+        for (const auto simd : getSupportedSimdLevels()) {
+            auto serial{ initial };
+            auto parallel{ initial };
+            for (int step{ 0 }; step < 10; ++step) {
+                serial.update(0.016f, simd);
+                parallel.update(0.016f, simd, jobs);
+            }
+
+            REQUIRE(parallel.x == serial.x);
+            REQUIRE(parallel.y == serial.y);
+        }
+    }
+}
+
+TEST_CASE("Measures::Particles. Random particles", "[particles]") {
+    rg::Pcg32 rng{ 1234U };
+    rg::Particles particles;
+    particles.addRandom(1000, rng);
+    REQUIRE(particles.count() == 1000);
+    REQUIRE(particles.prevX == particles.x);
+
+    for (size_t i{ 0 }; i < particles.count(); ++i) {
+        REQUIRE(particles.x[i] >= rg::particleMinPos);
+        REQUIRE(particles.x[i] < rg::particleMaxPos);
+        REQUIRE(particles.speed[i] >= rg::particleMinSpeed);
+        REQUIRE(particles.speed[i] < rg::particleMaxSpeed);
+        REQUIRE(particles.size[i] >= rg::particleMinSize);
+        REQUIRE(particles.size[i] < rg::particleMaxSize);
+    }
+
+    // The same seed gives the same particles
+    rg::Pcg32 sameRng{ 1234U };
+    rg::Particles same;
+    same.resize(1000, sameRng);
+    REQUIRE(same.x == particles.x);
+    REQUIRE(same.dirY == particles.dirY);
+
+    same.resize(10, sameRng);
+    REQUIRE(same.count() == 10);
+    REQUIRE(same.prevY.size() == 10);
+}
+
+TEST_CASE("Measures::Particles. Interpolation", "[particles]") {
+    rg::JobSystem jobs{ 4 };
+
+    for (const size_t numParticles : { size_t{ 100U }, size_t{ 50'003U } }) {
+        const auto initial{ createParticles(numParticles, 2.0f) };
+        auto particles{ initial };
+        particles.update(0.1f, rg::getSupportedSimdLevel(), jobs);
+        REQUIRE(particles.prevX == initial.x);
+        REQUIRE(particles.prevY == initial.y);
+
+        rg::ParticlePositions positions;
+        std::vector<rg::ParticleVertex> vertices(numParticles);
+        particles.interpolate(0.25f, positions, jobs, vertices);
+
+        size_t numWrapped{ 0 };
+        for (size_t i{ 0 }; i < numParticles; ++i) {
+            if (std::abs(particles.x[i] - initial.x[i]) > 1.0f || std::abs(particles.y[i] - initial.y[i]) > 1.0f) {
+                // Wrapped around, so drawn where it is now rather than crossing the world
+                REQUIRE(positions.x[i] == particles.x[i]);
+                REQUIRE(positions.y[i] == particles.y[i]);
+                ++numWrapped;
+            } else {
+                REQUIRE(positions.x[i] == Approx(initial.x[i] + (particles.x[i] - initial.x[i]) * 0.25f));
+                REQUIRE(positions.y[i] == Approx(initial.y[i] + (particles.y[i] - initial.y[i]) * 0.25f));
+            }
+
+            REQUIRE(vertices[i].position.x == positions.x[i]);
+            REQUIRE(vertices[i].position.y == positions.y[i]);
+            REQUIRE(vertices[i].scale == particles.size[i]);
+        }
+        REQUIRE(numWrapped > 0);
+
+        // The ends are exactly the last two positions
+        particles.interpolate(1.0f, positions, jobs);
+        REQUIRE(positions.x == particles.x);
+        particles.interpolate(0.0f, positions, jobs);
+        for (size_t i{ 0 }; i < numParticles; ++i) {
+            if (std::abs(particles.x[i] - initial.x[i]) <= 1.0f && std::abs(particles.y[i] - initial.y[i]) <= 1.0f)
+                REQUIRE(positions.x[i] == initial.x[i]);
+        }
+    }
+}
+
+TEST_CASE("Measures::Particles. Benchmarks", "[particles][!benchmark]") {
+    constexpr std::array simdNames{ "scalar", "SSE2", "AVX2" };
+
+    for (const size_t numParticles : { size_t{ 100U }, size_t{ 10'000U }, size_t{ 100'000U } }) {
+        auto particles{ createParticles(numParticles, rg::particleMaxSpeed) };
+
+        for (const auto simd : getSupportedSimdLevels()) {
+            BENCHMARK("Particle update, " + std::to_string(numParticles) + " particles, " +
+                      simdNames[static_cast<size_t>(simd)]) {
+                particles.update(0.016f, simd);
+                return particles.x[0];
+            };
+        }
+    }
+}
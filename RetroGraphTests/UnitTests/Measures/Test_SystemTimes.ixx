@@ -0,0 +1,61 @@
+export module UnitTests.Test_SystemTimes;
+
+import RG.Measures.DataSources;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+TEST_CASE("Measures::SystemTimes. Usage", "[measure]") {
+    const rg::CPUTimes previous{ .idle = 100U, .kernel = 300U, .user = 100U };
+
+    // Kernel time includes the idle time, so 50 of the 200 ticks were idle
+    REQUIRE(rg::getUsage(previous, { .idle = 150U, .kernel = 400U, .user = 200U }) == 0.75f);
+    REQUIRE(rg::getUsage(previous, { .idle = 300U, .kernel = 500U, .user = 100U }) == 0.0f);
+    REQUIRE(rg::getUsage(previous, { .idle = 100U, .kernel = 400U, .user = 200U }) == 1.0f);
+
+    // No time passed
+    REQUIRE(rg::getUsage(previous, previous) == 0.0f);
+}
+
+TEST_CASE("Measures::SystemTimes. Captured once per tick", "[measure]") {
+    int numCalls{ 0 };
+    rg::SystemTimes systemTimes{ [&](rg::SystemTimesSnapshot& snapshot) {
+        ++numCalls;
+        snapshot.total.kernel += 100U;
+        snapshot.cores.assign(4, snapshot.total);
+    } };
+
+    // Nothing is read until something asks
+    REQUIRE(numCalls == 0);
+
+    const auto& first{ systemTimes.get() };
+    REQUIRE(numCalls == 1);
+    REQUIRE(first.total.kernel == 100U);
+    REQUIRE(first.cores.size() == 4);
+
+    SECTION("Readers in the same tick share the snapshot") {
+        for (int i{ 0 }; i < 1000; ++i)
+            REQUIRE(&systemTimes.get() == &first);
+
+        REQUIRE(numCalls == 1);
+        REQUIRE(systemTimes.get().total.kernel == 100U);
+    }
+
+    SECTION("Each tick reads again") {
+        systemTimes.nextTick();
+        REQUIRE(systemTimes.get().total.kernel == 200U);
+        REQUIRE(systemTimes.get().total.kernel == 200U);
+        REQUIRE(numCalls == 2);
+        REQUIRE(systemTimes.getNumCaptures() == 2);
+    }
+
+    SECTION("Ticks without readers don't read") {
+        for (int i{ 0 }; i < 10; ++i)
+            systemTimes.nextTick();
+
+        REQUIRE(numCalls == 1);
+        REQUIRE(systemTimes.get().total.kernel == 200U);
+        REQUIRE(numCalls == 2);
+    }
+}
@@ -13,11 +13,22 @@ constexpr milliseconds testMeasureUpdateInterval{ 10 };
 
 export class TestTimeDataSource : public rg::ITimeDataSource {
 public:
-    rg::TimeData getTimeData() const override { return m_timeData; }
+    // Picks up the data given to setTimeData(), as a real data source would when reading it again
+    void update() override {
+        if (m_nextTimeData != m_timeData) {
+            m_timeData = m_nextTimeData;
+            ++m_generation;
+        }
+    }
+
+    const rg::TimeData& getTimeData() const override { return m_timeData; }
+    uint64_t getGeneration() const override { return m_generation; }
 
-    void setTimeData(const rg::TimeData& timeData) { m_timeData = timeData; }
+    void setTimeData(const rg::TimeData& timeData) { m_nextTimeData = timeData; }
 
     rg::TimeData m_timeData{};
+    rg::TimeData m_nextTimeData{};
+    uint64_t m_generation{ 0U };
 };
 
 TEST_CASE("Measures::TimeMeasure. Update", "[measure]") {
@@ -37,6 +48,7 @@ TEST_CASE("Measures::TimeMeasure. Update", "[measure]") {
 
     SECTION("Instant update does not change data") {
         measure.update();
+        REQUIRE(measure.getGeneration() == 0);
         REQUIRE(measure.getLocalTime() == defaultTimeData.localTime);
         REQUIRE(measure.getUptime() == defaultTimeData.uptime);
     }
@@ -44,6 +56,7 @@ TEST_CASE("Measures::TimeMeasure. Update", "[measure]") {
     SECTION("Slow update changes data") {
         std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
         measure.update();
+        REQUIRE(measure.getGeneration() == 1);
         REQUIRE(measure.getLocalTime() == initialLocalTime);
         REQUIRE(measure.getUptime() == initialUptime);
     }
@@ -55,6 +68,7 @@ TEST_CASE("Measures::TimeMeasure. Update", "[measure]") {
         SECTION("Update when no change since last update") {
             std::this_thread::sleep_for(testMeasureUpdateInterval * 2);
             measure.update();
+            REQUIRE(measure.getGeneration() == 1);
             REQUIRE(measure.getLocalTime() == initialLocalTime);
             REQUIRE(measure.getUptime() == initialUptime);
         }
@@ -66,6 +80,7 @@ TEST_CASE("Measures::TimeMeasure. Update", "[measure]") {
             testTimeData.uptime += 10s;
             timeDataSourceRaw->setTimeData(testTimeData);
             measure.update();
+            REQUIRE(measure.getGeneration() == 2);
             REQUIRE(measure.getLocalTime() == initialLocalTime + 1s);
             REQUIRE(measure.getUptime() == initialUptime + 10s);
         }
@@ -0,0 +1,123 @@
+export module UnitTests.Test_DamageRegion;
+
+import RG.Rendering;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+namespace {
+
+constexpr int windowWidth{ 3840 };
+constexpr int windowHeight{ 2160 };
+
+// Widget viewports of the default layout on a 4K window: a column of widgets on each side, the clock at the top
+// middle and the process lists and graphs along the bottom
+std::vector<rg::Viewport> makeWidgetLayout() {
+    constexpr int widgetW{ windowWidth / 5 };
+    constexpr int widgetH{ windowHeight / 6 };
+    return {
+        { 10, windowHeight - 10 - widgetH, widgetW, widgetH }, // CPU stats
+        { 10, windowHeight / 4, widgetW, windowHeight / 4 }, // CPU graph
+        { 10, windowHeight / 2, widgetW, windowHeight / 4 }, // RAM graph
+        { windowWidth / 2 - widgetW, windowHeight - 10 - widgetH, widgetW * 2, widgetH }, // Time
+        { windowWidth - widgetW - 10, windowHeight - 10 - widgetH, widgetW, widgetH }, // HDD
+        { windowWidth - widgetW - 10, windowHeight / 4, widgetW, windowHeight / 2 }, // Net graph
+        { 10, 10, widgetW, widgetH }, // Process CPU
+        { windowWidth / 2 - widgetW, 10, widgetW * 2, widgetH }, // Music
+        { windowWidth - widgetW - 10, 10, widgetW, widgetH }, // Process RAM
+    };
+}
+
+} // namespace
+
+TEST_CASE("Rendering::DamageRegion. Damage", "[damage_region]") {
+    rg::DamageRegion damage;
+    REQUIRE(damage.isEmpty());
+    REQUIRE_FALSE(damage.isFull());
+    REQUIRE_FALSE(damage.intersects({ 0, 0, windowWidth, windowHeight }));
+    REQUIRE(damage.getNumPixels(windowWidth, windowHeight) == 0);
+
+    SECTION("Empty rects are ignored") {
+        damage.add({ 10, 10, 0, 20 });
+        damage.add({ 10, 10, 20, 0 });
+        REQUIRE(damage.isEmpty());
+    }
+
+    SECTION("Rects are intersected by overlapping rects only") {
+        damage.add({ 100, 100, 50, 50 });
+        REQUIRE_FALSE(damage.isEmpty());
+        REQUIRE(damage.intersects({ 120, 120, 10, 10 }));
+        REQUIRE(damage.intersects({ 0, 0, 101, 101 }));
+        REQUIRE_FALSE(damage.intersects({ 0, 0, 100, 100 }));
+        REQUIRE_FALSE(damage.intersects({ 150, 100, 10, 10 }));
+    }
+
+    SECTION("Bounds contain every rect") {
+        damage.add({ 100, 100, 50, 50 });
+        damage.add({ 300, 20, 10, 10 });
+        const auto bounds{ damage.getBounds(windowWidth, windowHeight) };
+        REQUIRE(bounds.x == 100);
+        REQUIRE(bounds.y == 20);
+        REQUIRE(bounds.width == 210);
+        REQUIRE(bounds.height == 130);
+        REQUIRE(damage.getNumPixels(windowWidth, windowHeight) == 50 * 50 + 10 * 10);
+    }
+
+    SECTION("Full damage covers the window") {
+        damage.add({ 100, 100, 50, 50 });
+        damage.addAll();
+        REQUIRE(damage.isFull());
+        REQUIRE(damage.intersects({ 0, 0, 1, 1 }));
+        REQUIRE(damage.getNumPixels(windowWidth, windowHeight) == int64_t{ windowWidth } * windowHeight);
+
+        const auto bounds{ damage.getBounds(windowWidth, windowHeight) };
+        REQUIRE(bounds.width == windowWidth);
+        REQUIRE(bounds.height == windowHeight);
+    }
+
+    SECTION("Clearing starts the next frame undamaged") {
+        damage.add({ 100, 100, 50, 50 });
+        damage.addAll();
+        damage.clear();
+        REQUIRE(damage.isEmpty());
+        REQUIRE_FALSE(damage.isFull());
+    }
+}
+
+TEST_CASE("Rendering::DamageRegion. Pixels touched per frame", "[damage_region]") {
+    const auto layout{ makeWidgetLayout() };
+    const auto& timeViewport{ layout[3] };
+
+    // Counts the pixels presented in a frame where only the widgets in changed were drawn, and how many widgets
+    // had to be copied into the window
+    const auto presentFrame = [&layout](rg::DamageRegion& damage, const std::vector<rg::Viewport>& changed) {
+        for (const auto& vp : changed)
+            damage.add(vp);
+
+        const auto numPresented{ std::count_if(layout.cbegin(), layout.cend(),
+                                               [&damage](const rg::Viewport& vp) { return damage.intersects(vp); }) };
+        const auto numPixels{ damage.getNumPixels(windowWidth, windowHeight) };
+        damage.clear();
+        return std::make_pair(numPixels, numPresented);
+    };
+
+    rg::DamageRegion damage;
+
+    // The first frame after the layout is set redraws everything
+    damage.addAll();
+    const auto [fullPixels, fullPresented] = presentFrame(damage, layout);
+    REQUIRE(fullPixels == int64_t{ windowWidth } * windowHeight);
+    REQUIRE(fullPresented == static_cast<ptrdiff_t>(layout.size()));
+
+    // Once a second only the clock changes
+    const auto [clockPixels, clockPresented] = presentFrame(damage, { timeViewport });
+    REQUIRE(clockPixels == int64_t{ timeViewport.width } * timeViewport.height);
+    REQUIRE(clockPresented == 1);
+    REQUIRE(clockPixels * 10 < fullPixels);
+
+    // Frames where nothing changed don't touch the window at all
+    const auto [idlePixels, idlePresented] = presentFrame(damage, {});
+    REQUIRE(idlePixels == 0);
+    REQUIRE(idlePresented == 0);
+}
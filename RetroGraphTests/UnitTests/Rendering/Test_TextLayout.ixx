@@ -0,0 +1,92 @@
+export module UnitTests.Test_TextLayout;
+
+import RG.Rendering;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+// Every character is 10px wide except for '.', which is 4px
+rg::GlyphWidths makeGlyphWidths() {
+    rg::GlyphWidths widths;
+    widths.fill(10);
+    widths['.'] = 4;
+    return widths;
+}
+
+TEST_CASE("Rendering::TextLayout. Layout", "[text_layout]") {
+    const auto widths{ makeGlyphWidths() };
+    REQUIRE(rg::calculateStringWidth(widths, "abc.") == 34);
+
+    SECTION("Text that fits is not truncated") {
+        const auto layout{ rg::layoutText(widths, "abcde", 50) };
+        REQUIRE(layout.visibleLength == 5);
+        REQUIRE_FALSE(layout.ellipsis);
+        REQUIRE(layout.widthPx == 50);
+    }
+
+    SECTION("Text that doesn't fit ends with an ellipsis") {
+        // 'd' doesn't fit, so "bc" are replaced with ".."
+        const auto layout{ rg::layoutText(widths, "abcdefgh", 35) };
+        REQUIRE(layout.visibleLength == 1);
+        REQUIRE(layout.ellipsis);
+        REQUIRE(layout.widthPx == 18);
+    }
+
+    SECTION("Short text is truncated without an ellipsis") {
+        const auto layout{ rg::layoutText(widths, "abcdefgh", 25) };
+        REQUIRE(layout.visibleLength == 2);
+        REQUIRE_FALSE(layout.ellipsis);
+        REQUIRE(layout.widthPx == 20);
+    }
+}
+
+TEST_CASE("Rendering::TextLayoutCache. Caching", "[text_layout]") {
+    auto widths{ makeGlyphWidths() };
+    rg::TextLayoutCache cache{ 8 };
+
+    REQUIRE(cache.get(0, widths, "abcdefgh", 35).widthPx == 18);
+    REQUIRE(cache.misses() == 1);
+
+    // Each of the font, text and max width are part of the key
+    REQUIRE(cache.get(0, widths, "abcdefgh", 35).widthPx == 18);
+    REQUIRE(cache.get(1, widths, "abcdefgh", 35).widthPx == 18);
+    REQUIRE(cache.get(0, widths, "abcdefgh", 100).widthPx == 80);
+    REQUIRE(cache.get(0, widths, "abc", 35).widthPx == 30);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 4);
+
+    SECTION("Clearing lays text out again with new widths") {
+        widths.fill(1);
+        REQUIRE(cache.get(0, widths, "abc", 35).widthPx == 30);
+
+        cache.clear();
+        REQUIRE(cache.size() == 0);
+        REQUIRE(cache.get(0, widths, "abc", 35).widthPx == 3);
+    }
+}
+
+TEST_CASE("Rendering::TextLayoutCache. Benchmarks", "[text_layout][!benchmark]") {
+    const auto widths{ makeGlyphWidths() };
+    constexpr int maxWidthPx{ 300 };
+
+    // The lines of the process widget, which are redrawn unchanged most frames
+    std::vector<std::string> lines;
+    for (int i{ 0 }; i < 20; ++i)
+        lines.push_back("SomeProcessName" + std::to_string(i) + ".exe    " + std::to_string(i * 3 % 100) + "%");
+
+    BENCHMARK("Process list layout, uncached") {
+        int totalWidthPx{ 0 };
+        for (const auto& line : lines)
+            totalWidthPx += rg::layoutText(widths, line, maxWidthPx).widthPx;
+        return totalWidthPx;
+    };
+
+    rg::TextLayoutCache cache{ 512 };
+    BENCHMARK("Process list layout, cached") {
+        int totalWidthPx{ 0 };
+        for (const auto& line : lines)
+            totalWidthPx += cache.get(0, widths, line, maxWidthPx).widthPx;
+        return totalWidthPx;
+    };
+}
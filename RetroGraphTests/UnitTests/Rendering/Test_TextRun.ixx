@@ -0,0 +1,100 @@
+export module UnitTests.Test_TextRun;
+
+import RG.Rendering;
+
+import std.core;
+
+import "AllocationCounter.h";
+import "Catch2HeaderUnit.h";
+
+rg::TextPlacement makePlacement() {
+    return { 0, { 0, 0, 200, 20 }, 1, 10, 5, {}, 0 };
+}
+
+// Lays out a glyph per character and counts how many times it's called
+struct CountingLayout {
+    void operator()(std::string_view text, std::vector<rg::GlyphInstance>& glyphs) {
+        ++numCalls;
+        glyphs.resize(text.size());
+    }
+
+    int numCalls{ 0 };
+};
+
+TEST_CASE("Rendering::TextRun. Relayout", "[text_run]") {
+    rg::TextRun run{ "abc" };
+    CountingLayout layout;
+    auto placement{ makePlacement() };
+
+    REQUIRE(run.getGlyphs(placement, std::ref(layout)).size() == 3);
+    REQUIRE(run.getGlyphs(placement, std::ref(layout)).size() == 3);
+    REQUIRE(layout.numCalls == 1);
+
+    SECTION("Setting the same text keeps the glyphs") {
+        run.setText("abc");
+        run.format("{}", "abc");
+        run.getGlyphs(placement, std::ref(layout));
+        REQUIRE(layout.numCalls == 1);
+    }
+
+    SECTION("Changing the text lays the glyphs out again") {
+        run.format("{:.1f}%", 12.34f);
+        REQUIRE(run.getText() == "12.3%");
+        REQUIRE(run.getGlyphs(placement, std::ref(layout)).size() == 5);
+        REQUIRE(layout.numCalls == 2);
+    }
+
+    SECTION("Changing the placement lays the glyphs out again") {
+        placement.area.width = 100;
+        run.getGlyphs(placement, std::ref(layout));
+        REQUIRE(layout.numCalls == 2);
+
+        placement.color.a = 0.5f;
+        run.getGlyphs(placement, std::ref(layout));
+        REQUIRE(layout.numCalls == 3);
+
+        ++placement.fontGeneration;
+        run.getGlyphs(placement, std::ref(layout));
+        REQUIRE(layout.numCalls == 4);
+    }
+}
+
+TEST_CASE("Rendering::TextRun. Steady State Allocations", "[text_run]") {
+    constexpr size_t numRows{ 20 };
+    const auto placement{ makePlacement() };
+    CountingLayout layout;
+
+    // The rows of a process list, set from the measure and drawn into the frame's glyphs like FontManager does
+    std::vector<rg::TextRun> names(numRows);
+    std::vector<rg::TextRun> percentages(numRows);
+    std::vector<rg::GlyphInstance> frameGlyphs;
+    frameGlyphs.reserve(4096);
+
+    const auto updateAndDraw = [&]() {
+        for (size_t i{ 0 }; i < numRows; ++i) {
+            names[i].format("SomeProcessName{}.exe", i);
+            percentages[i].format("{:4.1f}%", i * 1.5);
+        }
+
+        frameGlyphs.clear();
+        for (const auto& run : names) {
+            const auto glyphs{ run.getGlyphs(placement, std::ref(layout)) };
+            frameGlyphs.insert(frameGlyphs.end(), glyphs.begin(), glyphs.end());
+        }
+        for (const auto& run : percentages) {
+            const auto glyphs{ run.getGlyphs(placement, std::ref(layout)) };
+            frameGlyphs.insert(frameGlyphs.end(), glyphs.begin(), glyphs.end());
+        }
+    };
+
+    updateAndDraw();
+    REQUIRE(layout.numCalls == 2 * numRows);
+
+    const auto allocationsBefore{ getNumAllocations() };
+    for (int frame{ 0 }; frame < 10; ++frame)
+        updateAndDraw();
+    const auto allocationsAfter{ getNumAllocations() };
+
+    REQUIRE(allocationsAfter == allocationsBefore);
+    REQUIRE(layout.numCalls == 2 * numRows);
+}
@@ -0,0 +1,77 @@
+export module UnitTests.Test_FPSCounter;
+
+import FPSCounter;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+using namespace std::chrono;
+
+TEST_CASE("FPSCounter. Rolling mean", "[fps_counter]") {
+    rg::FPSCounter counter;
+    REQUIRE(counter.getFPS() == 0.0f);
+
+    counter.recordFrameInterval(10ms);
+    counter.recordFrame(2ms);
+    REQUIRE(counter.getMeanFrameInterval() == 10ms);
+    REQUIRE(counter.getMeanFrameTime() == 2ms);
+    REQUIRE(counter.getFPS() == Approx{ 100.0f });
+
+    // Once the window is full of 20ms frames the 10ms frames no longer count
+    for (size_t i{ 0 }; i < rg::FPSCounter::numFrameTimeSamples - 1; ++i) {
+        counter.recordFrameInterval(10ms);
+        counter.recordFrame(2ms);
+    }
+    for (size_t i{ 0 }; i < rg::FPSCounter::numFrameTimeSamples; ++i) {
+        counter.recordFrameInterval(20ms);
+        counter.recordFrame(4ms);
+    }
+    REQUIRE(counter.getMeanFrameInterval() == 20ms);
+    REQUIRE(counter.getMeanFrameTime() == 4ms);
+    REQUIRE(counter.getFPS() == Approx{ 50.0f });
+}
+
+TEST_CASE("FPSCounter. Phase times", "[fps_counter]") {
+    rg::FPSCounter counter;
+
+    // Phase times added during a frame are summed, and averaged over frames
+    counter.addPhaseTime(rg::FramePhase::Update, 1ms);
+    counter.addPhaseTime(rg::FramePhase::Update, 1ms);
+    counter.addPhaseTime(rg::FramePhase::Draw, 4ms);
+    counter.recordFrame(10ms);
+
+    counter.addPhaseTime(rg::FramePhase::Draw, 2ms);
+    counter.recordFrame(10ms);
+
+    REQUIRE(counter.getMeanPhaseTime(rg::FramePhase::Update) == 1ms);
+    REQUIRE(counter.getMeanPhaseTime(rg::FramePhase::Draw) == 3ms);
+    REQUIRE(counter.getMeanPhaseTime(rg::FramePhase::Present) == 0ms);
+}
+
+TEST_CASE("FPSCounter. Frame time percentiles", "[fps_counter]") {
+    rg::FPSCounter counter;
+
+    // 33ms frames with a 100ms stutter every 50 frames. The frame work takes a tenth of that, the rest is waiting
+    int frameIndex{ 0 };
+    const auto recordFrames = [&counter, &frameIndex](int numFrames) {
+        for (int i{ 0 }; i < numFrames; ++i) {
+            const auto interval{ ++frameIndex % 50 == 0 ? 100ms : 33ms };
+            counter.recordFrameInterval(interval);
+            counter.recordFrame(microseconds{ interval } / 10);
+        }
+    };
+
+    // 4985ms, just under one window
+    recordFrames(147);
+    REQUIRE(counter.getFrameTimeHistogram().getCount() == 0);
+
+    // The window is reported once it's complete
+    recordFrames(1);
+    const auto& frameTimes{ counter.getFrameTimeHistogram() };
+    REQUIRE(frameTimes.getCount() == 148);
+    REQUIRE(frameTimes.getPercentile(0.5) >= 3300us);
+    REQUIRE(frameTimes.getPercentile(0.5) <= 3300us * 1.125);
+    REQUIRE(frameTimes.getPercentile(0.99) >= 10ms);
+    REQUIRE(frameTimes.getMax() == 10ms);
+}
@@ -1,7 +1,10 @@
 export module UnitTests.Test_GraphPointBuffer;
 
+import RG.Rendering;
 import RG.Widgets.Graph;
 
+import std.core;
+
 import "Catch2HeaderUnit.h";
 
 TEST_CASE("Widgets::Graph::GraphPointBuffer. Empty", "[graph_point_buffer]") {
@@ -25,25 +28,23 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. 1 Element", "[graph_point_buffer]")
 
         REQUIRE(pb.numPoints() == numPoints);
         REQUIRE(pb.back() == pb.front());
-        REQUIRE(pb.back()->y == Approx{ 1.0f });
+        REQUIRE(*pb.back() == Approx{ 1.0f });
     }
 
     SECTION("Pushing two points") {
-        bool didBufferReallocate{ pb.pushPoint(1.0f) };
-        REQUIRE(didBufferReallocate);
-        didBufferReallocate = pb.pushPoint(2.0f);
-        REQUIRE(didBufferReallocate);
+        pb.pushPoint(1.0f);
+        pb.pushPoint(2.0f);
 
         REQUIRE(pb.numPoints() == numPoints);
         REQUIRE(pb.back() == pb.front());
-        REQUIRE(pb.back()->y == Approx{ 2.0f });
+        REQUIRE(*pb.back() == Approx{ 2.0f });
     }
 
     SECTION("operator[]") {
         pb.pushPoint(1.0f);
         pb.pushPoint(2.0f);
 
-        REQUIRE(pb[0].y == Approx{ 2.0f });
+        REQUIRE(pb[0] == Approx{ 2.0f });
     }
 }
 
@@ -60,16 +61,14 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. 3 Elements", "[graph_point_buffer]"
     SECTION("Pushing single point") {
         pb.pushPoint(1.0f);
 
-        REQUIRE(pb.back()->y == Approx{ 1.0f });
+        REQUIRE(*pb.back() == Approx{ 1.0f });
     }
 
     SECTION("Pushing two points") {
-        bool didBufferReallocate{ pb.pushPoint(1.0f) };
-        REQUIRE(!didBufferReallocate);
-        didBufferReallocate = pb.pushPoint(2.0f);
-        REQUIRE(!didBufferReallocate);
+        pb.pushPoint(1.0f);
+        pb.pushPoint(2.0f);
 
-        REQUIRE(pb.back()->y == Approx{ 2.0f });
+        REQUIRE(*pb.back() == Approx{ 2.0f });
     }
 
     SECTION("Pushing three points") {
@@ -77,15 +76,15 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. 3 Elements", "[graph_point_buffer]"
         pb.pushPoint(2.0f);
         pb.pushPoint(3.0f);
 
-        REQUIRE(pb.back()->y == Approx{ 3.0f });
+        REQUIRE(*pb.back() == Approx{ 3.0f });
     }
 
     SECTION("operator[]") {
         pb.pushPoint(1.0f);
 
-        REQUIRE(pb[0].y == Approx{ defaultY });
-        REQUIRE(pb[1].y == Approx{ defaultY });
-        REQUIRE(pb[2].y == Approx{ 1.0f });
+        REQUIRE(pb[0] == Approx{ defaultY });
+        REQUIRE(pb[1] == Approx{ defaultY });
+        REQUIRE(pb[2] == Approx{ 1.0f });
     }
 
     SECTION("operator[]") {
@@ -93,15 +92,15 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. 3 Elements", "[graph_point_buffer]"
         pb.pushPoint(2.0f);
         pb.pushPoint(3.0f);
 
-        REQUIRE(pb[0].y == Approx{ 1.0f });
-        REQUIRE(pb[1].y == Approx{ 2.0f });
-        REQUIRE(pb[2].y == Approx{ 3.0f });
+        REQUIRE(pb[0] == Approx{ 1.0f });
+        REQUIRE(pb[1] == Approx{ 2.0f });
+        REQUIRE(pb[2] == Approx{ 3.0f });
 
         pb.pushPoint(4.0f);
 
-        REQUIRE(pb[0].y == Approx{ 2.0f });
-        REQUIRE(pb[1].y == Approx{ 3.0f });
-        REQUIRE(pb[2].y == Approx{ 4.0f });
+        REQUIRE(pb[0] == Approx{ 2.0f });
+        REQUIRE(pb[1] == Approx{ 3.0f });
+        REQUIRE(pb[2] == Approx{ 4.0f });
     }
 }
 
@@ -116,9 +115,9 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. Setting Points", "[graph_point_buff
         REQUIRE(pb.numPoints() == numPoints);
         REQUIRE(pb.head() == 2);
         REQUIRE(pb.tail() == 0);
-        REQUIRE(pb[0].y == Approx{ 0.0f });
-        REQUIRE(pb[1].y == Approx{ 0.5f });
-        REQUIRE(pb[2].y == Approx{ 1.0f });
+        REQUIRE(pb[0] == Approx{ 0.0f });
+        REQUIRE(pb[1] == Approx{ 0.5f });
+        REQUIRE(pb[2] == Approx{ 1.0f });
     }
 
     SECTION("Fewer points") {
@@ -127,8 +126,8 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. Setting Points", "[graph_point_buff
         REQUIRE(pb.numPoints() == 2);
         REQUIRE(pb.head() == 1);
         REQUIRE(pb.tail() == 0);
-        REQUIRE(pb[0].y == Approx{ 0.0f });
-        REQUIRE(pb[1].y == Approx{ 0.5f });
+        REQUIRE(pb[0] == Approx{ 0.0f });
+        REQUIRE(pb[1] == Approx{ 0.5f });
     }
 
     SECTION("More points") {
@@ -137,12 +136,12 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. Setting Points", "[graph_point_buff
         REQUIRE(pb.numPoints() == 6);
         REQUIRE(pb.head() == 5);
         REQUIRE(pb.tail() == 0);
-        REQUIRE(pb[0].y == Approx{ 0.0f });
-        REQUIRE(pb[1].y == Approx{ 0.5f });
-        REQUIRE(pb[2].y == Approx{ 1.0f });
-        REQUIRE(pb[3].y == Approx{ 1.5f });
-        REQUIRE(pb[4].y == Approx{ 2.0f });
-        REQUIRE(pb[5].y == Approx{ 2.5f });
+        REQUIRE(pb[0] == Approx{ 0.0f });
+        REQUIRE(pb[1] == Approx{ 0.5f });
+        REQUIRE(pb[2] == Approx{ 1.0f });
+        REQUIRE(pb[3] == Approx{ 1.5f });
+        REQUIRE(pb[4] == Approx{ 2.0f });
+        REQUIRE(pb[5] == Approx{ 2.5f });
     }
 
     SECTION("Down to one point") {
@@ -151,7 +150,7 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. Setting Points", "[graph_point_buff
         REQUIRE(pb.numPoints() == 1);
         REQUIRE(pb.head() == 0);
         REQUIRE(pb.tail() == 0);
-        REQUIRE(pb[0].y == Approx{ 0.0f });
+        REQUIRE(pb[0] == Approx{ 0.0f });
     }
 
     SECTION("Empty out") {
@@ -168,8 +167,140 @@ TEST_CASE("Widgets::Graph::GraphPointBuffer. Setting Points", "[graph_point_buff
         pb.pushPoint(3.0f);
         pb.setPoints(std::vector<float>{ -5.0f, -6.0f, -7.0f });
 
-        REQUIRE(pb[0].y == Approx{ -5.0f });
-        REQUIRE(pb[1].y == Approx{ -6.0f });
-        REQUIRE(pb[2].y == Approx{ -7.0f });
+        REQUIRE(pb[0] == Approx{ -5.0f });
+        REQUIRE(pb[1] == Approx{ -6.0f });
+        REQUIRE(pb[2] == Approx{ -7.0f });
+    }
+}
+
+TEST_CASE("Widgets::Graph::GraphPointBuffer. Ring Buffer", "[graph_point_buffer]") {
+    constexpr size_t numPoints{ 4 };
+
+    rg::GraphPointBuffer pb{ numPoints };
+
+    SECTION("Pushing overwrites the oldest point in place") {
+        pb.pushPoint(1.0f);
+        REQUIRE(pb.tail() == 1);
+        REQUIRE(pb.head() == 0);
+        REQUIRE(pb.data()[0] == Approx{ 1.0f });
+
+        pb.pushPoint(2.0f);
+        REQUIRE(pb.tail() == 2);
+        REQUIRE(pb.head() == 1);
+        REQUIRE(pb.data()[0] == Approx{ 1.0f });
+        REQUIRE(pb.data()[1] == Approx{ 2.0f });
+    }
+
+    SECTION("Buffer indices wrap around") {
+        pb.pushPoint(1.0f);
+        pb.pushPoint(2.0f);
+        pb.pushPoint(3.0f);
+
+        REQUIRE(pb.bufferIndex(0) == 3);
+        REQUIRE(pb.bufferIndex(1) == 0);
+        REQUIRE(pb.bufferIndex(3) == 2);
+        REQUIRE(pb[3] == Approx{ 3.0f });
+    }
+
+    SECTION("Tail returns to the start after a full cycle") {
+        for (size_t i = 0; i < numPoints; ++i)
+            pb.pushPoint(static_cast<float>(i));
+
+        REQUIRE(pb.tail() == 0);
+        REQUIRE(pb.head() == static_cast<int>(numPoints) - 1);
+        for (size_t i = 0; i < numPoints; ++i)
+            REQUIRE(pb[i] == Approx{ static_cast<float>(i) });
+    }
+}
+
+TEST_CASE("Widgets::Graph::GraphPointBuffer. Derived X Values", "[graph_point_buffer]") {
+    constexpr size_t numPoints{ 5 };
+
+    rg::GraphPointBuffer pb{ numPoints };
+    REQUIRE(pb.getHorizontalPointInterval() == Approx{ rg::viewportWidth / (numPoints - 1) });
+
+    SECTION("Points span the viewport") {
+        for (size_t i = 0; i < numPoints; ++i) {
+            REQUIRE(pb.getPointX(i) == Approx{ static_cast<float>(i) / (numPoints - 1) * rg::viewportWidth });
+        }
+        REQUIRE(pb.getPointX(0) + rg::viewportMin == Approx{ rg::viewportMin });
+        REQUIRE(pb.getPointX(numPoints - 1) + rg::viewportMin == Approx{ rg::viewportMax });
+    }
+
+    SECTION("X values follow the tail") {
+        pb.pushPoint(0.0f);
+        pb.pushPoint(0.0f);
+
+        // Mirrors the index calculation in lineGraph.vert
+        const auto shaderIndex = [&pb](int vertexID) {
+            return (vertexID - pb.tail() + pb.numPoints()) % pb.numPoints();
+        };
+        REQUIRE(pb.getPointX(shaderIndex(pb.tail())) == Approx{ 0.0f });
+        REQUIRE(pb.getPointX(shaderIndex(pb.head())) == Approx{ rg::viewportWidth });
+
+        // The mirrored first point at the end of the VBO
+        REQUIRE(shaderIndex(pb.bufferSize()) == shaderIndex(0));
+    }
+}
+
+TEST_CASE("Widgets::Graph::GraphPointBuffer. Draw Ranges", "[graph_point_buffer]") {
+    constexpr size_t numPoints{ 4 };
+
+    rg::GraphPointBuffer pb{ numPoints };
+
+    SECTION("Unwrapped points are a single range") {
+        const auto ranges{ pb.drawRanges() };
+        REQUIRE(ranges[0].first == 0);
+        REQUIRE(ranges[0].count == static_cast<int>(numPoints));
+        REQUIRE(ranges[1].count == 0);
+    }
+
+    SECTION("Wrapped points are split at the mirrored first point") {
+        pb.pushPoint(0.0f);
+        pb.pushPoint(0.0f);
+        pb.pushPoint(0.0f);
+
+        const auto ranges{ pb.drawRanges() };
+        REQUIRE(ranges[0].first == pb.tail());
+        REQUIRE(ranges[0].first + ranges[0].count == static_cast<int>(numPoints) + 1);
+        REQUIRE(ranges[1].first == 0);
+        REQUIRE(ranges[1].count == pb.head() + 1);
+
+        // Both ranges include the mirrored point, which is drawn twice to join them
+        REQUIRE(ranges[0].count + ranges[1].count == static_cast<int>(numPoints) + 1);
+    }
+}
+
+TEST_CASE("Widgets::Graph::GraphPointBuffer. Benchmarks", "[graph_point_buffer][!benchmark]") {
+    for (const size_t numPoints : { size_t{ 1000U }, size_t{ 100000U } }) {
+        rg::GraphPointBuffer pb{ numPoints };
+
+        // Each sample should cost the same regardless of history length or where the buffer is in its cycle
+        BENCHMARK("pushPoint, " + std::to_string(numPoints) + " point history") {
+            pb.pushPoint(0.5f);
+            return *pb.back();
+        };
+    }
+}
+
+TEST_CASE("Widgets::Graph::GraphPointBuffer. UNorm16 Points", "[graph_point_buffer]") {
+    SECTION("Viewport bounds are exact") {
+        REQUIRE(rg::packPointUNorm16(rg::viewportMin) == 0);
+        REQUIRE(rg::packPointUNorm16(rg::viewportMax) == std::numeric_limits<uint16_t>::max());
+        REQUIRE(rg::unpackPointUNorm16(rg::packPointUNorm16(rg::viewportMin)) == rg::viewportMin);
+        REQUIRE(rg::unpackPointUNorm16(rg::packPointUNorm16(rg::viewportMax)) == rg::viewportMax);
+    }
+
+    SECTION("Out of range values are clamped") {
+        REQUIRE(rg::packPointUNorm16(-2.0f) == 0);
+        REQUIRE(rg::packPointUNorm16(2.0f) == std::numeric_limits<uint16_t>::max());
+    }
+
+    SECTION("Round trip is within one step") {
+        constexpr float step{ rg::viewportWidth / std::numeric_limits<uint16_t>::max() };
+        for (int i = 0; i <= 1000; ++i) {
+            const float y{ rg::percentageToVP(i / 1000.0f) };
+            REQUIRE(rg::unpackPointUNorm16(rg::packPointUNorm16(y)) == Approx{ y }.margin(step));
+        }
     }
 }
@@ -0,0 +1,79 @@
+export module UnitTests.Test_HeatmapBuffer;
+
+import RG.Widgets.Graph;
+
+import std.core;
+
+import "Catch2HeaderUnit.h";
+
+TEST_CASE("Widgets::Graph::HeatmapBuffer. Packing Values", "[heatmap_buffer]") {
+    REQUIRE(rg::packHeatmapValue(0.0f) == 0);
+    REQUIRE(rg::packHeatmapValue(1.0f) == std::numeric_limits<uint8_t>::max());
+    REQUIRE(rg::packHeatmapValue(0.5f) == 128);
+
+    // Values outside of 0-1 are clamped
+    REQUIRE(rg::packHeatmapValue(-1.0f) == 0);
+    REQUIRE(rg::packHeatmapValue(2.0f) == std::numeric_limits<uint8_t>::max());
+}
+
+TEST_CASE("Widgets::Graph::HeatmapBuffer. Scrolling", "[heatmap_buffer]") {
+    constexpr size_t numColumns{ 4 };
+    constexpr size_t numRows{ 3 };
+
+    rg::HeatmapBuffer buffer{ numColumns, numRows };
+    REQUIRE(buffer.numColumns() == numColumns);
+    REQUIRE(buffer.numRows() == numRows);
+    REQUIRE(buffer.oldestColumn() == 0);
+    REQUIRE(buffer.scrollOffset() == Approx{ 0.0f });
+
+    SECTION("Setting values") {
+        buffer.setValue(1, 1.0f);
+        REQUIRE(buffer.column()[0] == 0);
+        REQUIRE(buffer.column()[1] == std::numeric_limits<uint8_t>::max());
+        REQUIRE(buffer.column()[2] == 0);
+    }
+
+    SECTION("Pushing columns wraps around the ring") {
+        REQUIRE(buffer.pushColumn() == 0);
+        REQUIRE(buffer.newestColumn() == 0);
+        REQUIRE(buffer.oldestColumn() == 1);
+        REQUIRE(buffer.scrollOffset() == Approx{ 1.0f / numColumns });
+
+        buffer.pushColumn();
+        buffer.pushColumn();
+        REQUIRE(buffer.pushColumn() == numColumns - 1);
+        REQUIRE(buffer.oldestColumn() == 0);
+
+        REQUIRE(buffer.pushColumn() == 0);
+    }
+
+    SECTION("The column keeps its values after being pushed") {
+        buffer.setValue(2, 0.5f);
+        buffer.pushColumn();
+        REQUIRE(buffer.column()[2] == rg::packHeatmapValue(0.5f));
+    }
+}
+
+TEST_CASE("Widgets::Graph::HeatmapBuffer. Benchmarks", "[heatmap_buffer][!benchmark]") {
+    constexpr size_t numSamples{ 40 };
+
+    for (const size_t numCores : { size_t{ 8U }, size_t{ 64U }, size_t{ 256U } }) {
+        std::mt19937 rng{ 1234 };
+        std::uniform_real_distribution<float> dist{ 0.0f, 1.0f };
+
+        // The CPU side work of a tick of core usage in heatmap mode, against the point buffers of the line graphs
+        rg::HeatmapBuffer heatmap{ numSamples, numCores };
+        BENCHMARK("Heatmap tick, " + std::to_string(numCores) + " cores") {
+            for (size_t i = 0; i < numCores; ++i)
+                heatmap.setValue(i, dist(rng));
+            return heatmap.pushColumn();
+        };
+
+        std::vector<rg::GraphPointBuffer> graphs(numCores, rg::GraphPointBuffer{ numSamples });
+        BENCHMARK("Line graphs tick, " + std::to_string(numCores) + " cores") {
+            for (auto& graph : graphs)
+                graph.pushPoint(dist(rng));
+            return graphs.back().head();
+        };
+    }
+}